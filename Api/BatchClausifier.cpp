@@ -0,0 +1,302 @@
+/*
+ * File BatchClausifier.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file Api/BatchClausifier.cpp
+ * Implements class BatchClausifier.
+ */
+
+#include <fstream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+
+#include "Debug/Tracer.hpp"
+
+#include "Lib/DArray.hpp"
+#include "Lib/DHMap.hpp"
+#include "Lib/Environment.hpp"
+#include "Lib/Exception.hpp"
+#include "Lib/ScopedPtr.hpp"
+#include "Lib/System.hpp"
+#include "Lib/TimeCounter.hpp"
+#include "Lib/Timer.hpp"
+#include "Lib/Sys/Multiprocessing.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Problem.hpp"
+
+#include "Inferences/InferenceEngine.hpp"
+#include "Inferences/TautologyDeletionISE.hpp"
+
+#include "Shell/Options.hpp"
+#include "Shell/Preprocess.hpp"
+#include "Shell/Statistics.hpp"
+#include "Shell/TPTPPrinter.hpp"
+#include "Shell/UIHelper.hpp"
+
+#include "BatchClausifier.hpp"
+
+namespace Api
+{
+
+using namespace Lib::Sys;
+using namespace Kernel;
+using namespace Inferences;
+using namespace Shell;
+
+struct BatchClausifier::Job
+{
+  CLASS_NAME(BatchClausifier::Job);
+  USE_ALLOCATOR(BatchClausifier::Job);
+
+  Job(unsigned index) : index(index), pid(0), finished(false), exitCode(0) {}
+
+  unsigned index;
+  pid_t pid;
+  bool finished;
+  int exitCode;
+  vstring outFile;
+};
+
+BatchClausifier::BatchClausifier(unsigned workerCount)
+: _workerCount(workerCount), _nextToOutput(0), _failed(0)
+{
+  CALL("BatchClausifier::BatchClausifier");
+
+  if(!_workerCount) {
+    _workerCount = System::getNumberOfCores();
+    if(!_workerCount) {
+      _workerCount = 1;
+    }
+  }
+}
+
+void BatchClausifier::addProblem(vstring fileName)
+{
+  CALL("BatchClausifier::addProblem");
+
+  _problems.push(fileName);
+}
+
+void BatchClausifier::addProblems(istream& fileList)
+{
+  CALL("BatchClausifier::addProblems");
+
+  BYPASSING_ALLOCATOR;
+
+  vstring line;
+  while(getline(fileList, line)) {
+    size_t end = line.find_last_not_of(" \t\r");
+    if(end==vstring::npos || line[0]=='#') {
+      continue;
+    }
+    addProblem(line.substr(0, end+1));
+  }
+}
+
+/**
+ * Create a fresh temporary file for the output of @c job in the directory
+ * given by the TMPDIR environment variable (or /tmp), return false if that
+ * fails
+ *
+ * The file is created by mkstemp in the parent before forking, so its name
+ * cannot be guessed or taken by another process.
+ */
+bool BatchClausifier::createTempFile(Job& job)
+{
+  CALL("BatchClausifier::createTempFile");
+
+  BYPASSING_ALLOCATOR;
+
+  const char* dir = getenv("TMPDIR");
+  vstring pattern = vstring(dir && *dir ? dir : "/tmp")+"/vampire_batch_XXXXXX";
+  DArray<char> name(pattern.size()+1);
+  strcpy(name.array(), pattern.c_str());
+  int fd = mkstemp(name.array());
+  if(fd==-1) {
+    return false;
+  }
+  close(fd);
+  job.outFile = name.array();
+  return true;
+}
+
+/**
+ * Clausify problem @c fileName in the current process. The caller is
+ * responsible for the signature being free of other problems' symbols.
+ */
+void BatchClausifier::clausifyProblem(vstring fileName, ostream& out)
+{
+  CALL("BatchClausifier::clausifyProblem");
+
+  env.options->setInputFile(fileName);
+
+  CompositeISE simplifier;
+  simplifier.addFront(new TrivialInequalitiesRemovalISE());
+  simplifier.addFront(new TautologyDeletionISE());
+  simplifier.addFront(new DuplicateLiteralRemovalISE());
+
+  ScopedPtr<Problem> prb(UIHelper::getInputProblem(*env.options));
+  {
+    TimeCounter tc(TC_PREPROCESSING);
+    Preprocess prepro(*env.options);
+    prepro.preprocess(*prb);
+  }
+
+  UIHelper::outputSortDeclarations(out);
+  UIHelper::outputSymbolDeclarations(out);
+
+  ClauseIterator cit = prb->clauseIterator();
+  while(cit.hasNext()) {
+    Clause* cl = simplifier.simplify(cit.next());
+    if(!cl) {
+      continue;
+    }
+    out << TPTPPrinter::toString(cl) << "\n";
+  }
+}
+
+/**
+ * Fork a child clausifying the problem of @c job into its temporary file.
+ * If the file cannot be created, the job is marked as failed without
+ * forking.
+ */
+void BatchClausifier::startJob(Job& job)
+{
+  CALL("BatchClausifier::startJob");
+
+  if(!createTempFile(job)) {
+    job.finished = true;
+    job.exitCode = 1;
+    return;
+  }
+
+  pid_t pid = Multiprocessing::instance()->fork();
+  if(pid) {
+    job.pid = pid;
+    return;
+  }
+
+  // child
+  System::registerForSIGHUPOnParentDeath();
+  env.timer->reset();
+  env.timer->start();
+  TimeCounter::reinitialize();
+  Timer::setTimeLimitEnforcement(true);
+
+  int resultValue = 1;
+  {
+    BYPASSING_ALLOCATOR;
+
+    ofstream out(job.outFile.c_str());
+    env.setPriorityOutput(&out);
+    try {
+      clausifyProblem(_problems[job.index], out);
+      resultValue = 0;
+    }
+    catch(Exception& e) {
+      out << "% Clausification failed: ";
+      e.cry(out);
+    }
+    catch(std::bad_alloc&) {
+      out << "% Clausification failed: insufficient system memory\n";
+    }
+    out.close();
+    env.setPriorityOutput(0);
+  }
+  System::terminateImmediately(resultValue);
+}
+
+/**
+ * Copy outputs of the finished prefix of the batch into @c out and remove
+ * their temporary files.
+ */
+void BatchClausifier::flushFinished(ostream& out)
+{
+  CALL("BatchClausifier::flushFinished");
+
+  BYPASSING_ALLOCATOR;
+
+  while(_nextToOutput<_jobs.size() && _jobs[_nextToOutput]->finished) {
+    Job* job = _jobs[_nextToOutput++];
+
+    out << "% Problem " << _problems[job->index] << "\n";
+    if(job->outFile!="") {
+      ifstream res(job->outFile.c_str());
+      if(res.good() && res.peek()!=EOF) {
+        out << res.rdbuf();
+      }
+      res.close();
+      remove(job->outFile.c_str());
+    }
+
+    if(job->exitCode) {
+      _failed++;
+      out << "% Clausification of " << _problems[job->index] << " failed with exit code " << job->exitCode << "\n";
+    }
+    out.flush();
+    _jobs[job->index] = 0;
+    delete job;
+  }
+}
+
+unsigned BatchClausifier::run(ostream& out)
+{
+  CALL("BatchClausifier::run");
+
+  unsigned cnt = _problems.size();
+  _nextToOutput = 0;
+  _failed = 0;
+  _jobs.reset();
+  for(unsigned i=0;i<cnt;i++) {
+    _jobs.push(new Job(i));
+  }
+
+  DHMap<pid_t,unsigned> running;
+  unsigned started = 0;
+  while(_nextToOutput<cnt) {
+    while(running.size()<_workerCount && started<cnt) {
+      Job* job = _jobs[started++];
+      startJob(*job);
+      if(job->finished) {
+        flushFinished(out);
+        continue;
+      }
+      running.insert(job->pid, job->index);
+    }
+    if(_nextToOutput==cnt) {
+      break;
+    }
+
+    int exitCode;
+    pid_t child = Multiprocessing::instance()->waitForChildTermination(exitCode);
+    unsigned index;
+    if(!running.pop(child, index)) {
+      //not one of our workers
+      continue;
+    }
+    _jobs[index]->finished = true;
+    _jobs[index]->exitCode = exitCode;
+    flushFinished(out);
+  }
+  _jobs.reset();
+  return _failed;
+}
+
+}
@@ -0,0 +1,114 @@
+/*
+ * File BatchClausifier.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file Api/BatchClausifier.hpp
+ * Defines class BatchClausifier.
+ */
+
+#ifndef __API_BatchClausifier__
+#define __API_BatchClausifier__
+
+#include <iostream>
+
+#include "Lib/VString.hpp"
+#include "Lib/Stack.hpp"
+
+namespace Api {
+
+using namespace std;
+using namespace Lib;
+
+/**
+ * Clausifies a batch of problem files over a pool of worker processes
+ *
+ * Vampire keeps the signature, term sharing and a number of other
+ * structures in global state, so problems cannot share one address space.
+ * Each problem is therefore processed in a child forked from the calling
+ * process after all the start-up work (option parsing, allocator and timer
+ * initialization) has been done. The child starts from the pristine
+ * signature of the parent, so no symbols leak from one problem to another,
+ * and the only per-problem cost is a copy-on-write fork.
+ *
+ * At most @c workerCount children run at the same time. Each child writes
+ * its clauses into a private temporary file; the parent copies the files
+ * to the output stream strictly in the order in which the problems were
+ * added, as soon as the prefix of finished problems grows.
+ *
+ * Clausification is performed according to @c env.options, with the
+ * @c input_file option replaced by the file of each problem.
+ */
+class BatchClausifier
+{
+public:
+  CLASS_NAME(BatchClausifier);
+  USE_ALLOCATOR(BatchClausifier);
+
+  /**
+   * Create a batch clausifier running at most @c workerCount problems
+   * in parallel. Zero means as many workers as there are cores.
+   */
+  explicit BatchClausifier(unsigned workerCount=0);
+
+  /** Add file @c fileName to the end of the batch */
+  void addProblem(vstring fileName);
+  /**
+   * Add all problems listed in @c fileList, one file name per line.
+   * Empty lines and lines starting with '#' are ignored.
+   */
+  void addProblems(istream& fileList);
+
+  /** Number of problems in the batch */
+  unsigned size() const { return _problems.size(); }
+
+  /**
+   * Clausify all problems in the batch, writing the results into @c out
+   * in the order in which they were added. Each result is preceded by
+   * a TPTP comment line with the name of the problem file.
+   *
+   * Return the number of problems that could not be clausified.
+   *
+   * Worker processes are forked during the run, so the caller must not
+   * hold @c env output (see Environment::beginOutput) while calling this.
+   */
+  unsigned run(ostream& out);
+
+  /**
+   * Clausify problem in file @c fileName and write the symbol declarations
+   * and the resulting clauses into @c out. Must be called in a process
+   * whose signature does not contain symbols of other problems.
+   */
+  static void clausifyProblem(vstring fileName, ostream& out);
+
+private:
+  struct Job;
+
+  void startJob(Job& job);
+  void flushFinished(ostream& out);
+  bool createTempFile(Job& job);
+
+  unsigned _workerCount;
+  Stack<vstring> _problems;
+  /** Index of the first problem whose output has not been written yet */
+  unsigned _nextToOutput;
+  Stack<Job*> _jobs;
+  unsigned _failed;
+};
+
+}
+
+#endif // __API_BatchClausifier__
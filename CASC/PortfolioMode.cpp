@@ -31,10 +31,12 @@
 #include "Lib/Timer.hpp"
 #include "Lib/Sys/Multiprocessing.hpp"
 
+#include "Shell/MetricsReporter.hpp"
 #include "Shell/Options.hpp"
 #include "Shell/Statistics.hpp"
 #include "Shell/UIHelper.hpp"
 #include "Shell/Normalisation.hpp"
+#include "Shell/SineUtils.hpp"
 #include "Shell/TheoryFinder.hpp"
 
 #include <unistd.h>
@@ -407,6 +409,13 @@ bool PortfolioMode::runSchedule(Schedule& schedule, int terminationTime)
 
   UIHelper::portfolioParent = true; // to report on overall-solving-ended in Timer.cpp
 
+  //the symbol index does not depend on the SInE parameters, so we build it
+  //once here instead of in every child that uses SInE
+  if (!SineIndex::shared() && scheduleUsesSine(schedule)) {
+    TimeCounter tc(TC_SINE_SELECTION);
+    SineIndex::setShared(new SineIndex(_prb->units()));
+  }
+
   PortfolioProcessPriorityPolicy policy;
   PortfolioSliceExecutor executor(this);
   ScheduleExecutor sched(&policy, &executor);
@@ -414,6 +423,35 @@ bool PortfolioMode::runSchedule(Schedule& schedule, int terminationTime)
   return sched.run(schedule, terminationTime);
 }
 
+/**
+ * Return true if SInE selection is on in some slice of @c schedule
+ */
+bool PortfolioMode::scheduleUsesSine(Schedule& schedule)
+{
+  CALL("PortfolioMode::scheduleUsesSine");
+
+  if (env.options->sineSelection() != Options::SineSelection::OFF) {
+    return true;
+  }
+  static const char* names[] = {"ss=", "sine_selection="};
+  Schedule::Iterator it(schedule);
+  while (it.hasNext()) {
+    vstring slice = it.next();
+    for (unsigned i = 0; i < 2; i++) {
+      vstring name = names[i];
+      size_t pos = 0;
+      while ((pos = slice.find(name, pos)) != vstring::npos) {
+        bool optionStart = pos>0 && (slice[pos-1]=='_' || slice[pos-1]==':');
+        pos += name.size();
+        if (optionStart && slice.compare(pos, 3, "off")!=0) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
 /**
  * Return the intended slice time in deciseconds and assign the slice
  * vstring with chopped time limit to @b chopped.
@@ -481,6 +519,7 @@ void PortfolioMode::runSlice(vstring sliceCode, unsigned timeLimitInDeciseconds)
   Options opt = *env.options;
   opt.readFromEncodedOptions(sliceCode);
   opt.setTimeLimitInDeciseconds(timeLimitInDeciseconds);
+  MetricsReporter::startSlice(sliceCode);
   int stl = opt.simulatedTimeLimit();
   if (stl) {
     opt.setSimulatedTimeLimit(int(stl * _slowness));
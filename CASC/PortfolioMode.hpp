@@ -87,6 +87,7 @@ private:
   void getSchedules(Property& prop, Schedule& quick, Schedule& fallback);
   void getExtraSchedules(Property& prop, Schedule& extra); 
   bool runSchedule(Schedule& schedule, int terminationTime);
+  static bool scheduleUsesSine(Schedule& schedule);
   bool waitForChildAndCheckIfProofFound();
   void runSlice(vstring slice, unsigned timeLimitInDeciseconds) NO_RETURN;
   void runSlice(Options& strategyOpt) NO_RETURN;
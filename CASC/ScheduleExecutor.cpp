@@ -7,11 +7,13 @@
 #include "Lib/System.hpp"
 #include "Lib/Sys/Multiprocessing.hpp"
 #include "Lib/Timer.hpp"
+#include "Shell/MetricsReporter.hpp"
 #include "Shell/Options.hpp"
 
 using namespace CASC;
 using namespace Lib;
 using namespace Lib::Sys;
+using namespace Shell;
 
 #define DECI(milli) (milli/100)
 
@@ -99,6 +101,7 @@ bool ScheduleExecutor::run(const Schedule &schedule, int terminationTime)
     // child died, remove it from the pool and check if succeeded
     if(exited)
     {
+      MetricsReporter::onChildExited(process, code);
       pool = Pool::remove(process, pool);
       if(!code)
       {
@@ -156,6 +159,7 @@ pid_t ScheduleExecutor::spawn(vstring code, int terminationTime)
   // parent
   if(pid)
   {
+    MetricsReporter::onChildSpawned(pid, code);
     return pid;
   }
   // child
@@ -24,6 +24,7 @@
 #define __DecisionProcedure__
 
 #include "Forwards.hpp"
+#include "Lib/Exception.hpp"
 #include "Kernel/Term.hpp"
 
 namespace DP {
@@ -69,6 +70,14 @@ public:
   virtual void getUnsatCore(LiteralStack& res, unsigned coreIndex=0) = 0;
   /** reset decision procedure object into state equivalent to its initial state */
   virtual void reset() = 0;
+
+  /**
+   * Open a new level. Literals added after the call are retracted
+   * by the matching call to @c pop().
+   */
+  virtual void push() { NOT_IMPLEMENTED; }
+  /** Retract the literals added since the last @c cnt calls to @c push() */
+  virtual void pop(unsigned cnt=1) { NOT_IMPLEMENTED; }
 };
 
 }
@@ -63,6 +63,17 @@ public:
     _unsatCores.reset();
   }
 
+  virtual void push() override {
+    CALL("ShortConflictMetaDP::push");
+    _inner->push();
+  }
+
+  virtual void pop(unsigned cnt) override {
+    CALL("ShortConflictMetaDP::pop");
+    _inner->pop(cnt);
+    _unsatCores.reset();
+  }
+
   virtual Status getStatus(bool getMultipleCores) override;
 
   void getModel(LiteralStack& model) override {
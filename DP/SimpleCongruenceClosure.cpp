@@ -98,36 +98,6 @@ void SimpleCongruenceClosure::ConstInfo::init() {
   useList.reset();
 }
 
-void SimpleCongruenceClosure::ConstInfo::resetEquivalences(SimpleCongruenceClosure& parent, unsigned selfIndex) {
-  CALL("SimpleCongruenceClosure::ConstInfo::resetEquivalences");
-
-  reprConst = 0;
-  proofPredecessor = 0;
-  predecessorPremise = CEq(0,0);
-  classList.reset();
-
-  static ArraySet seen;
-  seen.ensure(parent.getMaxConst()+1);
-  seen.reset();
-
-  Stack<unsigned>::DelIterator ulit(useList);
-  // Martin: keep only those namedPairs in useList for which selfIndex
-  // is one of the arguments, and keep each such exactly once
-  while(ulit.hasNext()) {
-    unsigned p = ulit.next();
-    ConstInfo& pInfo = parent._cInfos[p];
-    if(pInfo.namedPair.first!=selfIndex && pInfo.namedPair.second!=selfIndex) {
-      ulit.del();
-      continue;
-    }
-    if(seen.find(p)) {
-      ulit.del();
-      continue;
-    }
-    seen.insert(p);
-  }
-}
-
 #ifdef VDEBUG
 
 void SimpleCongruenceClosure::ConstInfo::assertValid(SimpleCongruenceClosure& parent, unsigned selfIndex) const
@@ -152,7 +122,7 @@ void SimpleCongruenceClosure::ConstInfo::assertValid(SimpleCongruenceClosure& pa
 
 
 SimpleCongruenceClosure::SimpleCongruenceClosure(Ordering* ord) :
-  _ord(ord)
+  _ord(ord), _trailStartConst(0)
 {
   CALL("SimpleCongruenceClosure::SimpleCongruenceClosure");
 
@@ -161,59 +131,137 @@ SimpleCongruenceClosure::SimpleCongruenceClosure(Ordering* ord) :
   _posLitConst = getFreshConst();
   _negLitConst = getFreshConst();
   _negEqualities.push(CEq(_posLitConst, _negLitConst, 0));
-
-  _hadPropagated = false;
 }
 
+/**
+ * Retract all literals, keeping the data for converting terms to constants
+ */
 void SimpleCongruenceClosure::reset()
 {
   CALL("SimpleCongruenceClosure::reset");
 
-#if 0
-  _cInfos.expand(1);
-  _sigConsts.reset();
-  _pairNames.reset();
-  _termNames.reset();
-  _litNames.reset();
+  LevelMark base;
+  base.trailSize = 0;
+  //this leaves us just with the true!=false non-equality
+  base.negEqCnt = 1;
+  base.distinctCnt = 0;
+  base.negDistinctCnt = 0;
+  base.constCnt = 0;
 
-  _negEqualities.reset();
-  _posLitConst = getFreshConst();
-  _negLitConst = getFreshConst();
-  _negEqualities.push(CEq(_posLitConst, _negLitConst, 0));
+  _levels.reset();
+  backtrack(base);
 
-#else
-  //do reset that keeps the data for converting terms to constants
+  ASS_EQ(_negEqualities.top().c1,_posLitConst);
+  ASS_EQ(_negEqualities.top().c2,_negLitConst);
+}
 
-  unsigned maxConst = getMaxConst();
-  for(unsigned i=1; i<=maxConst; i++) {
-    _cInfos[i].resetEquivalences(*this, i);
+/**
+ * Open a new level. Pending equalities are propagated first,
+ * so that they are not lost when the level is popped.
+ */
+void SimpleCongruenceClosure::push()
+{
+  CALL("SimpleCongruenceClosure::push");
+
+  propagate();
+
+  LevelMark mark;
+  mark.trailSize = _trail.size();
+  mark.negEqCnt = _negEqualities.size();
+  mark.distinctCnt = _distinctConstraints.size();
+  mark.negDistinctCnt = _negDistinctConstraints.size();
+  mark.constCnt = _cInfos.size();
+  _levels.push(mark);
+}
+
+void SimpleCongruenceClosure::pop(unsigned cnt)
+{
+  CALL("SimpleCongruenceClosure::pop");
+  ASS_LE(cnt, _levels.size());
+
+  if(!cnt) {
+    return;
   }
+  size_t newLevelCnt = _levels.size()-cnt;
+  LevelMark mark = _levels[newLevelCnt];
+  _levels.truncate(newLevelCnt);
+  backtrack(mark);
+}
 
-  PairMap::DelIterator pmit(_pairNames);
-  while(pmit.hasNext()) {
-    CPair namePair;
-    unsigned nameConst;
-    pmit.next(namePair, nameConst);
+void SimpleCongruenceClosure::record(UndoKind kind, unsigned c1, unsigned c2, unsigned size)
+{
+  CALL("SimpleCongruenceClosure::record");
 
-    if(_cInfos[nameConst].namedPair!=namePair) {
-      pmit.del();
-    }
+  if(_trail.isEmpty()) {
+    _trailStartConst = _cInfos.size();
   }
+  _trail.push(UndoEntry(kind, c1, c2, size));
+}
 
-  //this leaves us just with the true!=false non-equality
-  _negEqualities.truncate(1);
-  ASS_EQ(_negEqualities.top().c1,_posLitConst);
-  ASS_EQ(_negEqualities.top().c2,_negLitConst);
-#endif
+/**
+ * Restore the state recorded in @c mark
+ *
+ * Constants created after the mark stay, but their registration in
+ * _pairNames may have been undone, so they are registered again
+ * with respect to the restored congruence.
+ */
+void SimpleCongruenceClosure::backtrack(const LevelMark& mark)
+{
+  CALL("SimpleCongruenceClosure::backtrack");
+  ASS_LE(mark.trailSize, _trail.size());
 
-  //no unsat non-equality
-  _unsatEqs.reset();
+  unsigned firstOrphan = _cInfos.size();
+  if(_trail.size()>mark.trailSize) {
+    firstOrphan = max(mark.constCnt, _trailStartConst);
+  }
 
   _pendingEqualities.reset();
-  _distinctConstraints.reset();
-  _negDistinctConstraints.reset();
+  _unsatEqs.reset();
 
-  _hadPropagated = false;
+  while(_trail.size()>mark.trailSize) {
+    UndoEntry e = _trail.pop();
+    switch(e.kind) {
+    case UndoKind::MERGE: {
+      _cInfos[e.c2].classList.truncate(e.size);
+      ConstInfo& aInfo = _cInfos[e.c1];
+      ASS_EQ(aInfo.reprConst, e.c2);
+      aInfo.reprConst = 0;
+      Stack<unsigned>::Iterator aChildIt(aInfo.classList);
+      while(aChildIt.hasNext()) {
+        _cInfos[aChildIt.next()].reprConst = e.c1;
+      }
+      break;
+    }
+    case UndoKind::PROOF_EDGE: {
+      //the edge may have been reversed by makeProofRepresentant since it was added
+      unsigned c = e.c1;
+      if(_cInfos[c].proofPredecessor!=e.c2) {
+        c = e.c2;
+        ASS_EQ(_cInfos[c].proofPredecessor, e.c1);
+      }
+      _cInfos[c].proofPredecessor = 0;
+      _cInfos[c].predecessorPremise = CEq(0,0);
+      break;
+    }
+    case UndoKind::USE_PUSH:
+      ALWAYS(_cInfos[e.c1].useList.pop()==e.c2);
+      break;
+    case UndoKind::LOOKUP_INSERT:
+      ALWAYS(_pairNames.remove(CPair(e.c1, e.c2)));
+      break;
+    }
+  }
+
+  _negEqualities.truncate(mark.negEqCnt);
+  _distinctConstraints.truncate(mark.distinctCnt);
+  _negDistinctConstraints.truncate(mark.negDistinctCnt);
+
+  unsigned maxConst = getMaxConst();
+  for(unsigned c=firstOrphan; c<=maxConst; c++) {
+    if(_cInfos[c].namedPair!=CPair(0,0)) {
+      registerPair(c);
+    }
+  }
 }
 
 /** Introduce fresh congruence closure constant */
@@ -249,29 +297,51 @@ unsigned SimpleCongruenceClosure::getPairName(CPair p)
   CALL("SimpleCongruenceClosure::getPairName");
 
   unsigned* pRes;
-  if(!_pairNames.getValuePtr(p, pRes)) {
+  if(!_rawPairNames.getValuePtr(p, pRes)) {
     return *pRes;
   }
   unsigned res = getFreshConst();
   _cInfos[res].namedPair = p;
   *pRes = res;
 
-  _cInfos[p.first].useList.push(res);
-  if(_cInfos[p.first].reprConst!=0) {
-    // Martin: if we are here, the above insertion was not needed now,
-    // but will become necessary after reset(); see resetEquivalences
-    unsigned fRepr = _cInfos[p.first].reprConst;
-    _cInfos[fRepr].useList.push(res);
-  }
-  _cInfos[p.second].useList.push(res);
-  if(_cInfos[p.second].reprConst!=0) {
-    // Martin: if we are here, the above insertion was not needed now,
-    // but will become necessary after reset(); see resetEquivalences
-    unsigned sRepr = _cInfos[p.second].reprConst;
-    _cInfos[sRepr].useList.push(res);
+  registerPair(res);
+  return res;
+}
+
+/**
+ * Make the pair named by @c c known to the congruence: either add it
+ * to _pairNames and to the use lists of the representatives of its
+ * arguments, or, if a congruent pair is already there, add a pending
+ * equality between the two names.
+ */
+void SimpleCongruenceClosure::registerPair(unsigned c)
+{
+  CALL("SimpleCongruenceClosure::registerPair");
+
+  CPair derefPair = deref(_cInfos[c].namedPair);
+  unsigned* pName;
+  if(!_pairNames.getValuePtr(derefPair, pName)) {
+    if(*pName!=c) {
+      addPendingEquality(CEq(*pName, c));
+    }
+    return;
   }
+  *pName = c;
 
-  return res;
+  bool trailed = _trail.isNonEmpty();
+  if(trailed) {
+    record(UndoKind::LOOKUP_INSERT, derefPair.first, derefPair.second);
+  }
+  _cInfos[derefPair.first].useList.push(c);
+  if(trailed) {
+    record(UndoKind::USE_PUSH, derefPair.first, c);
+  }
+  if(derefPair.second!=derefPair.first) {
+    _cInfos[derefPair.second].useList.push(c);
+    if(trailed) {
+      record(UndoKind::USE_PUSH, derefPair.second, c);
+    }
+  }
 }
 
 struct SimpleCongruenceClosure::FOConversionWorker
@@ -444,7 +514,6 @@ SimpleCongruenceClosure::CEq SimpleCongruenceClosure::convertFOEquality(Literal*
 void SimpleCongruenceClosure::addLiterals(LiteralIterator lits, bool onlyEqualites)
 {
   CALL("SimpleCongruenceClosure::addLiterals");
-  ASS(!_hadPropagated);
 
   while(lits.hasNext()) {
     Literal* l = lits.next();
@@ -532,8 +601,6 @@ void SimpleCongruenceClosure::propagate()
 {
   CALL("SimpleCongruenceClosure::propagate");
 
-  _hadPropagated = true;
-
   while(_pendingEqualities.isNonEmpty()) {
     CEq curr0 = _pendingEqualities.pop_back();
     CPair curr = deref(curr0);
@@ -555,6 +622,7 @@ void SimpleCongruenceClosure::propagate()
       ASS_EQ(aProofInfo.proofPredecessor,0);
       aProofInfo.proofPredecessor = bProofRep;
       aProofInfo.predecessorPremise = curr0;
+      record(UndoKind::PROOF_EDGE, aProofRep, bProofRep);
     }
 
     // Get the class representatives
@@ -572,6 +640,7 @@ void SimpleCongruenceClosure::propagate()
     // Merge first class into second (which is why we wanted the first to be smaller)
     // To do this we update the representative for all constants in
     // the class of aRep to be bRep
+    record(UndoKind::MERGE, aRep, bRep, bInfo.classList.size());
     aInfo.reprConst = bRep;
     bInfo.classList.push(aRep);
     Stack<unsigned>::Iterator aChildIt(aInfo.classList);
@@ -596,7 +665,9 @@ void SimpleCongruenceClosure::propagate()
       }
       else {
 	*pDerefPairName = usePairConst;
+	record(UndoKind::LOOKUP_INSERT, derefPair.first, derefPair.second);
 	bInfo.useList.push(usePairConst);
+	record(UndoKind::USE_PUSH, bRep, usePairConst);
       }
     }
   }
@@ -680,6 +751,9 @@ DecisionProcedure::Status SimpleCongruenceClosure::getStatus(bool retrieveMultip
 {
   CALL("SimpleCongruenceClosure::getStatus");
 
+  // Literals may have been added since the last call
+  _unsatEqs.reset();
+
   // Propagate any pending equalities
   propagate();
 
@@ -53,6 +53,13 @@ using namespace Kernel;
  * 
  * However, classList of a representative 
  * does not (physically) contain that representative (only logically)
+ *
+ * The procedure is incremental and backtrackable: literals can be added
+ * after a call to getStatus, and push() and pop() delimit levels whose
+ * literals are retracted together. Every change of the union-find
+ * structure, of the use lists and of _pairNames is recorded on a trail
+ * and undone in reverse order on pop(). The constants that represent
+ * terms are never removed, so the term caches survive backtracking.
  */
 class SimpleCongruenceClosure : public DecisionProcedure
 {
@@ -72,6 +79,11 @@ public:
   
   virtual void reset() override;
 
+  virtual void push() override;
+  virtual void pop(unsigned cnt=1) override;
+  /** Number of levels opened by push() and not yet closed by pop() */
+  unsigned level() const { return _levels.size(); }
+
   /**
    * New, more fine-grained way of insertion. The terms may contain variables which are treated as constants.
    */
@@ -133,6 +145,7 @@ private:
   unsigned getFreshConst();
   unsigned getSignatureConst(unsigned symbol, SignatureKind kind);
   unsigned getPairName(CPair p);
+  void registerPair(unsigned c);
 
 
   struct FOConversionWorker;
@@ -174,6 +187,40 @@ private:
   void makeProofRepresentant(unsigned c);
   void propagate();
 
+  /** Kinds of changes that are recorded on the trail */
+  enum class UndoKind {
+    /** class of c1 was merged into class of c2, whose classList had @c size elements */
+    MERGE,
+    /** proof forest edge between c1 and c2 was added */
+    PROOF_EDGE,
+    /** c2 was pushed on the useList of c1 */
+    USE_PUSH,
+    /** pair (c1,c2) was inserted into _pairNames */
+    LOOKUP_INSERT
+  };
+  struct UndoEntry
+  {
+    UndoEntry(UndoKind kind, unsigned c1, unsigned c2, unsigned size=0)
+     : kind(kind), c1(c1), c2(c2), size(size) {}
+
+    UndoKind kind;
+    unsigned c1;
+    unsigned c2;
+    unsigned size;
+  };
+  /** Sizes of the backtrackable structures at the time of a push() */
+  struct LevelMark
+  {
+    size_t trailSize;
+    size_t negEqCnt;
+    size_t distinctCnt;
+    size_t negDistinctCnt;
+    unsigned constCnt;
+  };
+
+  void record(UndoKind kind, unsigned c1, unsigned c2, unsigned size=0);
+  void backtrack(const LevelMark& mark);
+
   unsigned getProofDepth(unsigned c);
   void collectUnifyingPath(unsigned c1, unsigned c2, Stack<unsigned>& path);
 
@@ -181,7 +228,6 @@ private:
   struct ConstInfo
   {
     void init();
-    void resetEquivalences(SimpleCongruenceClosure& parent, unsigned selfIndex);
 
 #ifdef VDEBUG
     void assertValid(SimpleCongruenceClosure& parent, unsigned selfIndex) const;
@@ -218,8 +264,6 @@ private:
     /**
      * If reprConst==0, contains list of pair names in whose pairs this
      * constant appears as a representative of one of the arguments.
-     * Irregardless of the value of reprConst, also contains representatives
-     * of all pairs that have this very constant as one of arguments.
      */
     Stack<unsigned> useList;
         
@@ -258,6 +302,20 @@ private:
   void assertModelInfoClean() const;
 #endif  
   
+  /**
+   * Changes to be undone on backtracking, the latest on the top
+   *
+   * Changes made while the trail is empty are never undone, they
+   * belong to the state in which no equalities are asserted.
+   */
+  Stack<UndoEntry> _trail;
+  Stack<LevelMark> _levels;
+  /**
+   * Constants numbered from here on were created while the trail was
+   * non-empty, so their registration in _pairNames may be undone
+   */
+  unsigned _trailStartConst;
+
   /**
    * Information on constants used in the algorithm
    *
@@ -280,6 +338,8 @@ private:
   typedef DHMap<CPair,unsigned> PairMap;
   /** Names of constant pairs (modulo the congruence!)*/
   PairMap _pairNames;
+  /** Names of constant pairs as they were created (not modulo the congruence) */
+  PairMap _rawPairNames;
 
   /** Constants corresponding to terms */
   DHMap<TermList,unsigned> _termNames;
@@ -307,12 +367,6 @@ private:
    * http://www.cs.miami.edu/~tptp/TPTP/SyntaxBNF.html
    * "It can be used only as a fact, not under any connective." */  
   DistinctStack _negDistinctConstraints;
-
-  /**
-   * used to assert we don't add literals after propagation.
-   * this would cause problems with term caches upon reset.
-   */
-  bool _hadPropagated;
 }; // class SimpleCongruenceClosure
 
 }
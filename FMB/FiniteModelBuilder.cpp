@@ -44,6 +44,8 @@
 #include "SAT/MinisatInterfacingNewSimp.hpp"
 #include "SAT/BufferedSolver.hpp"
 
+#include "Test/RecordingSatSolver.hpp"
+
 #include "Lib/Environment.hpp"
 #include "Lib/Timer.hpp"
 #include "Lib/List.hpp"
@@ -263,7 +265,7 @@ bool FiniteModelBuilder::reset(){
 
   // Create a new SAT solver
   try{
-    _solver = new MinisatInterfacingNewSimp(_opt,true);
+    _solver = Test::RecordingSatSolver::record(new MinisatInterfacingNewSimp(_opt,true), _opt, "fmb");
   }catch(Minisat::OutOfMemoryException&){
     MinisatInterfacingNewSimp::reportMinisatOutOfMemory();
   }
@@ -320,6 +320,8 @@ typedef Lib::SmartPtr<PassiveClauseContainer> PassiveClauseContainerSP;
 
 class ActiveClauseContainer;
 
+class CheckpointWriter;
+
 class Limits;
 class Splitter;
 class ConsequenceFinder;
@@ -32,8 +32,11 @@
 
 #include "SAT/TWLSolver.hpp"
 #include "SAT/MinisatInterfacing.hpp"
+#include "SAT/CDCLSolver.hpp"
 #include "SAT/BufferedSolver.hpp"
 
+#include "Test/RecordingSatSolver.hpp"
+
 #include "Saturation/SaturationAlgorithm.hpp"
 
 namespace Indexing
@@ -43,6 +46,14 @@ GroundingIndex::GroundingIndex(const Options& opt)
 {
   CALL("GroundingIndex::GroundingIndex");
 
+  _propagation = new PropagationOracle();
+  _oracle = Test::RecordingSatSolver::record(_propagation, opt, "gs_propagation");
+  _grounder = new GlobalSubsumptionGrounder(_oracle.ptr());
+
+  if(opt.globalSubsumptionSatSolverPower()==Options::GlobalSubsumptionSatSolverPower::PROPAGATION_ONLY) {
+    return;
+  }
+
   switch(opt.satSolver()){
     case Options::SatSolver::VAMPIRE:
     	_solver = new TWLSolver(opt,true);
@@ -54,11 +65,28 @@ GroundingIndex::GroundingIndex(const Options& opt)
     case Options::SatSolver::MINISAT:
       _solver = new MinisatInterfacing(opt,true);
     	break;
+    case Options::SatSolver::CDCL:
+      _solver = new CDCLSolver(opt,true);
+      break;
     default:
       ASSERTION_VIOLATION_REP(opt.satSolver());
   }
-  
-  _grounder = new GlobalSubsumptionGrounder(_solver.ptr());
+  _solver = Test::RecordingSatSolver::record(_solver.release(), opt, "gs");
+}
+
+/**
+ * Add a grounded clause to the oracle and to the full solver, if there is one
+ */
+void GroundingIndex::addClause(SATClause* cl)
+{
+  CALL("GroundingIndex::addClause");
+
+  _oracle->addClause(cl);
+  if(_solver) {
+    // the variables are allocated by the oracle
+    _solver->ensureVarCount(_propagation->varCnt());
+    _solver->addClause(cl);
+  }
 }
 
 void GroundingIndex::handleClause(Clause* c, bool adding)
@@ -29,6 +29,7 @@
 #include "Lib/ScopedPtr.hpp"
 
 #include "SAT/SATSolver.hpp"
+#include "SAT/PropagationOracle.hpp"
 
 #include "Index.hpp"
 
@@ -37,6 +38,13 @@ namespace Indexing {
 using namespace SAT;
 using namespace Shell;
 
+/**
+ * Holds the grounded clauses for global subsumption
+ *
+ * The clauses are always added to a PropagationOracle, which also
+ * allocates the SAT variables. Unless the SAT solver power is
+ * propagation only, they are added to a full SAT solver as well.
+ */
 class GroundingIndex : public Index {
 public:
   CLASS_NAME(GroundingIndex);
@@ -44,13 +52,19 @@ public:
 
   GroundingIndex(const Options& opt);
 
-  SATSolverWithAssumptions& getSolver() { return *_solver; }
+  void addClause(SATClause* cl);
+
+  SATSolverWithAssumptions& getOracle() { return *_oracle; }
+  SATSolverWithAssumptions& getSolver() { ASS(_solver); return *_solver; }
   GlobalSubsumptionGrounder& getGrounder() { return *_grounder; }
 
 protected:
   virtual void handleClause(Clause* c, bool adding);
 
 private:
+  /** the oracle itself, owned by _oracle which may record the calls */
+  PropagationOracle* _propagation;
+  ScopedPtr<SATSolverWithAssumptions> _oracle;
   ScopedPtr<SATSolverWithAssumptions> _solver;
   ScopedPtr<GlobalSubsumptionGrounder> _grounder;
 };
@@ -27,6 +27,8 @@
 
 #include "Saturation/SaturationAlgorithm.hpp"
 
+#include "Test/RecordingTermIndex.hpp"
+
 #include "AcyclicityIndex.hpp"
 #include "ArithmeticIndex.hpp"
 #include "CodeTreeInterfaces.hpp"
@@ -185,7 +187,7 @@ Index* IndexManager::create(IndexType t)
     break;
 
   case SUPERPOSITION_SUBTERM_SUBST_TREE:
-    tis=new TermSubstitutionTree(useConstraints);
+    tis=Test::RecordingTermIndexingStructure::record(new TermSubstitutionTree(useConstraints), _alg->getOptions(), "superposition_subterm");
 #if VDEBUG
     //tis->markTagged();
 #endif
@@ -193,7 +195,7 @@ Index* IndexManager::create(IndexType t)
     isGenerating = true;
     break;
   case SUPERPOSITION_LHS_SUBST_TREE:
-    tis=new TermSubstitutionTree(useConstraints);
+    tis=Test::RecordingTermIndexingStructure::record(new TermSubstitutionTree(useConstraints), _alg->getOptions(), "superposition_lhs");
     res=new SuperpositionLHSIndex(tis, _alg->getOrdering(), _alg->getOptions());
     isGenerating = true;
     break;
@@ -205,13 +207,13 @@ Index* IndexManager::create(IndexType t)
     break;
 
   case DEMODULATION_SUBTERM_SUBST_TREE:
-    tis=new TermSubstitutionTree();
+    tis=Test::RecordingTermIndexingStructure::record(new TermSubstitutionTree(), _alg->getOptions(), "demodulation_subterm");
     res=new DemodulationSubtermIndex(tis);
     isGenerating = false;
     break;
   case DEMODULATION_LHS_SUBST_TREE:
 //    tis=new TermSubstitutionTree();
-    tis=new CodeTreeTIS();
+    tis=Test::RecordingTermIndexingStructure::record(new CodeTreeTIS(), _alg->getOptions(), "demodulation_lhs");
     res=new DemodulationLHSIndex(tis, _alg->getOrdering(), _alg->getOptions());
     isGenerating = false;
     break;
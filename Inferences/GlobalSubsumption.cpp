@@ -160,31 +160,36 @@ Clause* GlobalSubsumption::perform(Clause* cl, Stack<Unit*>& prems)
     }
   }
   
-  SATSolverWithAssumptions& solver = _index->getSolver();
-  
   // Would be nice to have this:
   // ASS_NEQ(solver.solve(_uprOnly),SATSolver::UNSATISFIABLE);
   // But even if the last addition made the SAT solver's content unconditionally inconsistent
   // the last call to solveUnderAssumptions might have missed that
 
-  // create SAT clause and add to solver
+  // create SAT clause and add to the index
   SATClause* scl = SATClause::fromStack(plits);
   SATInference* inf = new FOConversionInference(cl);
   scl->setInference(inf);
-  solver.addClause(scl);
+  _index->addClause(scl);
+
+  // check for subsuming clause by looking for a proper subset of used assumptions,
+  // first by propagation alone and only then, if allowed, by the full solver
+  SATSolverWithAssumptions* solver = &_index->getOracle();
+  SATSolver::Status res = solver->solveUnderAssumptions(assumps, true, true /* only proper subsets */);
 
-  // check for subsuming clause by looking for a proper subset of used assumptions
-  SATSolver::Status res = solver.solveUnderAssumptions(assumps, _uprOnly, true /* only proper subsets */);
+  if (!_uprOnly && (res != SATSolver::UNSATISFIABLE || solver->failedAssumptions().size() == assumps.size())) {
+    solver = &_index->getSolver();
+    res = solver->solveUnderAssumptions(assumps, false, true /* only proper subsets */);
+  }
 
   if (res == SATSolver::UNSATISFIABLE) { 
     // it should always be UNSAT with full assumps,
     // but we may not get that far with limited solving power (_uprOnly)    
 
-    const SATLiteralStack& failed = solver.failedAssumptions();
+    const SATLiteralStack& failed = solver->failedAssumptions();
 
     if (failed.size() < assumps.size()) {
       // proper subset sufficed for UNSAT - that's the interesting case
-      const SATLiteralStack& failedFinal = _explicitMinim ? solver.explicitlyMinimizedFailedAssumptions(_uprOnly,_randomizeMinim) : failed;
+      const SATLiteralStack& failedFinal = _explicitMinim ? solver->explicitlyMinimizedFailedAssumptions(_uprOnly,_randomizeMinim) : failed;
 
       static LiteralStack survivors;
       survivors.reset();
@@ -209,7 +214,7 @@ Clause* GlobalSubsumption::perform(Clause* cl, Stack<Unit*>& prems)
       if (survivors.size() < clen) {
         RSTAT_MCTR_INC("global_subsumption_by_number_of_removed_literals",clen-survivors.size());
 
-        SATClause* ref = solver.getRefutation();
+        SATClause* ref = solver->getRefutation();
 
         prems.reset();
         prems.push(cl);
@@ -247,7 +252,7 @@ Clause* GlobalSubsumption::perform(Clause* cl, Stack<Unit*>& prems)
           UnitList::push(us, premList);
         }
         
-        SATClauseList* satPremises = solver.getRefutationPremiseList();
+        SATClauseList* satPremises = solver->getRefutationPremiseList();
 
         Inference* inf = satPremises ? // does our SAT solver support postponed minimization?
              new InferenceFromSatRefutation(Inference::GLOBAL_SUBSUMPTION, premList, satPremises, failedFinal) :
@@ -69,7 +69,7 @@ private:
   GroundingIndex* _index;
 
   /**
-   * Call the SAT solver using the cheap, unit-propagation-only calls.
+   * Only ask the propagation oracle of the index, never the full SAT solver.
    */
   bool _uprOnly;
 
@@ -113,8 +113,7 @@ protected:
     unsigned* pvar;
               
     if(_splits2vars.getValuePtr(lev, pvar)) {
-      SATSolver& solver = _index->getSolver();
-      *pvar = solver.newVar();
+      *pvar = _index->getOracle().newVar();
       ALWAYS(_vars2splits.insert(*pvar,lev));
     }
     
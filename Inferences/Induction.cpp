@@ -72,10 +72,11 @@ ClauseIterator Induction::generateClauses(Clause* premise)
 {
   CALL("Induction::generateClauses");
 
-  return pvi(InductionClauseIterator(premise));
+  return pvi(InductionClauseIterator(premise, *this));
 }
 
-InductionClauseIterator::InductionClauseIterator(Clause* premise)
+InductionClauseIterator::InductionClauseIterator(Clause* premise, Induction& induction)
+: _induction(induction)
 {
   CALL("InductionClauseIterator::InductionClauseIterator");
 
@@ -156,7 +157,7 @@ void InductionClauseIterator::process(Clause* premise, Literal* lit)
                           env.options->mathInduction() == Options::MathInductionKind::ALL;
         static bool two = env.options->mathInduction() == Options::MathInductionKind::TWO ||
                           env.options->mathInduction() == Options::MathInductionKind::ALL;
-        if(notDone(lit,t)){
+        if(_induction.notDone(lit,t)){
           if(one){
             performMathInductionOne(premise,lit,t);
           }
@@ -176,7 +177,7 @@ void InductionClauseIterator::process(Clause* premise, Literal* lit)
         static bool three = env.options->structInduction() == Options::StructuralInductionKind::THREE ||
                           env.options->structInduction() == Options::StructuralInductionKind::ALL;
 
-        if(notDone(lit,t)){
+        if(_induction.notDone(lit,t)){
 
           if(one){
             performStructInductionOne(premise,lit,t);
@@ -647,31 +648,105 @@ void InductionClauseIterator::performStructInductionThree(Clause* premise, Liter
   env.statistics->induction++; 
 }
 
-bool InductionClauseIterator::notDone(Literal* lit, Term* term)
+TermList Induction::blank(unsigned srt)
 {
-  CALL("InductionClauseIterator::notDone");
+  CALL("Induction::blank");
 
-  static DHSet<Literal*> done;
-  static DHMap<unsigned,TermList> blanks; 
-  unsigned srt = env.signature->getFunction(term->functor())->fnType()->result();
-
-  if(!blanks.find(srt)){
+  TermList* pblank;
+  if(_blanks.getValuePtr(srt,pblank)){
     unsigned fresh = env.signature->addFreshFunction(0,"blank");
     env.signature->getFunction(fresh)->setType(OperatorType::getConstantsType(srt));
-    TermList blank = TermList(Term::createConstant(fresh));
-    blanks.insert(srt,blank);
+    *pblank = TermList(Term::createConstant(fresh));
+  }
+  return *pblank;
+}
+
+/**
+ * Return true if induction on @c term in @c lit should be performed and record
+ * that it was. Goals that differ only in the induction term are considered equal,
+ * as they give the same induction schema.
+ */
+bool Induction::notDone(Literal* lit, Term* term)
+{
+  CALL("Induction::notDone");
+
+  if(seenRecently(make_pair(lit,term))){
+    // the blanked literal of this pair is in _done already
+    return false;
   }
 
-  TermReplacement cr(term,blanks.get(srt));
+  unsigned srt = env.signature->getFunction(term->functor())->fnType()->result();
+  TermReplacement cr(term,blank(srt));
   Literal* rep = cr.transform(lit);
 
-  if(done.contains(rep)){ 
-    return false; 
+  return _done.insert(rep);
+}
+
+const unsigned Induction::NO_ENTRY;
+const unsigned Induction::SEEN_CAPACITY;
+
+/**
+ * Return true if @c c is among the candidates remembered in _seen and make
+ * it the most recently used one. Otherwise remember it, evicting the least
+ * recently used candidate if _seen is full, and return false.
+ */
+bool Induction::seenRecently(Candidate c)
+{
+  CALL("Induction::seenRecently");
+
+  unsigned idx;
+  if(_seenIndex.find(c,idx)){
+    if(idx!=_seenFirst){
+      unlinkSeen(idx);
+      linkSeenFirst(idx);
+    }
+    return true;
   }
 
-  done.insert(rep);
+  if(_seen.size()<SEEN_CAPACITY){
+    idx = _seen.size();
+    _seen.push(SeenEntry());
+  }
+  else{
+    idx = _seenLast;
+    unlinkSeen(idx);
+    ALWAYS(_seenIndex.remove(_seen[idx].candidate));
+  }
+  _seen[idx].candidate = c;
+  _seenIndex.insert(c,idx);
+  linkSeenFirst(idx);
+  return false;
+}
 
-  return true;
+void Induction::unlinkSeen(unsigned idx)
+{
+  SeenEntry& e = _seen[idx];
+  if(e.prev==NO_ENTRY){
+    _seenFirst = e.next;
+  }
+  else{
+    _seen[e.prev].next = e.next;
+  }
+  if(e.next==NO_ENTRY){
+    _seenLast = e.prev;
+  }
+  else{
+    _seen[e.next].prev = e.prev;
+  }
+}
+
+void Induction::linkSeenFirst(unsigned idx)
+{
+  SeenEntry& e = _seen[idx];
+  e.prev = NO_ENTRY;
+  e.next = _seenFirst;
+  if(_seenFirst==NO_ENTRY){
+    _seenLast = idx;
+  }
+  else{
+    _seen[_seenFirst].prev = idx;
+  }
+  _seenFirst = idx;
 }
 
 }
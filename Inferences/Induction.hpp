@@ -26,6 +26,10 @@
 
 #include "Forwards.hpp"
 
+#include "Lib/DHMap.hpp"
+#include "Lib/DHSet.hpp"
+#include "Lib/Stack.hpp"
+
 #include "Kernel/TermTransformer.hpp"
 
 #include "InferenceEngine.hpp"
@@ -53,16 +57,54 @@ public:
   CLASS_NAME(Induction);
   USE_ALLOCATOR(Induction);
 
-  Induction() {}
+  Induction() : _seenFirst(NO_ENTRY), _seenLast(NO_ENTRY) {}
   ClauseIterator generateClauses(Clause* premise);
 
+  bool notDone(Literal* lit, Term* t);
+
+private:
+  typedef std::pair<Literal*,Term*> Candidate;
+
+  struct SeenEntry
+  {
+    Candidate candidate;
+    /** the entry used more recently, or NO_ENTRY */
+    unsigned prev;
+    /** the entry used less recently, or NO_ENTRY */
+    unsigned next;
+  };
+
+  static const unsigned NO_ENTRY = 0xFFFFFFFF;
+  /** Maximal number of candidates remembered in _seen */
+  static const unsigned SEEN_CAPACITY = 16384;
+
+  TermList blank(unsigned srt);
+
+  bool seenRecently(Candidate c);
+  void unlinkSeen(unsigned idx);
+  void linkSeenFirst(unsigned idx);
+
+  /** goals on which induction was performed, with the induction term replaced by a blank */
+  DHSet<Literal*> _done;
+  /**
+   * The SEEN_CAPACITY candidates most recently passed to notDone, linked
+   * from the most to the least recently used one. The blanked literal of
+   * a remembered candidate is not built again, an evicted candidate just
+   * has it built and looked up in _done.
+   */
+  Stack<SeenEntry> _seen;
+  DHMap<Candidate,unsigned> _seenIndex;
+  unsigned _seenFirst;
+  unsigned _seenLast;
+  /** blank constant for each sort */
+  DHMap<unsigned,TermList> _blanks;
 };
 
 class InductionClauseIterator
 {
 public:
   // all the work happens in the constructor!
-  InductionClauseIterator(Clause* premise);
+  InductionClauseIterator(Clause* premise, Induction& induction);
 
   CLASS_NAME(InductionClauseIterator);
   USE_ALLOCATOR(InductionClauseIterator);
@@ -85,9 +127,8 @@ private:
   void performStructInductionTwo(Clause* premise, Literal* lit, Term* t);
   void performStructInductionThree(Clause* premise, Literal* lit, Term* t);
 
-  bool notDone(Literal* lit, Term* t);
-
   Stack<Clause*> _clauses;
+  Induction& _induction;
 };
 
 };
@@ -394,6 +394,23 @@ bool Superposition::earlyWeightLimitCheck(Clause* eqClause, Literal* eqLit,
   return true;
 }
 
+/**
+ * Return true if @c eqLHS is greater than the other side of @c eqLit.
+ * Since the ordering is stable under substitution, the instances of
+ * @c eqLHS are then greater as well and need not be compared.
+ */
+bool Superposition::isOrientedFromLHS(Ordering& ordering, Literal* eqLit, TermList eqLHS)
+{
+  CALL("Superposition::isOrientedFromLHS");
+
+  Ordering::Result argOrder = ordering.getEqualityArgumentOrder(eqLit);
+  if(*eqLit->nthArgument(0)==eqLHS) {
+    return argOrder==Ordering::GREATER;
+  }
+  ASS_EQ(*eqLit->nthArgument(1),eqLHS);
+  return argOrder==Ordering::LESS;
+}
+
 size_t Superposition::getSubtermOccurrenceCount(Term* trm, TermList subterm)
 {
   CALL("Superposition::getSubtermOccurrenceCount");
@@ -481,24 +498,33 @@ Clause* Superposition::performSuperposition(
 
   Ordering& ordering = _salg->getOrdering();
 
+  // The ordering checks are done before the rewritten literal is
+  // instantiated, so that the instances of rejected candidates are not
+  // inserted into the term sharing structure.
   TermList eqLHSS = subst->apply(eqLHS, eqIsResult);
   TermList tgtTermS = subst->apply(tgtTerm, eqIsResult);
-
-  Literal* rwLitS = subst->apply(rwLit, !eqIsResult);
-  TermList rwTermS = subst->apply(rwTerm, !eqIsResult);
+  TermList rwTermS = hasConstraints ? subst->apply(rwTerm, !eqIsResult) : eqLHSS;
 
 #if VDEBUG
   if(!hasConstraints){
-    ASS_EQ(rwTermS,eqLHSS);
+    ASS_EQ(subst->apply(rwTerm, !eqIsResult),eqLHSS);
   }
 #endif
 
   //cout << "Check ordering on " << tgtTermS.toString() << " and " << rwTermS.toString() << endl;
 
   //check that we're not rewriting smaller subterm with larger
-  if(Ordering::isGorGEorE(ordering.compare(tgtTermS,rwTermS))) {
-    return 0;
+  if(hasConstraints || !isOrientedFromLHS(ordering, eqLit, eqLHS)) {
+    if(Ordering::isGorGEorE(ordering.compare(tgtTermS,rwTermS))) {
+      return 0;
+    }
   }
+  else {
+    // the ordering is stable under substitution, so eqLHSS is greater
+    ASS(!Ordering::isGorGEorE(ordering.compare(tgtTermS,rwTermS)));
+  }
+
+  Literal* rwLitS = subst->apply(rwLit, !eqIsResult);
 
   if(rwLitS->isEquality()) {
     //check that we're not rewriting only the smaller side of an equality
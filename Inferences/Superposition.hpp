@@ -63,6 +63,7 @@ private:
       ResultSubstitutionSP subst, bool eqIsResult, int weightLimit);
 
   static bool checkSuperpositionFromVariable(Clause* eqClause, Literal* eqLit, TermList eqLHS);
+  static bool isOrientedFromLHS(Ordering& ordering, Literal* eqLit, TermList eqLHS);
 
   static size_t getSubtermOccurrenceCount(Term* trm, TermList subterm);
 
@@ -46,6 +46,9 @@
 #include "SAT/SATClause.hpp"
 #include "SAT/TWLSolver.hpp"
 #include "SAT/MinisatInterfacing.hpp"
+#include "SAT/CDCLSolver.hpp"
+
+#include "Test/RecordingSatSolver.hpp"
 
 #include "Saturation/SaturationAlgorithm.hpp"
 
@@ -97,15 +100,18 @@ IGAlgorithm::IGAlgorithm(Problem& prb,const Options& opt)
   //TODO - Consider using MinimizingSolver here
   switch(opt.satSolver()){
     case Options::SatSolver::VAMPIRE:
-      _satSolver = new TWLSolver(opt,true);
+      _satSolver = Test::RecordingSatSolver::record(new TWLSolver(opt,true), opt, "instgen");
       break;
     case Options::SatSolver::MINISAT:
-      _satSolver = new MinisatInterfacing(opt,true);
+      _satSolver = Test::RecordingSatSolver::record(new MinisatInterfacing(opt,true), opt, "instgen");
+      break;
+    case Options::SatSolver::CDCL:
+      _satSolver = Test::RecordingSatSolver::record(new CDCLSolver(opt,true), opt, "instgen");
       break;
 #if VZ3
     case Options::SatSolver::Z3:
       //cout << "Warning: Z3 not compatible with inst_gen, using Minisat" << endl;
-      _satSolver = new MinisatInterfacing(opt,true);
+      _satSolver = Test::RecordingSatSolver::record(new MinisatInterfacing(opt,true), opt, "instgen");
       break;
 #endif
     default:
@@ -54,7 +54,7 @@ using namespace Lib;
  * maintain completeness.
  *
  * Objects of the QComparator class must provide a method
- * Lib::Comparison compare(Literal*, Literal*)
+ * Lib::Comparison compare(const LiteralFeatures&, const LiteralFeatures&)
  * that compares the quality of two literals.
  */
 template<class QComparator>
@@ -78,13 +78,14 @@ protected:
   {
     CALL("BestLiteralSelector::doSelection");
 
+    LiteralFeatures best, curr;
     unsigned besti=0;
-    Literal* best=(*c)[0];
+    best.init((*c)[0], *this);
     for(unsigned i=1;i<eligible;i++) {
-      Literal* lit=(*c)[i];
-      if(_comp.compare(best, lit)==LESS) {
+      curr.init((*c)[i], *this);
+      if(_comp.compare(best, curr)==LESS) {
         besti=i;
-        best=lit;
+        best=curr;
       }
     }
     if(besti>0) {
@@ -120,7 +121,7 @@ protected:
  * best negative literal is selected.
  *
  * Objects of the QComparator class must provide a method
- * Lib::Comparison compare(Literal*, Literal*)
+ * Lib::Comparison compare(const LiteralFeatures&, const LiteralFeatures&)
  * that compares the quality of two literals.
  */
 template<class QComparator>
@@ -145,8 +146,13 @@ protected:
     CALL("CompleteBestLiteralSelector::doSelection");
     ASS_G(eligible, 1); //trivial cases should be taken care of by the base LiteralSelector
 
-    static DArray<Literal*> litArr(64);
-    litArr.initFromArray(eligible,*c);
+    // the features of each literal are computed once, not in every
+    // comparison made by the sort
+    static DArray<LiteralFeatures> litArr(64);
+    litArr.ensure(eligible);
+    for(unsigned i=0;i<eligible;i++) {
+      litArr[i].init((*c)[i], *this);
+    }
     litArr.sortInversed(_comp);
 
     LiteralList* maximals=0;
@@ -154,19 +160,17 @@ protected:
     //literals will be selected.
     bool allSelected=false;
 
-    if(isNegativeForSelection(litArr[0])) {
-      singleSelected=litArr[0];
+    if(litArr[0].negative) {
+      singleSelected=litArr[0].lit;
     } else {
-      DArray<Literal*>::ReversedIterator rlit(litArr);
-      while(rlit.hasNext()) {
-        Literal* lit=rlit.next();
-        LiteralList::push(lit,maximals);
+      for(unsigned i=eligible;i>0;i--) {
+        LiteralList::push(litArr[i-1].lit,maximals);
       }
       _ord.removeNonMaximal(maximals);
       unsigned besti=0;
       LiteralList* nextMax=maximals;
       while(true) {
-        if(nextMax->head()==litArr[besti]) {
+        if(nextMax->head()==litArr[besti].lit) {
           nextMax=nextMax->tail();
           if(nextMax==0) {
             break;
@@ -174,8 +178,8 @@ protected:
         }
         besti++;
         ASS_L(besti,eligible);
-        if(isNegativeForSelection(litArr[besti])) {
-          singleSelected=litArr[besti];
+        if(litArr[besti].negative) {
+          singleSelected=litArr[besti].lit;
           break;
         }
       }
@@ -573,7 +573,7 @@ unsigned Clause::getNumeralWeight()
       }
       IntegerConstantType intVal;
       if (theory->tryInterpretConstant(t,intVal)) {
-	int w = BitUtils::log2(abs(intVal.toInner()))-1;
+	int w = static_cast<int>(intVal.toInner().bitLength())-2;
 	if (w > 0) {
 	  res += w;
 	}
@@ -592,8 +592,8 @@ unsigned Clause::getNumeralWeight()
       if (!haveRat) {
 	continue;
       }
-      int wN = BitUtils::log2(abs(ratVal.numerator().toInner()))-1;
-      int wD = BitUtils::log2(abs(ratVal.denominator().toInner()))-1;
+      int wN = static_cast<int>(ratVal.numerator().toInner().bitLength())-2;
+      int wD = static_cast<int>(ratVal.denominator().toInner().bitLength())-2;
       int v = wN + wD;
       if (v > 0) {
 	res += v;
@@ -289,6 +289,8 @@ public:
     DISTINCT_EQUALITY_REMOVAL,
     /** inference coming from outside of Vampire */
     EXTERNAL,
+    /** clause restored from a checkpoint */
+    CHECKPOINT,
     /** claim definition, definition introduced by a claim in the input */
     CLAIM_DEFINITION,
     /** BNFT flattening */
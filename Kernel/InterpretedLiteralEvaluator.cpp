@@ -425,9 +425,9 @@ class InterpretedLiteralEvaluator::IntEvaluator : public TypedEvaluator<IntegerC
 {
 protected:
 
-  virtual bool isZero(IntegerConstantType arg){ return arg.toInner()==0;}
+  virtual bool isZero(IntegerConstantType arg){ return arg.isZero();}
   virtual TermList getZero(){ return TermList(theory->representConstant(IntegerConstantType(0))); }
-  virtual bool isOne(IntegerConstantType arg){ return arg.toInner()==1;}
+  virtual bool isOne(IntegerConstantType arg){ return arg==1;}
 
   virtual bool isAddition(Interpretation interp){ return interp==Theory::INT_PLUS; }
   virtual bool isProduct(Interpretation interp){ return interp==Theory::INT_MULTIPLY;}
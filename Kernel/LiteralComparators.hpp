@@ -41,6 +41,21 @@ using namespace Lib;
 
 //typedef CompositeComaprator Composite;
 
+/**
+ * Compare two literals by a boolean feature, the literal having
+ * the feature being the greater one
+ */
+inline Comparison compareFlags(bool f1, bool f2)
+{
+  if(f1 && !f2) {
+    return GREATER;
+  } else if(!f1 && f2) {
+    return LESS;
+  } else {
+    return EQUAL;
+  }
+}
+
 class LiteralComparator
 {
 public:
@@ -66,6 +81,11 @@ public:
     Comparison res1=_c1.compare(l1,l2);
     return (res1==EQUAL)?_c2.compare(l1,l2):res1;
   }
+  Comparison compare(const LiteralFeatures& f1, const LiteralFeatures& f2)
+  {
+    Comparison res1=_c1.compare(f1,f2);
+    return (res1==EQUAL)?_c2.compare(f1,f2):res1;
+  }
 
   virtual void attachSelector(LiteralSelector* selector)
   {
@@ -88,6 +108,10 @@ public:
   {
     return _c.compare(l2,l1);
   }
+  Comparison compare(const LiteralFeatures& f1, const LiteralFeatures& f2)
+  {
+    return _c.compare(f2,f1);
+  }
 
   virtual void attachSelector(LiteralSelector* selector)
   {
@@ -112,6 +136,10 @@ struct ColoredFirst : public LiteralComparator
       return EQUAL;
     }
   }
+  Comparison compare(const LiteralFeatures& f1, const LiteralFeatures& f2)
+  {
+    return compareFlags(f1.colored, f2.colored);
+  }
 };
 
 struct NoPositiveEquality : public LiteralComparator
@@ -130,6 +158,10 @@ struct NoPositiveEquality : public LiteralComparator
       return EQUAL;
     }
   }
+  Comparison compare(const LiteralFeatures& f1, const LiteralFeatures& f2)
+  {
+    return compareFlags(f2.positiveEquality, f1.positiveEquality);
+  }
 };
 
 struct Negative : public LiteralComparator
@@ -149,6 +181,10 @@ struct Negative : public LiteralComparator
       return EQUAL;
     }
   }
+  Comparison compare(const LiteralFeatures& f1, const LiteralFeatures& f2)
+  {
+    return compareFlags(f1.negative, f2.negative);
+  }
 };
 
 struct NegativeEquality : public LiteralComparator
@@ -165,6 +201,10 @@ struct NegativeEquality : public LiteralComparator
       return EQUAL;
     }
   }
+  Comparison compare(const LiteralFeatures& f1, const LiteralFeatures& f2)
+  {
+    return compareFlags(f1.negativeEquality, f2.negativeEquality);
+  }
 };
 
 struct MaximalSize : public LiteralComparator
@@ -173,6 +213,10 @@ struct MaximalSize : public LiteralComparator
   {
     return Int::compare(l1->weight(), l2->weight());
   }
+  Comparison compare(const LiteralFeatures& f1, const LiteralFeatures& f2)
+  {
+    return Int::compare(f1.weight, f2.weight);
+  }
 };
 
 struct LeastVariables : public LiteralComparator
@@ -181,6 +225,10 @@ struct LeastVariables : public LiteralComparator
   {
     return Int::compare(l2->vars(), l1->vars());
   }
+  Comparison compare(const LiteralFeatures& f1, const LiteralFeatures& f2)
+  {
+    return Int::compare(f2.vars, f1.vars);
+  }
 };
 
 struct LeastDistinctVariables : public LiteralComparator
@@ -189,6 +237,10 @@ struct LeastDistinctVariables : public LiteralComparator
   {
     return Int::compare(l2->getDistinctVars(), l1->getDistinctVars());
   }
+  Comparison compare(const LiteralFeatures& f1, const LiteralFeatures& f2)
+  {
+    return Int::compare(f2.distinctVars(), f1.distinctVars());
+  }
 };
 
 struct LeastTopLevelVariables : public LiteralComparator
@@ -197,6 +249,10 @@ struct LeastTopLevelVariables : public LiteralComparator
   {
     return Int::compare(getTLVarCnt(l2), getTLVarCnt(l1));
   }
+  Comparison compare(const LiteralFeatures& f1, const LiteralFeatures& f2)
+  {
+    return Int::compare(f2.topLevelVars, f1.topLevelVars);
+  }
 private:
   unsigned getTLVarCnt(Literal* l)
   {
@@ -250,6 +306,10 @@ struct LexComparator : public LiteralComparator
     ASS(l1==l2);
     return EQUAL;
   }
+  Comparison compare(const LiteralFeatures& f1, const LiteralFeatures& f2)
+  {
+    return compare(f1.lit, f2.lit);
+  }
 };
 
 
@@ -72,6 +72,26 @@ bool LiteralSelector::isPositiveForSelection(Literal* l) const
   return l->isPositive() ^ _reversePolarity ^ _reversePredicate[pred];
 }
 
+void LiteralFeatures::init(Literal* l, const LiteralSelector& selector)
+{
+  CALL("LiteralFeatures::init");
+
+  lit=l;
+  weight=l->weight();
+  vars=l->vars();
+  topLevelVars=0;
+  for(TermList* arg=l->args(); arg->isNonEmpty(); arg=arg->next()) {
+    if(arg->isVar()) {
+      topLevelVars++;
+    }
+  }
+  colored=l->color()!=COLOR_TRANSPARENT;
+  negative=selector.isNegativeForSelection(l);
+  positiveEquality=l->isEquality() && l->isPositive();
+  negativeEquality=l->isEquality() && l->isNegative();
+  _distinctVars=UNKNOWN;
+}
+
 void LiteralSelector::reversePredicatePolarity(unsigned pred, bool reverse)
 {
   CALL("reversePredicatePolarity");
@@ -38,6 +38,42 @@ namespace Kernel {
 using namespace Lib;
 using namespace Shell;
 
+/**
+ * Features of a literal that the literal comparators look at.
+ *
+ * Selectors that order literals compute the record once for each
+ * eligible literal of a clause and then compare the records, rather
+ * than recomputing the features from the literal in every comparison.
+ */
+struct LiteralFeatures
+{
+  /** Fill the record for literal @b l as seen by @b selector */
+  void init(Literal* l, const LiteralSelector& selector);
+
+  /** Number of distinct variables, computed on the first request */
+  unsigned distinctVars() const
+  {
+    if(_distinctVars==UNKNOWN) {
+      _distinctVars=lit->getDistinctVars();
+    }
+    return _distinctVars;
+  }
+
+  Literal* lit;
+  unsigned weight;
+  unsigned vars;
+  /** number of variables that are arguments of the literal */
+  unsigned topLevelVars;
+  bool colored;
+  /** the literal is negative for the purpose of selection */
+  bool negative;
+  bool positiveEquality;
+  bool negativeEquality;
+private:
+  static const unsigned UNKNOWN=0xFFFFFFFF;
+  mutable unsigned _distinctVars;
+};
+
 /**
  * Class LiteralSelector is base class for
  * literal selector objects
@@ -225,12 +225,15 @@ Literal* LookaheadLiteralSelector::pickTheBest(Literal** lits, unsigned cnt)
   Literal* res=candidates.pop();
   if(candidates.isNonEmpty()) {
     LitComparator comp;
+    LiteralFeatures best, curr;
+    best.init(res, *this);
     while(candidates.isNonEmpty()) {
-      Literal* lit=candidates.pop();
-      if(comp.compare(res, lit)==LESS) {
-	res=lit;
+      curr.init(candidates.pop(), *this);
+      if(comp.compare(best, curr)==LESS) {
+	best=curr;
       }
     }
+    res=best.lit;
   }
 
   for(unsigned i=0;i<cnt;i++) {
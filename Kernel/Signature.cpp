@@ -264,7 +264,7 @@ unsigned Signature::addIntegerConstant(const vstring& number,bool defaultSort)
   vstring name = value.toString();
   vstring symbolKey = name + "_n";
   unsigned result;
-  if (_funNames.find(symbolKey,result)) {
+  if (_funKeys.find(symbolKey,result)) {
     return result;
   }
 
@@ -277,7 +277,7 @@ unsigned Signature::addIntegerConstant(const vstring& number,bool defaultSort)
   }
   */
   _funs.push(sym);
-  _funNames.insert(symbolKey,result);
+  _funKeys.insert(symbolKey,result);
   return result;
 } // Signature::addIntegerConstant
 
@@ -291,14 +291,14 @@ unsigned Signature::addIntegerConstant(const IntegerConstantType& value)
 
   vstring key = value.toString() + "_n";
   unsigned result;
-  if (_funNames.find(key, result)) {
+  if (_funKeys.find(key, result)) {
     return result;
   }
   _integers++;
   result = _funs.length();
   Symbol* sym = new IntegerSymbol(value);
   _funs.push(sym);
-  _funNames.insert(key,result);
+  _funKeys.insert(key,result);
   /*
   sym->addToDistinctGroup(INTEGER_DISTINCT_GROUP,result);
   */
@@ -323,7 +323,7 @@ unsigned Signature::addRationalConstant(const vstring& numerator, const vstring&
   vstring name = value.toString();
   vstring key = name + "_q";
   unsigned result;
-  if (_funNames.find(key,result)) {
+  if (_funKeys.find(key,result)) {
     return result;
   }
   result = _funs.length();
@@ -335,7 +335,7 @@ unsigned Signature::addRationalConstant(const vstring& numerator, const vstring&
   sym->addToDistinctGroup(RATIONAL_DISTINCT_GROUP,result);
   */
   _funs.push(sym);
-  _funNames.insert(key,result);
+  _funKeys.insert(key,result);
   return result;
 } // addRatonalConstant
 
@@ -345,13 +345,13 @@ unsigned Signature::addRationalConstant(const RationalConstantType& value)
 
   vstring key = value.toString() + "_q";
   unsigned result;
-  if (_funNames.find(key, result)) {
+  if (_funKeys.find(key, result)) {
     return result;
   }
   _rationals++;
   result = _funs.length();
   _funs.push(new RationalSymbol(value));
-  _funNames.insert(key, result);
+  _funKeys.insert(key, result);
   return result;
 } // Signature::addRationalConstant
 
@@ -371,7 +371,7 @@ unsigned Signature::addRealConstant(const vstring& number,bool defaultSort)
   }
   vstring key = value.toString() + "_r";
   unsigned result;
-  if (_funNames.find(key,result)) {
+  if (_funKeys.find(key,result)) {
     return result;
   }
   result = _funs.length();
@@ -383,7 +383,7 @@ unsigned Signature::addRealConstant(const vstring& number,bool defaultSort)
   sym->addToDistinctGroup(REAL_DISTINCT_GROUP,result);
   */
   _funs.push(sym);
-  _funNames.insert(key,result);
+  _funKeys.insert(key,result);
   return result;
 } // addRealConstant
 
@@ -393,13 +393,13 @@ unsigned Signature::addRealConstant(const RealConstantType& value)
 
   vstring key = value.toString() + "_r";
   unsigned result;
-  if (_funNames.find(key, result)) {
+  if (_funKeys.find(key, result)) {
     return result;
   }
   _reals++;
   result = _funs.length();
   _funs.push(new RealSymbol(value));
-  _funNames.insert(key, result);
+  _funKeys.insert(key, result);
   return result;
 }
 
@@ -422,12 +422,12 @@ unsigned Signature::addInterpretedFunction(Interpretation interpretation, Operat
   }
 
   vstring symbolKey = name+"_i"+Int::toString(interpretation)+(Theory::isPolymorphic(interpretation) ? type->toString() : "");
-  ASS(!_funNames.find(symbolKey));
+  ASS(!_funKeys.find(symbolKey));
 
   unsigned fnNum = _funs.length();
   InterpretedSymbol* sym = new InterpretedSymbol(name, interpretation);
   _funs.push(sym);
-  _funNames.insert(symbolKey, fnNum);
+  _funKeys.insert(symbolKey, fnNum);
   ALWAYS(_iSymbols.insert(mi, fnNum));
 
   OperatorType* fnType = type;
@@ -460,12 +460,12 @@ unsigned Signature::addInterpretedPredicate(Interpretation interpretation, Opera
 
   // cout << "symbolKey " << symbolKey << endl;
 
-  ASS(!_predNames.find(symbolKey));
+  ASS(!_predKeys.find(symbolKey));
 
   unsigned predNum = _preds.length();
   InterpretedSymbol* sym = new InterpretedSymbol(name, interpretation);
   _preds.push(sym);
-  _predNames.insert(symbolKey,predNum);
+  _predKeys.insert(symbolKey,predNum);
   ALWAYS(_iSymbols.insert(mi, predNum));
   if (predNum!=0) {
     OperatorType* predType = type;
@@ -546,7 +546,7 @@ bool Signature::functionExists(const vstring& name,unsigned arity) const
 {
   CALL("Signature::functionExists");
 
-  return _funNames.find(key(name, arity));
+  return _funNames.find(name, arity);
 }
 
 /**
@@ -556,23 +556,39 @@ bool Signature::predicateExists(const vstring& name,unsigned arity) const
 {
   CALL("Signature::predicateExists");
 
-  return _predNames.find(key(name, arity));
+  return _predNames.find(name, arity);
+}
+
+/**
+ * Insert symbol @c sym with number @c num into @c names under @c name
+ *
+ * The table keeps no copy of the name, its entry points into the name of
+ * the symbol, which is @c name possibly enclosed in quotes.
+ */
+void Signature::insertName(SymbolTable& names, Symbol* sym, const vstring& name, unsigned arity, unsigned num)
+{
+  CALL("Signature::insertName");
+
+  const vstring& symName = sym->name();
+  size_t offset = symName.size()==name.size() ? 0 : 1;
+  ASS_EQ(symName.compare(offset, name.size(), name), 0);
+  names.insert(symName.data()+offset, name.size(), arity, num);
 }
 
 unsigned Signature::getFunctionNumber(const vstring& name, unsigned arity) const
 {
   CALL("Signature::getFunctionNumber");
 
-  ASS(_funNames.find(key(name, arity)));
-  return _funNames.get(key(name, arity));
+  ASS(_funNames.find(name, arity));
+  return _funNames.get(name, arity);
 }
 
 unsigned Signature::getPredicateNumber(const vstring& name, unsigned arity) const
 {
   CALL("Signature::getPredicateNumber");
 
-  ASS(_predNames.find(key(name, arity)));
-  return _predNames.get(key(name, arity));
+  ASS(_predNames.find(name, arity));
+  return _predNames.get(name, arity);
 }
 
 /**
@@ -591,9 +607,8 @@ unsigned Signature::addFunction (const vstring& name,
 {
   CALL("Signature::addFunction");
 
-  vstring symbolKey = key(name,arity);
   unsigned result;
-  if (_funNames.find(symbolKey,result)) {
+  if (_funNames.find(name,arity,result)) {
     added = false;
     getFunction(result)->unmarkIntroduced();
     return result;
@@ -612,8 +627,9 @@ unsigned Signature::addFunction (const vstring& name,
   }
 
   result = _funs.length();
-  _funs.push(new Symbol(name, arity, false, false, false, overflowConstant));
-  _funNames.insert(symbolKey, result);
+  Symbol* sym = new Symbol(name, arity, false, false, false, overflowConstant);
+  _funs.push(sym);
+  insertName(_funNames, sym, name, arity, result);
   added = true;
   return result;
 } // Signature::addFunction
@@ -629,7 +645,7 @@ unsigned Signature::addStringConstant(const vstring& name)
 
   vstring symbolKey = name + "_c";
   unsigned result;
-  if (_funNames.find(symbolKey,result)) {
+  if (_funKeys.find(symbolKey,result)) {
     return result;
   }
 
@@ -639,7 +655,7 @@ unsigned Signature::addStringConstant(const vstring& name)
   Symbol* sym = new Symbol(quotedName,0,false,true);
   sym->addToDistinctGroup(STRING_DISTINCT_GROUP,result);
   _funs.push(sym);
-  _funNames.insert(symbolKey,result);
+  _funKeys.insert(symbolKey,result);
   return result;
 } // addStringConstant
 
@@ -662,9 +678,8 @@ unsigned Signature::addPredicate (const vstring& name,
 {
   CALL("Signature::addPredicate");
 
-  vstring symbolKey = key(name,arity);
   unsigned result;
-  if (_predNames.find(symbolKey,result)) {
+  if (_predNames.find(name,arity,result)) {
     added = false;
     getPredicate(result)->unmarkIntroduced();
     return result;
@@ -683,8 +698,9 @@ unsigned Signature::addPredicate (const vstring& name,
   }
 
   result = _preds.length();
-  _preds.push(new Symbol(name,arity));
-  _predNames.insert(symbolKey,result);
+  Symbol* sym = new Symbol(name,arity);
+  _preds.push(sym);
+  insertName(_predNames, sym, name, arity, result);
   added = true;
   return result;
 } // Signature::addPredicate
@@ -34,6 +34,7 @@
 #include "Lib/Allocator.hpp"
 #include "Lib/Stack.hpp"
 #include "Lib/Map.hpp"
+#include "Lib/SymbolTable.hpp"
 #include "Lib/DHMap.hpp"
 #include "Lib/VString.hpp"
 #include "Lib/Environment.hpp"
@@ -427,9 +428,7 @@ class Signature
   /** return true iff predicate of given @b name and @b arity exists. */
   bool isPredicateName(vstring name, unsigned arity)
   {
-    vstring symbolKey = key(name,arity);
-    unsigned tmp;
-    return _predNames.find(symbolKey,tmp);
+    return _predNames.find(name,arity);
   }
 
   /** return the number of functions */
@@ -527,19 +526,25 @@ private:
 
   static bool isProtectedName(vstring name);
   static bool charNeedsQuoting(char c, bool first);
+  static void insertName(SymbolTable& names, Symbol* sym, const vstring& name, unsigned arity, unsigned num);
   /** Stack of function symbols */
   Stack<Symbol*> _funs;
   /** Stack of predicate symbols */
   Stack<Symbol*> _preds;
+  /** Map from names and arities of function symbols to their numbers */
+  SymbolTable _funNames;
+  /** Map from names and arities of predicate symbols to their numbers */
+  SymbolTable _predNames;
   /**
-   * Map from vstring "name_arity" to their numbers
+   * Map from keys of constants and interpreted functions to their numbers
    *
    * String constants have key "value_c", integer constants "value_n",
-   * rational "numerator_denominator_q" and real "value_r".
+   * rational "numerator_denominator_q", real "value_r" and interpreted
+   * functions "name_iN" followed by the type if the function is polymorphic.
    */
-  SymbolMap _funNames;
-  /** Map from vstring "name_arity" to their numbers */
-  SymbolMap _predNames;
+  SymbolMap _funKeys;
+  /** Map from keys of interpreted predicates to their numbers */
+  SymbolMap _predKeys;
   /** Map for the arity_check options: maps symbols to their arities */
   SymbolMap _arityCheck;
   /** Last number used for fresh functions and predicates */
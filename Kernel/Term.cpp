@@ -689,43 +689,68 @@ unsigned Term::hash() const
   if (_arity == 0) {
     return hash;
   }
-  return Hash::hash(reinterpret_cast<const unsigned char*>(_args+1),
- 		       _arity*sizeof(TermList),hash);
+  return HashUtils::combine(hash, argsHash());
 } // Term::hash
 
+/**
+ * Return the hash of the argument array of a non-constant term or literal.
+ *
+ * The arguments are hashed a word at a time. The result is stored in the
+ * term, so that the hash of a shared term, which is computed when the term
+ * is inserted into the sharing structure, is not computed again.
+ */
+unsigned Term::argsHash() const
+{
+  CALL("Term::argsHash");
+  ASS_G(_arity,0);
+
+#if CACHE_ARGS_HASH
+  if (shared()) {
+    ASS_EQ(_args[0]._info.argsHash, Hash::hashWords(reinterpret_cast<const size_t*>(_args+1),_arity));
+    return _args[0]._info.argsHash;
+  }
+#endif
+  unsigned res = Hash::hashWords(reinterpret_cast<const size_t*>(_args+1),_arity);
+#if CACHE_ARGS_HASH
+  _args[0]._info.argsHash = res;
+#endif
+  return res;
+} // Term::argsHash
+
 /**
  * Return the hash function of the top-level of a literal.
  * @since 30/03/2008 Flight Murcia-Manchester
  */
 unsigned Literal::hash() const
 {
-  CALL("Literal::hash");
-
-  unsigned hash = Hash::hash(isPositive() ? (2*_functor) : (2*_functor+1));
-  if (_arity == 0) {
-    return hash;
-  }
-  if (isTwoVarEquality()) {
-    hash ^= Hash::hash(twoVarEqSort());
-  }
-  return Hash::hash(reinterpret_cast<const unsigned char*>(_args+1),
- 		       _arity*sizeof(TermList),hash);
-} // Term::hash
+  return hash(isPositive());
+} // Literal::hash
 
 /**
  * Return the hash function of the top-level of a literal with opposite polarity.
  */
 unsigned Literal::oppositeHash() const
+{
+  return hash(!isPositive());
+} // Literal::oppositeHash
+
+/**
+ * Return the hash function of the top-level of a literal with
+ * polarity @c positive.
+ */
+unsigned Literal::hash(bool positive) const
 {
   CALL("Literal::hash");
 
-  unsigned hash = Hash::hash( (!isPositive()) ? (2*_functor) : (2*_functor+1));
+  unsigned hash = Hash::hash(positive ? (2*_functor) : (2*_functor+1));
   if (_arity == 0) {
     return hash;
   }
-  return Hash::hash(reinterpret_cast<const unsigned char*>(_args+1),
- 		       _arity*sizeof(TermList),hash);
-} // Term::hash
+  if (isTwoVarEquality()) {
+    hash ^= Hash::hash(twoVarEqSort());
+  }
+  return HashUtils::combine(hash, argsHash());
+} // Literal::hash
 
 /**
  * Return literal opposite to @b l.
@@ -46,6 +46,10 @@
 // #include "MatchTag.hpp" // MS: disconnecting MatchTag, January 2017
 #define USE_MATCH_TAG 0
 
+/** If 1, shared terms keep the hash of their arguments in the unused bits
+ * of their first TermList, see Term::argsHash() */
+#define CACHE_ARGS_HASH (ARCH_X64 && !USE_MATCH_TAG)
+
 #include "Sorts.hpp"
 
 #define TERM_DIST_VAR_UNKNOWN 0x7FFFFF
@@ -197,12 +201,12 @@ private:
        * to TERM_DIST_VAR_UNKNOWN if the number has not been
        * computed yet. */
       mutable unsigned distinctVars : 23;
-      /** reserved for whatever */
 #if ARCH_X64
 # if USE_MATCH_TAG
       MatchTag matchTag; //32 bits
 # else
-      unsigned reserved : 32;
+      /** hash of the arguments, valid if the term is shared */
+      mutable unsigned argsHash : 32;
 # endif
 #else
 //      unsigned reserved : 0;
@@ -356,6 +360,7 @@ public:
   TermList* args()
   { return _args + _arity; }
   unsigned hash() const;
+  unsigned argsHash() const;
   /** return the arity */
   unsigned arity() const
   { return _arity; }
@@ -861,6 +866,7 @@ public:
   const vstring& predicateName() const;
 
 private:
+  unsigned hash(bool positive) const;
   static Literal* createVariableEquality(bool polarity, TermList arg1, TermList arg2, unsigned variableSort);
 
 }; // class Literal
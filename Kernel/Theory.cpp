@@ -51,54 +51,10 @@ IntegerConstantType::IntegerConstantType(const vstring& str)
 {
   CALL("IntegerConstantType::IntegerConstantType(vstring)");
 
-  if (!Int::stringToInt(str, _val)) {
-    //TODO: raise exception only on overflow, the proper syntax should be guarded by assertion
-    throw ArithmeticException();
-  }
-}
-
-IntegerConstantType IntegerConstantType::operator+(const IntegerConstantType& num) const
-{
-  CALL("IntegerConstantType::operator+");
-
-  InnerType res;
-  if (!Int::safePlus(_val, num._val, res)) {
-    throw ArithmeticException();
-  }
-  return IntegerConstantType(res);
-}
-
-IntegerConstantType IntegerConstantType::operator-(const IntegerConstantType& num) const
-{
-  CALL("IntegerConstantType::operator-/1");
-
-  InnerType res;
-  if (!Int::safeMinus(_val, num._val, res)) {
-    throw ArithmeticException();
-  }
-  return IntegerConstantType(res);
-}
-
-IntegerConstantType IntegerConstantType::operator-() const
-{
-  CALL("IntegerConstantType::operator-/0");
-
-  InnerType res;
-  if (!Int::safeUnaryMinus(_val, res)) {
+  if (!BigInteger::fromString(str, _val)) {
+    //TODO: the proper syntax should be guarded by assertion
     throw ArithmeticException();
   }
-  return IntegerConstantType(res);
-}
-
-IntegerConstantType IntegerConstantType::operator*(const IntegerConstantType& num) const
-{
-  CALL("IntegerConstantType::operator*");
-
-  InnerType res;
-  if (!Int::safeMultiply(_val, num._val, res)) {
-    throw ArithmeticException();
-  }
-  return IntegerConstantType(res);
 }
 
 IntegerConstantType IntegerConstantType::operator/(const IntegerConstantType& num) const
@@ -106,10 +62,7 @@ IntegerConstantType IntegerConstantType::operator/(const IntegerConstantType& nu
   CALL("IntegerConstantType::operator/");
 
   //TODO: check if division corresponds to the TPTP semantic
-  if (num._val==0) {
-    throw ArithmeticException();
-  }
-  if(_val == numeric_limits<InnerType>::min() && num._val == -1){
+  if (num._val.isZero()) {
     throw ArithmeticException();
   }
   return IntegerConstantType(_val/num._val);
@@ -120,24 +73,48 @@ IntegerConstantType IntegerConstantType::operator%(const IntegerConstantType& nu
   CALL("IntegerConstantType::operator%");
 
   //TODO: check if modulo corresponds to the TPTP semantic
-  if (num._val==0) {
+  if (num._val.isZero()) {
     throw ArithmeticException();
   }
   return IntegerConstantType(_val%num._val);
 }
 
-bool IntegerConstantType::operator==(const IntegerConstantType& num) const
+/**
+ * Euclidean division, the remainder is never negative
+ */
+IntegerConstantType IntegerConstantType::quotientE(const IntegerConstantType& num) const
 {
-  CALL("IntegerConstantType::operator==");
+  CALL("IntegerConstantType::quotientE");
 
-  return _val==num._val;
+  IntegerConstantType res = (*this)/num;
+  if (((*this)%num).isNegative()) {
+    res = num.isNegative() ? res+1 : res-1;
+  }
+  return res;
 }
 
-bool IntegerConstantType::operator>(const IntegerConstantType& num) const
+/**
+ * Division rounding towards zero
+ */
+IntegerConstantType IntegerConstantType::quotientT(const IntegerConstantType& num) const
 {
-  CALL("IntegerConstantType::operator>");
+  CALL("IntegerConstantType::quotientT");
 
-  return _val>num._val;
+  return (*this)/num;
+}
+
+/**
+ * Division rounding towards negative infinity
+ */
+IntegerConstantType IntegerConstantType::quotientF(const IntegerConstantType& num) const
+{
+  CALL("IntegerConstantType::quotientF");
+
+  IntegerConstantType res = (*this)/num;
+  if (!((*this)%num).isZero() && isNegative()!=num.isNegative()) {
+    res = res-1;
+  }
+  return res;
 }
 
 IntegerConstantType IntegerConstantType::floor(RationalConstantType rat)
@@ -183,40 +160,14 @@ IntegerConstantType IntegerConstantType::ceiling(RationalConstantType rat)
 Comparison IntegerConstantType::comparePrecedence(IntegerConstantType n1, IntegerConstantType n2)
 {
   CALL("IntegerConstantType::comparePrecedence");
-  try {
-    if (n1 == numeric_limits<InnerType>::min()) {
-      if (n2 == numeric_limits<InnerType>::min()) {
-        return EQUAL;
-      } else {
-        return GREATER;
-      }
-    } else {
-      if (n2 == numeric_limits<InnerType>::min()) {
-        return LESS;
-      } else {
-        InnerType an1 = abs(n1.toInner());
-        InnerType an2 = abs(n2.toInner());
-
-        ASS_GE(an1,0);
-        ASS_GE(an2,0);
-
-        return an1 < an2 ? LESS : (an1 == an2 ? // compare the signed ones, making negative greater than positive
-            static_cast<Comparison>(-Int::compare(n1.toInner(), n2.toInner()))
-                              : GREATER);
-      }
-    }
-  }
-  catch(ArithmeticException) {
-    ASSERTION_VIOLATION;
-    throw;
-  }
-}
-
-vstring IntegerConstantType::toString() const
-{
-  CALL("IntegerConstantType::toString");
 
-  return Int::toString(_val);
+  int absCmp = BigInteger::compare(n1._val.abs(), n2._val.abs());
+  if (absCmp!=0) {
+    return absCmp<0 ? LESS : GREATER;
+  }
+  // compare the signed ones, making negative greater than positive
+  int cmp = BigInteger::compare(n1._val, n2._val);
+  return cmp<0 ? GREATER : (cmp==0 ? EQUAL : LESS);
 }
 
 ///////////////////////
@@ -253,7 +204,7 @@ void RationalConstantType::init(InnerType num, InnerType den)
   cannonize();
 
   // Dividing by zero is bad!
-  if(_den.toInner()==0) throw ArithmeticException();
+  if(_den.isZero()) throw ArithmeticException();
 }
 
 RationalConstantType RationalConstantType::operator+(const RationalConstantType& o) const
@@ -335,10 +286,12 @@ void RationalConstantType::cannonize()
 {
   CALL("RationalConstantType::cannonize");
 
-  InnerType gcd = Int::gcd(_num.toInner(), _den.toInner());
-  if (gcd!=1) {
-    _num = _num/gcd;
-    _den = _den/gcd;
+  if (!_num.isZero() && !_den.isZero()) {
+    InnerType gcd = BigInteger::gcd(_num.toInner(), _den.toInner());
+    if (gcd!=1) {
+      _num = _num/gcd;
+      _den = _den/gcd;
+    }
   }
   if (_den<0) {
     _num = -_num;
@@ -357,42 +310,10 @@ Comparison RationalConstantType::comparePrecedence(RationalConstantType n1, Rati
 
     if (n1==n2) { return EQUAL; }
 
-    bool haveRepr1 = true;
-    bool haveRepr2 = true;
-
-    IntegerConstantType repr1, repr2;
-
-    try {
-      repr1 = n1.numerator()+n1.denominator();
-    } catch(ArithmeticException) {
-      haveRepr1 = false;
-    }
-
-    try {
-      repr2 = n2.numerator()+n2.denominator();
-    } catch(ArithmeticException) {
-      haveRepr2 = false;
-    }
+    IntegerConstantType repr1 = n1.numerator()+n1.denominator();
+    IntegerConstantType repr2 = n2.numerator()+n2.denominator();
 
-    if (haveRepr1 && haveRepr2) {
-      Comparison res = IntegerConstantType::comparePrecedence(repr1, repr2);
-      if (res==EQUAL) {
-	res = IntegerConstantType::comparePrecedence(n1.numerator(), n2.numerator());
-      }
-      ASS_NEQ(res, EQUAL);
-      return res;
-    }
-    if (haveRepr1 && !haveRepr2) {
-      return LESS;
-    }
-    if (!haveRepr1 && haveRepr2) {
-      return GREATER;
-    }
-
-    ASS(!haveRepr1);
-    ASS(!haveRepr2);
-
-    Comparison res = IntegerConstantType::comparePrecedence(n1.denominator(), n2.denominator());
+    Comparison res = IntegerConstantType::comparePrecedence(repr1, repr2);
     if (res==EQUAL) {
       res = IntegerConstantType::comparePrecedence(n1.numerator(), n2.numerator());
     }
@@ -417,6 +338,13 @@ Comparison RealConstantType::comparePrecedence(RealConstantType n1, RealConstant
   return RationalConstantType::comparePrecedence(n1, n2);
 }
 
+/** Largest absolute value of a decimal exponent parsed exactly */
+static const int MAX_DECIMAL_EXPONENT = 1000;
+
+/**
+ * Parse a decimal number, possibly with an exponent, into an exact
+ * rational number. Return false if @c num is not a decimal number.
+ */
 bool RealConstantType::parseDouble(const vstring& num, RationalConstantType& res)
 {
   CALL("RealConstantType::parseDouble");
@@ -424,6 +352,7 @@ bool RealConstantType::parseDouble(const vstring& num, RationalConstantType& res
   try {
     vstring newNum;
     IntegerConstantType denominator = 1;
+    IntegerConstantType multiplier = 1;
     bool haveDecimal = false;
     bool neg = false;
     size_t nlen = num.size();
@@ -437,6 +366,18 @@ bool RealConstantType::parseDouble(const vstring& num, RationalConstantType& res
       else if (i==0 && num[i]=='-') {
 	neg = true;
       }
+      else if ((num[i]=='e' || num[i]=='E') && !newNum.empty()) {
+	int exponent;
+	if (!Int::stringToInt(num.substr(i+1), exponent) ||
+	    exponent>MAX_DECIMAL_EXPONENT || exponent<-MAX_DECIMAL_EXPONENT) {
+	  return false;
+	}
+	IntegerConstantType& scaled = exponent>0 ? multiplier : denominator;
+	for (int j=0; j!=exponent; j+=(exponent>0 ? 1 : -1)) {
+	  scaled = scaled * 10;
+	}
+	break;
+      }
       else if (num[i]>='0' && num[i]<='9') {
 	if (newNum=="0") {
 	  newNum = num[i];
@@ -456,7 +397,7 @@ bool RealConstantType::parseDouble(const vstring& num, RationalConstantType& res
       newNum = '-'+newNum;
     }
     IntegerConstantType numerator(newNum);
-    res = RationalConstantType(numerator, denominator);
+    res = RationalConstantType(numerator*multiplier, denominator);
   } catch(ArithmeticException) {
     return false;
   }
@@ -484,7 +425,7 @@ RealConstantType::RealConstantType(const vstring& number)
     numDbl *= 10;
   }
 
-  InnerType::InnerType numerator = static_cast<InnerType::InnerType>(numDbl);
+  int numerator = static_cast<int>(numDbl);
   if (numerator!=numDbl) {
     //the numerator part of double doesn't fit inside the inner integer type
     throw ArithmeticException();
@@ -496,10 +437,10 @@ vstring RealConstantType::toNiceString() const
 {
   CALL("RealConstantType::toNiceString");
 
-  if (denominator().toInner()==1) {
+  if (denominator()==1) {
     return numerator().toString()+".0";
   }
-  float frep = (float) numerator().toInner() /(float) denominator().toInner();
+  float frep = (float) (numerator().toInner().toDouble() / denominator().toInner().toDouble());
   return Int::toString(frep);
   //return toString();
 }
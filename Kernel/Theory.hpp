@@ -28,6 +28,7 @@
 
 #include "Forwards.hpp"
 
+#include "Lib/BigInteger.hpp"
 #include "Lib/DHMap.hpp"
 #include "Lib/Exception.hpp"
 
@@ -40,7 +41,7 @@ namespace Kernel {
 
 /**
  * Exception to be thrown when the requested operation cannot be performed,
- * e.g. because of overflow of a native type.
+ * e.g. because of a division by zero.
  */
 class ArithmeticException : public ThrowableBase {};
 
@@ -49,16 +50,17 @@ class IntegerConstantType
 public:
   static unsigned getSort() { return Sorts::SRT_INTEGER; }
 
-  typedef int InnerType;
+  typedef BigInteger InnerType;
 
   IntegerConstantType() {}
-  IntegerConstantType(InnerType v) : _val(v) {}
+  IntegerConstantType(int v) : _val(v) {}
+  IntegerConstantType(const InnerType& v) : _val(v) {}
   explicit IntegerConstantType(const vstring& str);
 
-  IntegerConstantType operator+(const IntegerConstantType& num) const;
-  IntegerConstantType operator-(const IntegerConstantType& num) const;
-  IntegerConstantType operator-() const;
-  IntegerConstantType operator*(const IntegerConstantType& num) const;
+  IntegerConstantType operator+(const IntegerConstantType& num) const { return IntegerConstantType(_val+num._val); }
+  IntegerConstantType operator-(const IntegerConstantType& num) const { return IntegerConstantType(_val-num._val); }
+  IntegerConstantType operator-() const { return IntegerConstantType(-_val); }
+  IntegerConstantType operator*(const IntegerConstantType& num) const { return IntegerConstantType(_val*num._val); }
   IntegerConstantType operator/(const IntegerConstantType& num) const;
   IntegerConstantType operator%(const IntegerConstantType& num) const;
 
@@ -66,84 +68,50 @@ public:
   bool divides(const IntegerConstantType& num) const {
     CALL("IntegerConstantType:divides");
     // if this is zero it shouldn't divide anything, if num is zero dividing it doesn't make sense
-    if(_val==0 || num._val==0){ return false; }
+    if(_val.isZero() || num._val.isZero()){ return false; }
     // if this is bigger than num then the result cannot be an integer
     if(_val > num._val){ return false; }
     // now we only need to check the absolute value
-    int safeVal=_val;
-    if (_val < 0 && ! Lib::Int::safeUnaryMinus<int>(_val,safeVal)) {
-      return false;
-    }
-    return (num._val % safeVal ==0);
+    return (num._val % _val.abs()).isZero();
   }
 
-  float realDivide(const IntegerConstantType& num) const { 
-    if(num._val==0) throw ArithmeticException();
-    return ((float)_val)/num._val; 
-  }
-  int intDivide(const IntegerConstantType& num) const {
-      CALL("IntegerConstantType::intDivide");
-      ASS(num.divides(*this));
-      if(num._val==0){ throw ArithmeticException(); }
-      return _val/num._val;
-  }
-  // TODO: shouldn't we always be using intDivide for quotientE - when are they different (apart from real rounding)?
-  IntegerConstantType quotientE(const IntegerConstantType& num) const { 
-    CALL("IntegerConstantType::quotientE");
-    //cout << "quotientE " << _val << " and " << num._val << endl;
-    if(num.divides(*this)){
-      return IntegerConstantType(intDivide(num));
-    }
-    if(num._val>0) return IntegerConstantType(::floor(realDivide(num)));
-    else return IntegerConstantType(::ceil(realDivide(num)));
-  }
-  IntegerConstantType quotientT(const IntegerConstantType& num) const { 
-    if(num.divides(*this)){
-      return IntegerConstantType(intDivide(num));
-    }
-    return IntegerConstantType(::trunc(realDivide(num)));
-  }
-  IntegerConstantType quotientF(const IntegerConstantType& num) const { 
-    if(num.divides(*this)){
-      return IntegerConstantType(intDivide(num));
-    }
-    return IntegerConstantType(::floor(realDivide(num)));
-  }
+  IntegerConstantType quotientE(const IntegerConstantType& num) const;
+  IntegerConstantType quotientT(const IntegerConstantType& num) const;
+  IntegerConstantType quotientF(const IntegerConstantType& num) const;
 
-  bool operator==(const IntegerConstantType& num) const;
-  bool operator>(const IntegerConstantType& num) const;
+  bool operator==(const IntegerConstantType& num) const { return _val==num._val; }
+  bool operator>(const IntegerConstantType& num) const { return _val>num._val; }
 
   bool operator!=(const IntegerConstantType& num) const { return !((*this)==num); }
   bool operator<(const IntegerConstantType& o) const { return o>(*this); }
   bool operator>=(const IntegerConstantType& o) const { return !(o>(*this)); }
   bool operator<=(const IntegerConstantType& o) const { return !((*this)>o); }
 
-  InnerType toInner() const { return _val; }
+  const InnerType& toInner() const { return _val; }
 
-  bool isZero(){ return _val==0; }
-  bool isNegative(){ return _val<0; }
+  bool isZero() const { return _val.isZero(); }
+  bool isNegative() const { return _val.sign()<0; }
 
   static IntegerConstantType floor(RationalConstantType rat);
   static IntegerConstantType ceiling(RationalConstantType rat);
 
   static Comparison comparePrecedence(IntegerConstantType n1, IntegerConstantType n2);
 
-  vstring toString() const;
+  vstring toString() const { return _val.toString(); }
 private:
   InnerType _val;
 };
 
 inline
 std::ostream& operator<< (ostream& out, const IntegerConstantType& val) {
-  return out << val.toInner();
+  return out << val.toString();
 }
 
 /**
  * A class for representing rational numbers
  *
- * The class uses IntegerConstantType to store the numerator and denominator.
- * This ensures that if there is an overflow in the operations, an exception
- * will be raised by the IntegerConstantType methods.
+ * The class uses IntegerConstantType to store the numerator and denominator,
+ * so the operations are exact.
  */
 struct RationalConstantType {
   typedef IntegerConstantType InnerType;
@@ -182,12 +150,12 @@ struct RationalConstantType {
   bool operator>=(const RationalConstantType& o) const { return !(o>(*this)); }
   bool operator<=(const RationalConstantType& o) const { return !((*this)>o); }
 
-  bool isZero(){ return _num.toInner()==0; } 
+  bool isZero() const { return _num.isZero(); }
   // relies on the fact that cannonize ensures that _den>=0
-  bool isNegative(){ ASS(_den>=0); return _num.toInner() < 0; }
+  bool isNegative() const { ASS(_den>=0); return _num.isNegative(); }
 
   RationalConstantType quotientE(const RationalConstantType& num) const {
-    if(_num.toInner()>0 && _den.toInner()>0){
+    if(_num>0 && _den>0){
        return ((*this)/num).floor(); 
     }
     else return ((*this)/num).ceiling();
@@ -169,6 +169,13 @@ public:
   static void onPreprocessingEnd();
   static void onParsingEnd(){ _lastParsingNumber = _lastNumber;}
   static unsigned getLastParsingNumber(){ return _lastParsingNumber;}
+  /** Return the number of the most recently created unit */
+  static unsigned getLastNumber(){ return _lastNumber;}
+  /**
+   * Make the next created unit get number @c number+1, used to reproduce
+   * the numbering of units that were created in another process
+   */
+  static void setLastNumber(unsigned number){ _lastNumber = number;}
 
 protected:
   /** Number of this unit, used for printing and statistics */
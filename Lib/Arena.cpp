@@ -0,0 +1,102 @@
+/*
+ * File Arena.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file Arena.cpp
+ * Implements class Arena.
+ */
+
+#include "Arena.hpp"
+
+namespace Lib
+{
+
+Arena::~Arena()
+{
+  CALL("Arena::~Arena");
+
+  freeChunks(_chunks);
+}
+
+void Arena::freeChunks(Chunk* chunks)
+{
+  CALL("Arena::freeChunks");
+
+  while(chunks) {
+    Chunk* next = chunks->next;
+    DEALLOC_KNOWN(chunks, chunks->size, "Arena::Chunk");
+    chunks = next;
+  }
+}
+
+/**
+ * Allocate @c size bytes from a new chunk, which becomes the current one
+ * unless it was allocated only for an object larger than the chunk size
+ */
+void* Arena::allocateInNewChunk(size_t size)
+{
+  CALL("Arena::allocateInNewChunk");
+
+  size_t chunkSize = CHUNK_HEADER_SIZE+size;
+  bool large = chunkSize>_chunkSize;
+  if(!large) {
+    chunkSize = _chunkSize;
+  }
+  Chunk* chunk = static_cast<Chunk*>(ALLOC_KNOWN(chunkSize, "Arena::Chunk"));
+  chunk->size = chunkSize;
+  char* res = reinterpret_cast<char*>(chunk)+CHUNK_HEADER_SIZE;
+  _used += size;
+
+  if(large && _chunks) {
+    // keep allocating from the current chunk
+    chunk->next = _chunks->next;
+    _chunks->next = chunk;
+    return res;
+  }
+  chunk->next = _chunks;
+  _chunks = chunk;
+  _cur = res+size;
+  _end = reinterpret_cast<char*>(chunk)+chunkSize;
+  return res;
+}
+
+/**
+ * Release all objects allocated so far. The current chunk is kept
+ * for the following allocations.
+ */
+void Arena::release()
+{
+  CALL("Arena::release");
+
+  _used = 0;
+  if(!_chunks) {
+    return;
+  }
+  Chunk* first = _chunks;
+  freeChunks(first->next);
+  first->next = 0;
+  if(first->size!=_chunkSize) {
+    freeChunks(first);
+    _chunks = 0;
+    _cur = _end = 0;
+    return;
+  }
+  _cur = reinterpret_cast<char*>(first)+CHUNK_HEADER_SIZE;
+  _end = reinterpret_cast<char*>(first)+first->size;
+}
+
+}
@@ -0,0 +1,107 @@
+/*
+ * File Arena.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file Arena.hpp
+ * Defines class Arena.
+ */
+
+#ifndef __Arena__
+#define __Arena__
+
+#include <cstddef>
+
+#include "Debug/Assertion.hpp"
+#include "Debug/Tracer.hpp"
+
+#include "Allocator.hpp"
+
+namespace Lib {
+
+/**
+ * A region of memory for short-lived objects of one phase
+ *
+ * Objects are allocated by advancing a pointer in the current chunk and
+ * are never deallocated one by one, all of them are released at once by
+ * release(). The objects must not need their destructors to run and must
+ * be placed in the region by the global placement new, e.g.
+ * @code ::new(arena.allocate(sizeof(C))) C(...) @endcode
+ *
+ * The chunks are pages of the Allocator, so the memory limit applies to
+ * them and released chunks are reused by the rest of Vampire.
+ */
+class Arena
+{
+public:
+  CLASS_NAME(Arena);
+  USE_ALLOCATOR(Arena);
+
+  Arena(size_t chunkSize=DEFAULT_CHUNK_SIZE)
+  : _chunks(0), _cur(0), _end(0), _chunkSize(chunkSize), _used(0) {}
+  ~Arena();
+
+  /** Return @c size bytes aligned as a pointer */
+  void* allocate(size_t size)
+  {
+    size = (size+ALIGNMENT-1) & ~(ALIGNMENT-1);
+    if(static_cast<size_t>(_end-_cur)<size) {
+      return allocateInNewChunk(size);
+    }
+    void* res = _cur;
+    _cur += size;
+    _used += size;
+    return res;
+  }
+
+  /** Allocate an uninitialised array of @c cnt objects of type T */
+  template<typename T>
+  T* allocateArray(size_t cnt)
+  {
+    return static_cast<T*>(allocate(cnt*sizeof(T)));
+  }
+
+  void release();
+
+  /** Number of bytes allocated since the last release */
+  size_t usedMemory() const { return _used; }
+
+  /** Chunks of this size are whole pages of the Allocator */
+  static const size_t DEFAULT_CHUNK_SIZE = 4*VPAGE_SIZE-256;
+
+private:
+  static const size_t ALIGNMENT = sizeof(void*);
+
+  struct Chunk {
+    Chunk* next;
+    size_t size;
+  };
+  static const size_t CHUNK_HEADER_SIZE = (sizeof(Chunk)+ALIGNMENT-1) & ~(ALIGNMENT-1);
+
+  void* allocateInNewChunk(size_t size);
+  void freeChunks(Chunk* chunks);
+
+  /** the chunk currently allocated from is the first one */
+  Chunk* _chunks;
+  char* _cur;
+  char* _end;
+  size_t _chunkSize;
+  size_t _used;
+};
+
+}
+
+#endif // __Arena__
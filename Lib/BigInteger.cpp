@@ -0,0 +1,628 @@
+/*
+ * File BigInteger.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file BigInteger.cpp
+ * Implements class BigInteger.
+ */
+
+#include <cstring>
+
+#if GNUMP
+#include <gmp.h>
+#endif
+
+#include "Debug/Tracer.hpp"
+
+#include "Allocator.hpp"
+#include "Int.hpp"
+#include "Stack.hpp"
+
+#include "BigInteger.hpp"
+
+namespace Lib
+{
+
+/**
+ * Return true if @c str is an optional sign followed by decimal digits.
+ * Assign to @c begin the position of the first digit.
+ */
+static bool isIntegerString(const vstring& str, size_t& begin)
+{
+  begin = (str.size() && (str[0]=='-' || str[0]=='+')) ? 1 : 0;
+  if (begin==str.size()) {
+    return false;
+  }
+  for (size_t i=begin; i<str.size(); i++) {
+    if (str[i]<'0' || str[i]>'9') {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Parse @c str into @c res. Return false if @c str is not an optional sign
+ * followed by decimal digits.
+ */
+bool BigInteger::fromString(const vstring& str, BigInteger& res)
+{
+  CALL("BigInteger::fromString");
+
+  size_t begin;
+  if (!isIntegerString(str, begin)) {
+    return false;
+  }
+  bool negative = str[0]=='-';
+  // nine digits always fit into an int
+  if (str.size()-begin<=9) {
+    int val = 0;
+    for (size_t i=begin; i<str.size(); i++) {
+      val = val*10 + (str[i]-'0');
+    }
+    res = BigInteger(negative ? -val : val);
+    return true;
+  }
+
+  BigInteger val;
+  for (size_t i=begin; i<str.size(); i+=9) {
+    size_t end = std::min(i+9, str.size());
+    int chunk = 0;
+    int scale = 1;
+    for (size_t j=i; j<end; j++) {
+      chunk = chunk*10 + (str[j]-'0');
+      scale *= 10;
+    }
+    val = val*BigInteger(scale) + BigInteger(chunk);
+  }
+  res = negative ? -val : val;
+  return true;
+}
+
+BigInteger BigInteger::gcd(const BigInteger& a, const BigInteger& b)
+{
+  CALL("BigInteger::gcd");
+
+  BigInteger x = a.abs();
+  BigInteger y = b.abs();
+  while (!y.isZero()) {
+    BigInteger rem = x % y;
+    x = y;
+    y = rem;
+  }
+  return x;
+}
+
+/** Number of bits of @c val, zero for zero */
+static unsigned bitLength(unsigned long long val)
+{
+  unsigned res = 0;
+  while (val) {
+    val >>= 1;
+    res++;
+  }
+  return res;
+}
+
+#if GNUMP
+
+/**
+ * A value that does not fit into an int, stored as a GMP integer
+ */
+struct BigInteger::Big
+{
+  unsigned refCnt;
+  mpz_t value;
+
+  /** Initialize @c res to the value of @c v */
+  static void get(const BigInteger& v, mpz_t res)
+  {
+    if (v._big) {
+      mpz_init_set(res, v._big->value);
+    }
+    else {
+      mpz_init_set_si(res, v._small);
+    }
+  }
+
+  /** Return a BigInteger with value @c val and clear @c val */
+  static BigInteger make(mpz_t val)
+  {
+    if (mpz_fits_sint_p(val)) {
+      int res = static_cast<int>(mpz_get_si(val));
+      mpz_clear(val);
+      return BigInteger(res);
+    }
+    Big* big = static_cast<Big*>(ALLOC_KNOWN(sizeof(Big), "BigInteger::Big"));
+    big->refCnt = 1;
+    mpz_init(big->value);
+    mpz_swap(big->value, val);
+    mpz_clear(val);
+    return BigInteger(big);
+  }
+};
+
+void BigInteger::acquire(Big* big)
+{
+  big->refCnt++;
+}
+
+void BigInteger::release(Big* big)
+{
+  ASS_G(big->refCnt,0);
+  if (--big->refCnt==0) {
+    mpz_clear(big->value);
+    DEALLOC_KNOWN(big, sizeof(Big), "BigInteger::Big");
+  }
+}
+
+BigInteger BigInteger::fromLongLongBig(long long val)
+{
+  CALL("BigInteger::fromLongLongBig");
+
+  // a long may have only 32 bits
+  mpz_t res;
+  mpz_init_set_si(res, static_cast<long>(val>>31));
+  mpz_mul_2exp(res, res, 31);
+  mpz_add_ui(res, res, static_cast<unsigned long>(val & 0x7FFFFFFF));
+  return Big::make(res);
+}
+
+BigInteger BigInteger::add(const BigInteger& a, const BigInteger& b, bool subtract)
+{
+  CALL("BigInteger::add");
+
+  mpz_t x, y;
+  Big::get(a, x);
+  Big::get(b, y);
+  if (subtract) {
+    mpz_sub(x, x, y);
+  }
+  else {
+    mpz_add(x, x, y);
+  }
+  mpz_clear(y);
+  return Big::make(x);
+}
+
+BigInteger BigInteger::negate(const BigInteger& a)
+{
+  CALL("BigInteger::negate");
+
+  mpz_t x;
+  Big::get(a, x);
+  mpz_neg(x, x);
+  return Big::make(x);
+}
+
+BigInteger BigInteger::multiply(const BigInteger& a, const BigInteger& b)
+{
+  CALL("BigInteger::multiply");
+
+  mpz_t x, y;
+  Big::get(a, x);
+  Big::get(b, y);
+  mpz_mul(x, x, y);
+  mpz_clear(y);
+  return Big::make(x);
+}
+
+void BigInteger::divide(const BigInteger& a, const BigInteger& b, BigInteger* quot, BigInteger* rem)
+{
+  CALL("BigInteger::divide");
+
+  mpz_t x, y, q, r;
+  Big::get(a, x);
+  Big::get(b, y);
+  mpz_init(q);
+  mpz_init(r);
+  mpz_tdiv_qr(q, r, x, y);
+  mpz_clear(x);
+  mpz_clear(y);
+  if (quot) {
+    *quot = Big::make(q);
+  }
+  else {
+    mpz_clear(q);
+  }
+  if (rem) {
+    *rem = Big::make(r);
+  }
+  else {
+    mpz_clear(r);
+  }
+}
+
+int BigInteger::compareBig(const BigInteger& a, const BigInteger& b)
+{
+  CALL("BigInteger::compareBig");
+
+  mpz_t x, y;
+  Big::get(a, x);
+  Big::get(b, y);
+  int res = mpz_cmp(x, y);
+  mpz_clear(x);
+  mpz_clear(y);
+  return res;
+}
+
+int BigInteger::bigSign(const Big* big)
+{
+  return mpz_sgn(big->value);
+}
+
+vstring BigInteger::toString() const
+{
+  CALL("BigInteger::toString");
+
+  if (!_big) {
+    return Int::toString(_small);
+  }
+  vstring res(mpz_sizeinbase(_big->value, 10)+2, '\0');
+  mpz_get_str(&res[0], 10, _big->value);
+  res.resize(strlen(res.c_str()));
+  return res;
+}
+
+double BigInteger::toDouble() const
+{
+  if (!_big) {
+    return _small;
+  }
+  return mpz_get_d(_big->value);
+}
+
+unsigned BigInteger::bitLength() const
+{
+  if (!_big) {
+    return Lib::bitLength(_small<0 ? -static_cast<long long>(_small) : _small);
+  }
+  return mpz_sizeinbase(_big->value, 2);
+}
+
+#else // GNUMP
+
+/**
+ * A value that does not fit into an int, stored as its sign and the digits
+ * of its absolute value in base 2^32
+ */
+struct BigInteger::Big
+{
+  typedef Stack<unsigned> Digits;
+
+  unsigned refCnt;
+  bool negative;
+  unsigned length;
+  /** the digits, least significant first, the last one is not zero */
+  unsigned digits[1];
+
+  static size_t size(unsigned length)
+  {
+    return sizeof(Big)+(length-1)*sizeof(unsigned);
+  }
+
+  /** Assign the digits and the sign of @c v to @c mag and @c negative */
+  static void get(const BigInteger& v, Digits& mag, bool& negative)
+  {
+    mag.reset();
+    if (v._big) {
+      negative = v._big->negative;
+      for (unsigned i=0; i<v._big->length; i++) {
+        mag.push(v._big->digits[i]);
+      }
+    }
+    else {
+      negative = v._small<0;
+      long long val = v._small;
+      mag.push(static_cast<unsigned>(negative ? -val : val));
+      trim(mag);
+    }
+  }
+
+  static BigInteger make(Digits& mag, bool negative)
+  {
+    trim(mag);
+    if (mag.isEmpty()) {
+      return BigInteger(0);
+    }
+    if (mag.size()==1) {
+      if (!negative && mag[0]<=static_cast<unsigned>(INT_MAX)) {
+        return BigInteger(static_cast<int>(mag[0]));
+      }
+      if (negative && mag[0]<=static_cast<unsigned>(INT_MAX)+1u) {
+        return BigInteger(static_cast<int>(-static_cast<long long>(mag[0])));
+      }
+    }
+    unsigned length = mag.size();
+    Big* big = static_cast<Big*>(ALLOC_KNOWN(size(length), "BigInteger::Big"));
+    big->refCnt = 1;
+    big->negative = negative;
+    big->length = length;
+    memcpy(big->digits, mag.begin(), length*sizeof(unsigned));
+    return BigInteger(big);
+  }
+
+  static void trim(Digits& mag)
+  {
+    while (mag.isNonEmpty() && mag.top()==0) {
+      mag.pop();
+    }
+  }
+
+  static int compare(const Digits& a, const Digits& b)
+  {
+    if (a.size()!=b.size()) {
+      return a.size()<b.size() ? -1 : 1;
+    }
+    for (size_t i=a.size(); i>0; i--) {
+      if (a[i-1]!=b[i-1]) {
+        return a[i-1]<b[i-1] ? -1 : 1;
+      }
+    }
+    return 0;
+  }
+
+  static void add(const Digits& a, const Digits& b, Digits& res)
+  {
+    res.reset();
+    unsigned long long carry = 0;
+    for (size_t i=0; i<a.size() || i<b.size(); i++) {
+      carry += (i<a.size() ? a[i] : 0ull) + (i<b.size() ? b[i] : 0ull);
+      res.push(static_cast<unsigned>(carry));
+      carry >>= 32;
+    }
+    if (carry) {
+      res.push(static_cast<unsigned>(carry));
+    }
+  }
+
+  /** Subtract @c b from @c a, which must not be smaller */
+  static void subtract(Digits& a, const Digits& b)
+  {
+    ASS_GE(compare(a, b), 0);
+    long long borrow = 0;
+    for (size_t i=0; i<a.size(); i++) {
+      long long diff = static_cast<long long>(a[i]) - (i<b.size() ? b[i] : 0) - borrow;
+      borrow = diff<0 ? 1 : 0;
+      a[i] = static_cast<unsigned>(diff + (borrow<<32));
+    }
+    ASS_EQ(borrow, 0);
+    trim(a);
+  }
+
+  static void multiply(const Digits& a, const Digits& b, Digits& res)
+  {
+    res.reset();
+    for (size_t i=0; i<a.size()+b.size(); i++) {
+      res.push(0);
+    }
+    for (size_t i=0; i<a.size(); i++) {
+      unsigned long long carry = 0;
+      for (size_t j=0; j<b.size(); j++) {
+        carry += static_cast<unsigned long long>(a[i])*b[j] + res[i+j];
+        res[i+j] = static_cast<unsigned>(carry);
+        carry >>= 32;
+      }
+      res[i+b.size()] = static_cast<unsigned>(carry);
+    }
+    trim(res);
+  }
+
+  /** Divide @c a by the digit @c d in place and return the remainder */
+  static unsigned divideByDigit(Digits& a, unsigned d)
+  {
+    ASS_NEQ(d, 0);
+    unsigned long long rem = 0;
+    for (size_t i=a.size(); i>0; i--) {
+      unsigned long long cur = (rem<<32) | a[i-1];
+      a[i-1] = static_cast<unsigned>(cur/d);
+      rem = cur%d;
+    }
+    trim(a);
+    return static_cast<unsigned>(rem);
+  }
+
+  static void divide(const Digits& a, const Digits& b, Digits& quot, Digits& rem)
+  {
+    ASS(b.isNonEmpty());
+
+    quot = a;
+    rem.reset();
+    if (b.size()==1) {
+      rem.push(divideByDigit(quot, b[0]));
+      trim(rem);
+      return;
+    }
+    // long division by bits
+    for (size_t i=0; i<quot.size(); i++) {
+      quot[i] = 0;
+    }
+    for (size_t i=a.size()*32; i>0; i--) {
+      unsigned bit = (a[(i-1)/32] >> ((i-1)%32)) & 1;
+      unsigned carry = bit;
+      for (size_t j=0; j<rem.size(); j++) {
+        unsigned next = rem[j] >> 31;
+        rem[j] = (rem[j] << 1) | carry;
+        carry = next;
+      }
+      if (carry) {
+        rem.push(carry);
+      }
+      if (compare(rem, b)>=0) {
+        subtract(rem, b);
+        quot[(i-1)/32] |= 1u << ((i-1)%32);
+      }
+    }
+    trim(quot);
+  }
+};
+
+void BigInteger::acquire(Big* big)
+{
+  big->refCnt++;
+}
+
+void BigInteger::release(Big* big)
+{
+  ASS_G(big->refCnt,0);
+  if (--big->refCnt==0) {
+    DEALLOC_KNOWN(big, Big::size(big->length), "BigInteger::Big");
+  }
+}
+
+BigInteger BigInteger::fromLongLongBig(long long val)
+{
+  CALL("BigInteger::fromLongLongBig");
+
+  bool negative = val<0;
+  unsigned long long abs = negative ? 0ull-static_cast<unsigned long long>(val) : val;
+  Big::Digits mag;
+  mag.push(static_cast<unsigned>(abs));
+  mag.push(static_cast<unsigned>(abs>>32));
+  return Big::make(mag, negative);
+}
+
+BigInteger BigInteger::add(const BigInteger& a, const BigInteger& b, bool subtract)
+{
+  CALL("BigInteger::add");
+
+  static Big::Digits x, y, res;
+  bool xNeg, yNeg;
+  Big::get(a, x, xNeg);
+  Big::get(b, y, yNeg);
+  yNeg ^= subtract;
+  if (xNeg==yNeg) {
+    Big::add(x, y, res);
+    return Big::make(res, xNeg);
+  }
+  if (Big::compare(x, y)>=0) {
+    Big::subtract(x, y);
+    return Big::make(x, xNeg);
+  }
+  Big::subtract(y, x);
+  return Big::make(y, yNeg);
+}
+
+BigInteger BigInteger::negate(const BigInteger& a)
+{
+  CALL("BigInteger::negate");
+
+  static Big::Digits x;
+  bool xNeg;
+  Big::get(a, x, xNeg);
+  return Big::make(x, !xNeg);
+}
+
+BigInteger BigInteger::multiply(const BigInteger& a, const BigInteger& b)
+{
+  CALL("BigInteger::multiply");
+
+  static Big::Digits x, y, res;
+  bool xNeg, yNeg;
+  Big::get(a, x, xNeg);
+  Big::get(b, y, yNeg);
+  Big::multiply(x, y, res);
+  return Big::make(res, xNeg!=yNeg);
+}
+
+void BigInteger::divide(const BigInteger& a, const BigInteger& b, BigInteger* quot, BigInteger* rem)
+{
+  CALL("BigInteger::divide");
+  ASS(!b.isZero());
+
+  static Big::Digits x, y, q, r;
+  bool xNeg, yNeg;
+  Big::get(a, x, xNeg);
+  Big::get(b, y, yNeg);
+  Big::divide(x, y, q, r);
+  if (quot) {
+    *quot = Big::make(q, xNeg!=yNeg);
+  }
+  if (rem) {
+    *rem = Big::make(r, xNeg);
+  }
+}
+
+int BigInteger::compareBig(const BigInteger& a, const BigInteger& b)
+{
+  CALL("BigInteger::compareBig");
+
+  int aSign = a.sign();
+  int bSign = b.sign();
+  if (aSign!=bSign) {
+    return aSign<bSign ? -1 : 1;
+  }
+  static Big::Digits x, y;
+  bool xNeg, yNeg;
+  Big::get(a, x, xNeg);
+  Big::get(b, y, yNeg);
+  int res = Big::compare(x, y);
+  return xNeg ? -res : res;
+}
+
+int BigInteger::bigSign(const Big* big)
+{
+  return big->negative ? -1 : 1;
+}
+
+vstring BigInteger::toString() const
+{
+  CALL("BigInteger::toString");
+
+  if (!_big) {
+    return Int::toString(_small);
+  }
+  Big::Digits mag;
+  bool negative;
+  Big::get(*this, mag, negative);
+  // digits in base 10^9, least significant first
+  Stack<unsigned> chunks;
+  while (mag.isNonEmpty()) {
+    chunks.push(Big::divideByDigit(mag, 1000000000u));
+  }
+  vstring res = negative ? "-" : "";
+  res += Int::toString(chunks.top());
+  for (size_t i=chunks.size()-1; i>0; i--) {
+    vstring chunk = Int::toString(chunks[i-1]);
+    res += vstring(9-chunk.size(), '0') + chunk;
+  }
+  return res;
+}
+
+double BigInteger::toDouble() const
+{
+  if (!_big) {
+    return _small;
+  }
+  double res = 0;
+  for (unsigned i=_big->length; i>0; i--) {
+    res = res*4294967296.0 + _big->digits[i-1];
+  }
+  return _big->negative ? -res : res;
+}
+
+unsigned BigInteger::bitLength() const
+{
+  if (!_big) {
+    return Lib::bitLength(_small<0 ? -static_cast<long long>(_small) : _small);
+  }
+  return 32*(_big->length-1) + Lib::bitLength(_big->digits[_big->length-1]);
+}
+
+#endif // GNUMP
+
+}
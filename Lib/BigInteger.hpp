@@ -0,0 +1,216 @@
+/*
+ * File BigInteger.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file BigInteger.hpp
+ * Defines class BigInteger.
+ */
+
+#ifndef __BigInteger__
+#define __BigInteger__
+
+#include <climits>
+#include <ostream>
+
+#include "Forwards.hpp"
+
+#include "Debug/Assertion.hpp"
+
+#include "VString.hpp"
+
+namespace Lib {
+
+/**
+ * Integer of arbitrary size
+ *
+ * A value that fits into an int is stored inline, and the arithmetic on
+ * such values only computes the result in 64 bits and checks whether it
+ * fits again, so it does not allocate. Other values are stored in an
+ * immutable reference counted block, which contains a GMP integer when
+ * Vampire is compiled with GNUMP=1 and an array of 32-bit digits otherwise.
+ *
+ * A value is stored inline whenever it fits, so an inline value and
+ * a value in a block are never equal.
+ */
+class BigInteger
+{
+public:
+  BigInteger() : _small(0), _big(0) {}
+  BigInteger(int val) : _small(val), _big(0) {}
+  BigInteger(const BigInteger& o) : _small(o._small), _big(o._big)
+  {
+    if (_big) {
+      acquire(_big);
+    }
+  }
+  ~BigInteger()
+  {
+    if (_big) {
+      release(_big);
+    }
+  }
+  BigInteger& operator=(const BigInteger& o)
+  {
+    if (o._big) {
+      acquire(o._big);
+    }
+    if (_big) {
+      release(_big);
+    }
+    _small = o._small;
+    _big = o._big;
+    return *this;
+  }
+
+  static bool fromString(const vstring& str, BigInteger& res);
+  vstring toString() const;
+
+  BigInteger operator+(const BigInteger& o) const
+  {
+    if (!_big && !o._big) {
+      return fromLongLong(static_cast<long long>(_small)+o._small);
+    }
+    return add(*this, o, false);
+  }
+  BigInteger operator-(const BigInteger& o) const
+  {
+    if (!_big && !o._big) {
+      return fromLongLong(static_cast<long long>(_small)-o._small);
+    }
+    return add(*this, o, true);
+  }
+  BigInteger operator-() const
+  {
+    if (!_big) {
+      return fromLongLong(-static_cast<long long>(_small));
+    }
+    return negate(*this);
+  }
+  BigInteger operator*(const BigInteger& o) const
+  {
+    if (!_big && !o._big) {
+      return fromLongLong(static_cast<long long>(_small)*o._small);
+    }
+    return multiply(*this, o);
+  }
+  /** Quotient rounded towards zero, @c o must not be zero */
+  BigInteger operator/(const BigInteger& o) const
+  {
+    ASS(!o.isZero());
+    if (!_big && !o._big) {
+      return fromLongLong(static_cast<long long>(_small)/o._small);
+    }
+    BigInteger res;
+    divide(*this, o, &res, 0);
+    return res;
+  }
+  /** Remainder with the sign of this, @c o must not be zero */
+  BigInteger operator%(const BigInteger& o) const
+  {
+    ASS(!o.isZero());
+    if (!_big && !o._big) {
+      return BigInteger(static_cast<int>(static_cast<long long>(_small)%o._small));
+    }
+    BigInteger res;
+    divide(*this, o, 0, &res);
+    return res;
+  }
+
+  /** Return a negative number, zero or a positive number if @c a is smaller, equal or greater than @c b */
+  static int compare(const BigInteger& a, const BigInteger& b)
+  {
+    if (!a._big && !b._big) {
+      return (a._small>b._small) - (a._small<b._small);
+    }
+    return compareBig(a, b);
+  }
+
+  bool operator==(const BigInteger& o) const
+  {
+    if (!_big || !o._big) {
+      return _big==o._big && _small==o._small;
+    }
+    return compareBig(*this, o)==0;
+  }
+  bool operator!=(const BigInteger& o) const { return !((*this)==o); }
+  bool operator<(const BigInteger& o) const { return compare(*this, o)<0; }
+  bool operator>(const BigInteger& o) const { return compare(*this, o)>0; }
+  bool operator<=(const BigInteger& o) const { return compare(*this, o)<=0; }
+  bool operator>=(const BigInteger& o) const { return compare(*this, o)>=0; }
+
+  bool isZero() const { return !_big && _small==0; }
+  /** Return -1, 0 or 1 according to the sign of the value */
+  int sign() const
+  {
+    if (!_big) {
+      return (_small>0) - (_small<0);
+    }
+    return bigSign(_big);
+  }
+  BigInteger abs() const { return sign()<0 ? -(*this) : *this; }
+
+  /** True if the value fits into an int */
+  bool fitsInt() const { return !_big; }
+  int toInt() const
+  {
+    ASS(fitsInt());
+    return _small;
+  }
+  double toDouble() const;
+  /** Number of bits of the absolute value, zero for zero */
+  unsigned bitLength() const;
+
+  /** The greatest common divisor of the absolute values, zero if both are zero */
+  static BigInteger gcd(const BigInteger& a, const BigInteger& b);
+
+private:
+  struct Big;
+
+  /** Take over the reference held by @c big */
+  explicit BigInteger(Big* big) : _small(0), _big(big) {}
+
+  static BigInteger fromLongLong(long long val)
+  {
+    if (val>=INT_MIN && val<=INT_MAX) {
+      return BigInteger(static_cast<int>(val));
+    }
+    return fromLongLongBig(val);
+  }
+
+  static BigInteger fromLongLongBig(long long val);
+  static BigInteger add(const BigInteger& a, const BigInteger& b, bool subtract);
+  static BigInteger negate(const BigInteger& a);
+  static BigInteger multiply(const BigInteger& a, const BigInteger& b);
+  static void divide(const BigInteger& a, const BigInteger& b, BigInteger* quot, BigInteger* rem);
+  static int compareBig(const BigInteger& a, const BigInteger& b);
+  static int bigSign(const Big* big);
+  static void acquire(Big* big);
+  static void release(Big* big);
+
+  /** the value, if _big is zero */
+  int _small;
+  Big* _big;
+};
+
+inline
+std::ostream& operator<< (std::ostream& out, const BigInteger& val) {
+  return out << val.toString();
+}
+
+}
+
+#endif // __BigInteger__
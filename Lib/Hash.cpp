@@ -97,6 +97,25 @@ unsigned Hash::hash (const unsigned char* val,size_t size,unsigned hash)
   return hash;
 } // Hash::hash(const char* str)
 
+/**
+ * Hash an array of machine words a word at a time, by multiplying and
+ * shifting in 64 bits. It is much faster than the FNV-hashing of the
+ * bytes of the array.
+ */
+unsigned Hash::hashWords (const size_t* words,size_t length)
+{
+  CALL("Hash::hashWords");
+
+  unsigned long long hash = 0x9e3779b97f4a7c15ull ^ length;
+  for (size_t i = 0;i < length;i++) {
+    hash = (hash ^ words[i]) * 0xff51afd7ed558ccdull;
+    hash ^= hash >> 32;
+  }
+  hash *= 0xc4ceb9fe1a85ec53ull;
+  hash ^= hash >> 29;
+  return static_cast<unsigned>(hash);
+} // Hash::hashWords
+
 unsigned Hash::combineHashes(unsigned h1, unsigned h2){
   CALL("Hash::combineHashes");
   //not sure how well it behaves, just took the two FNV primes and
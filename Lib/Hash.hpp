@@ -116,6 +116,7 @@ public:
 
   static unsigned hash(const unsigned char*,size_t length);
   static unsigned hash(const unsigned char*,size_t length,unsigned begin);
+  static unsigned hashWords(const size_t* words,size_t length);
   
   static unsigned combineHashes(unsigned h1, unsigned h2);
 };
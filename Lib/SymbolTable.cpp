@@ -0,0 +1,169 @@
+/*
+ * File SymbolTable.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file SymbolTable.cpp
+ * Implements class SymbolTable.
+ */
+
+#include <cstring>
+
+#include "SymbolTable.hpp"
+
+namespace Lib
+{
+
+SymbolTable::SymbolTable()
+: _entries(0), _capacity(0), _size(0)
+{
+}
+
+SymbolTable::~SymbolTable()
+{
+  CALL("SymbolTable::~SymbolTable");
+
+  if(_entries) {
+    DEALLOC_KNOWN(_entries, _capacity*sizeof(Entry), "SymbolTable::Entry");
+  }
+}
+
+/**
+ * Hash of a name and an arity, computed on eight characters at a time
+ */
+unsigned SymbolTable::hash(const char* name, size_t length, unsigned arity)
+{
+  unsigned long long hash = 0x9e3779b97f4a7c15ull ^ length;
+  size_t i = 0;
+  for(;;) {
+    unsigned long long word = 0;
+    if(i+sizeof(word)<=length) {
+      memcpy(&word, name+i, sizeof(word));
+    }
+    else if(i<length) {
+      memcpy(&word, name+i, length-i);
+    }
+    else {
+      break;
+    }
+    hash = (hash ^ word) * 0xff51afd7ed558ccdull;
+    hash ^= hash >> 32;
+    i += sizeof(word);
+  }
+  hash = (hash ^ arity) * 0xc4ceb9fe1a85ec53ull;
+  hash ^= hash >> 29;
+  return static_cast<unsigned>(hash);
+}
+
+/**
+ * Return the entry of the name and arity, or the free entry where they
+ * should be inserted. The table must not be full.
+ */
+SymbolTable::Entry* SymbolTable::findEntry(const char* name, size_t length, unsigned arity, unsigned hash) const
+{
+  ASS_L(_size, _capacity);
+
+  unsigned mask = _capacity-1;
+  for(unsigned i = hash & mask;;i = (i+1) & mask) {
+    Entry* e = _entries+i;
+    if(!e->name) {
+      return e;
+    }
+    if(e->hash==hash && e->arity==arity && e->length==length && memcmp(e->name, name, length)==0) {
+      return e;
+    }
+  }
+}
+
+/**
+ * If the symbol with name @c name and arity @c arity is in the table,
+ * assign its number to @c num and return true. Otherwise return false.
+ */
+bool SymbolTable::find(const vstring& name, unsigned arity, unsigned& num) const
+{
+  CALL("SymbolTable::find");
+
+  if(!_size) {
+    return false;
+  }
+  Entry* e = findEntry(name.data(), name.size(), arity, hash(name.data(), name.size(), arity));
+  if(!e->name) {
+    return false;
+  }
+  num = e->num;
+  return true;
+}
+
+/**
+ * Insert symbol number @c num with the name given by @c length characters
+ * at @c name and arity @c arity, which must not be in the table yet.
+ *
+ * The characters are not copied, they must stay unchanged as long as the
+ * table exists.
+ */
+void SymbolTable::insert(const char* name, size_t length, unsigned arity, unsigned num)
+{
+  CALL("SymbolTable::insert");
+
+  if(2*(_size+1)>_capacity) {
+    expand();
+  }
+  unsigned h = hash(name, length, arity);
+  Entry* e = findEntry(name, length, arity, h);
+  ASS(!e->name);
+
+  e->name = name;
+  e->length = length;
+  e->hash = h;
+  e->arity = arity;
+  e->num = num;
+  _size++;
+}
+
+/**
+ * Double the capacity of the table. The entries are moved using their
+ * stored hashes.
+ */
+void SymbolTable::expand()
+{
+  CALL("SymbolTable::expand");
+
+  Entry* oldEntries = _entries;
+  unsigned oldCapacity = _capacity;
+
+  _capacity = oldCapacity ? 2*oldCapacity : 64;
+  _entries = static_cast<Entry*>(ALLOC_KNOWN(_capacity*sizeof(Entry), "SymbolTable::Entry"));
+  memset(_entries, 0, _capacity*sizeof(Entry));
+
+  unsigned mask = _capacity-1;
+  for(unsigned i = 0; i<oldCapacity; i++) {
+    Entry& e = oldEntries[i];
+    if(!e.name) {
+      continue;
+    }
+    unsigned j = e.hash & mask;
+    while(_entries[j].name) {
+      j = (j+1) & mask;
+    }
+    _entries[j] = e;
+  }
+
+  if(oldEntries) {
+    DEALLOC_KNOWN(oldEntries, oldCapacity*sizeof(Entry), "SymbolTable::Entry");
+  }
+}
+
+}
@@ -0,0 +1,94 @@
+/*
+ * File SymbolTable.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file SymbolTable.hpp
+ * Defines class SymbolTable.
+ */
+
+#ifndef __SymbolTable__
+#define __SymbolTable__
+
+#include <cstddef>
+
+#include "Debug/Assertion.hpp"
+#include "Debug/Tracer.hpp"
+
+#include "Allocator.hpp"
+#include "VString.hpp"
+
+namespace Lib {
+
+/**
+ * Map from a name and an arity to a symbol number
+ *
+ * A lookup hashes the characters of the name word by word and does not
+ * build any key string. The table does not copy the names: an entry
+ * points to characters owned by the caller, such as the name kept in
+ * the symbol itself. The hash of each entry is stored, so that the table
+ * can grow without hashing the names again.
+ */
+class SymbolTable
+{
+public:
+  CLASS_NAME(SymbolTable);
+  USE_ALLOCATOR(SymbolTable);
+
+  SymbolTable();
+  ~SymbolTable();
+
+  bool find(const vstring& name, unsigned arity, unsigned& num) const;
+  bool find(const vstring& name, unsigned arity) const
+  {
+    unsigned dummy;
+    return find(name, arity, dummy);
+  }
+  unsigned get(const vstring& name, unsigned arity) const
+  {
+    unsigned res;
+    ALWAYS(find(name, arity, res));
+    return res;
+  }
+
+  void insert(const char* name, size_t length, unsigned arity, unsigned num);
+
+  /** Number of the names in the table */
+  unsigned size() const { return _size; }
+
+private:
+  struct Entry {
+    /** characters of the name, zero if the entry is free */
+    const char* name;
+    size_t length;
+    unsigned hash;
+    unsigned arity;
+    unsigned num;
+  };
+
+  static unsigned hash(const char* name, size_t length, unsigned arity);
+  Entry* findEntry(const char* name, size_t length, unsigned arity, unsigned hash) const;
+  void expand();
+
+  /** open addressing table with linear probing, its capacity is a power of two */
+  Entry* _entries;
+  unsigned _capacity;
+  unsigned _size;
+};
+
+}
+
+#endif // __SymbolTable__
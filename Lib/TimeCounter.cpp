@@ -181,236 +181,172 @@ void TimeCounter::printReport(ostream& out)
   out<<endl;
 }
 
-void TimeCounter::outputSingleStat(TimeCounterUnit tcu, ostream& out)
+/**
+ * Return the name under which the time of @c tcu is reported
+ */
+const char* TimeCounter::unitName(TimeCounterUnit tcu)
 {
-  if (s_measureInitTimes[tcu]==-1 && !s_measuredTimes[tcu]) {
-    return;
-  }
-
-  addCommentSignForSZS(out);
   switch(tcu) {
   case TC_RAND_OPT:
-    out << "random option generation";
-    break;
+    return "random option generation";
   case TC_BACKWARD_DEMODULATION:
-    out<<"backward demodulation";
-    break;
+    return "backward demodulation";
   case TC_BACKWARD_SUBSUMPTION:
-    out<<"backward subsumption";
-    break;
+    return "backward subsumption";
   case TC_BACKWARD_SUBSUMPTION_RESOLUTION:
-    out<<"backward subsumption resolution";
-    break;
+    return "backward subsumption resolution";
   case TC_BDD:
-    out<<"BDD operations";
-    break;
+    return "BDD operations";
   case TC_BDD_CLAUSIFICATION:
-    out<<"BDD clausification";
-    break;
+    return "BDD clausification";
   case TC_BDD_MARKING_SUBSUMPTION:
-    out<<"BDD marking subsumption";
-    break;
+    return "BDD marking subsumption";
   case TC_INTERPRETED_EVALUATION:
-    out<<"interpreted evaluation";
-    break;
+    return "interpreted evaluation";
   case TC_INTERPRETED_SIMPLIFICATION:
-    out<<"interpreted simplification";
-    break;
+    return "interpreted simplification";
   case TC_CONDENSATION:
-    out<<"condensation";
-    break;
+    return "condensation";
   case TC_CONSEQUENCE_FINDING:
-    out<<"consequence finding";
-    break;
+    return "consequence finding";
   case TC_FORWARD_DEMODULATION:
-    out<<"forward demodulation";
-    break;
+    return "forward demodulation";
   case TC_FORWARD_SUBSUMPTION:
-    out<<"forward subsumption";
-    break;
+    return "forward subsumption";
   case TC_FORWARD_SUBSUMPTION_RESOLUTION:
-    out<<"forward subsumption resolution";
-    break;
+    return "forward subsumption resolution";
   case TC_FORWARD_LITERAL_REWRITING:
-    out<<"forward literal rewriting";
-    break;
+    return "forward literal rewriting";
   case TC_GLOBAL_SUBSUMPTION:
-    out<<"global subsumption";
-    break;
+    return "global subsumption";
   case TC_SIMPLIFYING_UNIT_LITERAL_INDEX_MAINTENANCE:
-    out<<"unit clause index maintenance";
-    break;
+    return "unit clause index maintenance";
   case TC_NON_UNIT_LITERAL_INDEX_MAINTENANCE:
-    out<<"non unit clause index maintenance";
-    break;
+    return "non unit clause index maintenance";
   case TC_FORWARD_SUBSUMPTION_INDEX_MAINTENANCE:
-    out<<"forward subsumption index maintenance";
-    break;
+    return "forward subsumption index maintenance";
   case TC_BINARY_RESOLUTION_INDEX_MAINTENANCE:
-    out<<"binary resolution index maintenance";
-    break;
+    return "binary resolution index maintenance";
   case TC_BACKWARD_SUBSUMPTION_INDEX_MAINTENANCE:
-    out<<"backward subsumption index maintenance";
-    break;
+    return "backward subsumption index maintenance";
   case TC_BACKWARD_SUPERPOSITION_INDEX_MAINTENANCE:
-    out<<"backward superposition index maintenance";
-    break;
+    return "backward superposition index maintenance";
   case TC_FORWARD_SUPERPOSITION_INDEX_MAINTENANCE:
-    out<<"forward superposition index maintenance";
-    break;
+    return "forward superposition index maintenance";
   case TC_BACKWARD_DEMODULATION_INDEX_MAINTENANCE:
-    out<<"backward demodulation index maintenance";
-    break;
+    return "backward demodulation index maintenance";
   case TC_FORWARD_DEMODULATION_INDEX_MAINTENANCE:
-    out<<"forward demodulation index maintenance";
-    break;
+    return "forward demodulation index maintenance";
   case TC_SPLITTING_COMPONENT_INDEX_MAINTENANCE:
-    out<<"splitting component index maintenance";
-    break;
+    return "splitting component index maintenance";
   case TC_SPLITTING_COMPONENT_INDEX_USAGE:
-    out<<"splitting component index usage";
-    break;
+    return "splitting component index usage";
   case TC_SPLITTING_MODEL_UPDATE:
-    out<<"splitting model update";
-    break;
+    return "splitting model update";
   case TC_CONGRUENCE_CLOSURE:
-    out<<"congruence closure";
-    break;
+    return "congruence closure";
   case TC_CCMODEL:
-    out<<"model from congruence closure";
-    break;
+    return "model from congruence closure";
   case TC_INST_GEN_SAT_SOLVING:
-    out<<"inst gen SAT solving";
-    break;
+    return "inst gen SAT solving";
   case TC_INST_GEN_SIMPLIFICATIONS:
-    out<<"inst gen simplifications";
-    break;
+    return "inst gen simplifications";
   case TC_INST_GEN_VARIANT_DETECTION:
-    out<<"inst gen variant detection";
-    break;
+    return "inst gen variant detection";
   case TC_INST_GEN_GEN_INST:
-    out<<"inst gen generating instances";
-    break;
+    return "inst gen generating instances";
   case TC_LRS_LIMIT_MAINTENANCE:
-    out<<"LRS limit maintenance";
-    break;
+    return "LRS limit maintenance";
   case TC_LITERAL_REWRITE_RULE_INDEX_MAINTENANCE:
-    out<<"literal rewrite rule index maintenance";
-    break;
+    return "literal rewrite rule index maintenance";
   case TC_OTHER:
-    out<<"other";
-    break;
+    return "other";
   case TC_PARSING:
-    out<<"parsing";
-    break;
+    return "parsing";
   case TC_PREPROCESSING:
-    out<<"preprocessing";
-    break;
+    return "preprocessing";
   case TC_BCE:
-    out<<"blocked clause elimination";
-    break;
+    return "blocked clause elimination";
   case TC_PROPERTY_EVALUATION:
-    out<<"property evaluation";
-    break;
+    return "property evaluation";
   case TC_SINE_SELECTION:
-    out<<"sine selection";
-    break;
+    return "sine selection";
   case TC_RESOLUTION:
-    out<<"resolution";
-    break;
+    return "resolution";
   case TC_UR_RESOLUTION:
-    out<<"unit resulting resolution";
-    break;
+    return "unit resulting resolution";
   case TC_SAT_SOLVER:
-    out<<"SAT solver time";
-    break;
+    return "SAT solver time";
   case TC_TWLSOLVER_ADD:
-    out<<"TWLSolver add clauses";
-    break;
-    break;
+    return "TWLSolver add clauses";
   case TC_MINIMIZING_SOLVER:
-    out << "minimizing solver time";
-    break;
+    return "minimizing solver time";
   case TC_SAT_PROOF_MINIMIZATION:
-    out << "sat proof minimization";
-    break;
+    return "sat proof minimization";
   case TC_SUPERPOSITION:
-    out<<"superposition";
-    break;
+    return "superposition";
   case TC_LITERAL_ORDER_AFTERCHECK:
-    out<<"literal order aftercheck";
-    break;
+    return "literal order aftercheck";
   case TC_HYPER_SUPERPOSITION:
-    out<<"hyper superposition";
-    break;
+    return "hyper superposition";
   case TC_TERM_SHARING:
-    out<<"term sharing";
-    break;
+    return "term sharing";
   case TC_TRIVIAL_PREDICATE_REMOVAL:
-    out<<"trivial predicate removal";
-    break;
+    return "trivial predicate removal";
   case TC_SOLVING:
-    out << "Bound propagation solving";
-    break;
+    return "Bound propagation solving";
   case TC_BOUND_PROPAGATION:
-    out << "Bound propagation";
-    break;
+    return "Bound propagation";
   case TC_HANDLING_CONFLICTS:
-    out << "handling conflicts";
-    break;
+    return "handling conflicts";
   case TC_VARIABLE_SELECTION:
-    out << "variable selection";
-    break;
+    return "variable selection";
   case TC_DISMATCHING:
-    out << "dismatching";
-    break;
+    return "dismatching";
   case TC_FMB_DEF_INTRO:
-    out << "fmb definition introduction";
-    break;
+    return "fmb definition introduction";
   case TC_FMB_SORT_INFERENCE:
-    out << "fmb sort inference"; 
-    break;
+    return "fmb sort inference";
   case TC_FMB_FLATTENING:
-    out << "fmb flattening";
-    break;
+    return "fmb flattening";
   case TC_FMB_SPLITTING:
-    out << "fmb splitting";
-    break;
+    return "fmb splitting";
   case TC_FMB_SAT_SOLVING:
-    out << "fmb sat solving";
-    break;
+    return "fmb sat solving";
   case TC_FMB_CONSTRAINT_CREATION:
-    out << "fmb constraint creation";
-    break;
+    return "fmb constraint creation";
   case TC_HCVI_COMPUTE_HASH:
-    out << "hvci compute hash";
-    break;
+    return "hvci compute hash";
   case TC_HCVI_INSERT:
-    out << "hvci insert";
-    break;
+    return "hvci insert";
   case TC_HCVI_RETRIEVE:
-      out << "hvci retrieve";
-      break;
+    return "hvci retrieve";
   case TC_MINISAT_ELIMINATE_VAR:
-    out << "minisat eliminate var";
-    break;
+    return "minisat eliminate var";
   case TC_MINISAT_BWD_SUBSUMPTION_CHECK:
-      out << "minisat bwd subsumption check";
-      break;
+    return "minisat bwd subsumption check";
   case TC_Z3_IN_FMB:
-    out << "smt search for next domain size assignment";
-    break;
+    return "smt search for next domain size assignment";
   case TC_NAMING:
-    out << "naming";
+    return "naming";
   case TC_LITERAL_SELECTION:
-    out << "literal selection";
-    break;
+    return "literal selection";
   case TC_THEORY_INST_SIMP:
-    out << "theory instantiation and simplification";
-    break;
+    return "theory instantiation and simplification";
   default:
     ASSERTION_VIOLATION;
+    return "unknown";
+  }
+}
+
+void TimeCounter::outputSingleStat(TimeCounterUnit tcu, ostream& out)
+{
+  if (s_measureInitTimes[tcu]==-1 && !s_measuredTimes[tcu]) {
+    return;
   }
+
+  addCommentSignForSZS(out);
+  out << unitName(tcu);
   out<<": ";
 
   Timer::printMSString(out, s_measuredTimes[tcu]);
@@ -424,3 +360,26 @@ void TimeCounter::outputSingleStat(TimeCounterUnit tcu, ostream& out)
   out<<endl;
 }
 
+/**
+ * Print the measured times in milliseconds as the members of a JSON object
+ */
+void TimeCounter::printJson(ostream& out)
+{
+  CALL("TimeCounter::printJson");
+
+  if (!s_measuring) {
+    return;
+  }
+  snapShot();
+
+  bool first = true;
+  for (int i=0; i<__TC_ELEMENT_COUNT; i++) {
+    TimeCounterUnit tcu = static_cast<TimeCounterUnit>(i);
+    if (s_measureInitTimes[tcu]==-1 && !s_measuredTimes[tcu]) {
+      continue;
+    }
+    out << (first ? "\"" : ",\"") << unitName(tcu) << "\":" << s_measuredTimes[tcu];
+    first = false;
+  }
+}
+
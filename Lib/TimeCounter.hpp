@@ -125,6 +125,7 @@ public:
   }
 
   static void printReport(ostream& out);
+  static void printJson(ostream& out);
 
 
   /**
@@ -150,6 +151,7 @@ private:
   void stopMeasuring();
 
   static void initialize();
+  static const char* unitName(TimeCounterUnit tcu);
   static void outputSingleStat(TimeCounterUnit tcu, ostream& out);
 
   /**
@@ -0,0 +1,108 @@
+/*
+ * File Varint.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file Varint.hpp
+ * Defines class Varint.
+ */
+
+#ifndef __Varint__
+#define __Varint__
+
+#include <cstdio>
+#include <istream>
+#include <ostream>
+
+#include "Lib/Stack.hpp"
+
+namespace Lib {
+
+/**
+ * Variable-length encoding of unsigned integers used by the binary
+ * traces and logs
+ *
+ * The number is written in groups of seven bits, least significant group
+ * first. The highest bit of a byte is set iff more bytes follow, so that
+ * numbers below 128 take a single byte and no number takes more than
+ * @c MAX_BYTES bytes.
+ */
+class Varint
+{
+public:
+  static const unsigned MAX_BYTES = 5;
+
+  static void write(unsigned val, Stack<unsigned char>& out)
+  {
+    while(val>=0x80) {
+      out.push(static_cast<unsigned char>((val&0x7F)|0x80));
+      val >>= 7;
+    }
+    out.push(static_cast<unsigned char>(val));
+  }
+
+  static void write(unsigned val, std::ostream& out)
+  {
+    while(val>=0x80) {
+      out.put(static_cast<char>((val&0x7F)|0x80));
+      val >>= 7;
+    }
+    out.put(static_cast<char>(val));
+  }
+
+  /**
+   * Read a number from the bytes between @c pos and @c end into @c val
+   * and move @c pos after it. Return false if the bytes end in the middle
+   * of the number or the number is longer than @c MAX_BYTES.
+   */
+  static bool read(const unsigned char*& pos, const unsigned char* end, unsigned& val)
+  {
+    val = 0;
+    for(unsigned shift=0;pos<end && shift<7*MAX_BYTES;shift+=7) {
+      unsigned char b = *pos++;
+      val |= static_cast<unsigned>(b&0x7F)<<shift;
+      if(!(b&0x80)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * Read a number from @c in into @c val. Return false if the stream
+   * ends in the middle of the number or the number is longer than
+   * @c MAX_BYTES.
+   */
+  static bool read(std::istream& in, unsigned& val)
+  {
+    val = 0;
+    for(unsigned shift=0;shift<7*MAX_BYTES;shift+=7) {
+      int b = in.get();
+      if(b==EOF) {
+        return false;
+      }
+      val |= static_cast<unsigned>(b&0x7F)<<shift;
+      if(!(b&0x80)) {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+}
+
+#endif // __Varint__
@@ -76,8 +76,30 @@ void SMTLIB2::parse(istream& str)
 
   LispLexer lex(str);
   LispParser lpar(lex);
-  LExpr* expr = lpar.parse();
-  parse(expr);
+
+  // Commands are translated as soon as they are read and their
+  // expressions released right away, so that the lisp tree of the whole
+  // benchmark never needs to exist at once.
+  while (LExpr* lexp = lpar.parseNext()) {
+    CommandResult res = readCommand(lexp);
+    if (res != CR_RETAINED) {
+      LispParser::destroy(lexp);
+    }
+
+    if (res == CR_CHECK_SAT) {
+      if (LExpr* next = lpar.parseNext()) {
+        warnIfNotExit(next);
+        LispParser::destroy(next);
+      }
+      return;
+    }
+    if (res == CR_EXIT) {
+      if (LExpr* next = lpar.parseNext()) {
+        USER_ERROR("<eol> expected: "+next->toString());
+      }
+      return;
+    }
+  }
 }
 
 void SMTLIB2::parse(LExpr* bench)
@@ -95,172 +117,202 @@ void SMTLIB2::readBenchmark(LExprList* bench)
 
   // iteration over benchmark top level entries
   while(bRdr.hasNext()){
-    LExpr* lexp = bRdr.next();
-
-    LOG2("readBenchmark ",lexp->toString(true));
-
-    LispListReader ibRdr(lexp);
+    CommandResult res = readCommand(bRdr.next());
 
-    if (ibRdr.tryAcceptAtom("set-logic")) {
-      if (_logicSet) {
-        USER_ERROR("set-logic can appear only once in a problem");
+    if (res == CR_CHECK_SAT) {
+      if (bRdr.hasNext()) {
+        warnIfNotExit(bRdr.readListExpr());
       }
-      readLogic(ibRdr.readAtom());
-      ibRdr.acceptEOL();
-      continue;
+      break;
+    }
+    if (res == CR_EXIT) {
+      bRdr.acceptEOL();
+      break;
+    }
+  }
+}
+
+/**
+ * Warn that entries following check-sat are ignored, unless the
+ * entry @c next following it is just (exit).
+ */
+void SMTLIB2::warnIfNotExit(LExpr* next)
+{
+  CALL("SMTLIB2::warnIfNotExit");
+
+  LispListReader exitRdr(next);
+  if (!exitRdr.tryAcceptAtom("exit")) {
+    if(env.options->mode()!=Options::Mode::SPIDER) {
+      env.beginOutput();
+      env.out() << "% Warning: check-sat is not the last entry. Skipping the rest!" << endl;
+      env.endOutput();
     }
+  }
+}
 
-    if (ibRdr.tryAcceptAtom("set-info")) {
+/**
+ * Translate a single top level command @c lexp.
+ *
+ * Returns CR_RETAINED if parts of @c lexp are still referenced after
+ * the command has been read, so the caller must not destroy it.
+ */
+SMTLIB2::CommandResult SMTLIB2::readCommand(LExpr* lexp)
+{
+  CALL("SMTLIB2::readCommand");
 
-      if (ibRdr.tryAcceptAtom(":status")) {
-        _statusStr = ibRdr.readAtom();
-        ibRdr.acceptEOL();
-        continue;
-      }
+  LOG2("readCommand ",lexp->toString(true));
 
-      if (ibRdr.tryAcceptAtom(":source")) {
-        _sourceInfo = ibRdr.readAtom();
-        ibRdr.acceptEOL();
-        continue;
-      }
+  LispListReader ibRdr(lexp);
 
-      // ignore unknown info
-      ibRdr.readAtom();
-      ibRdr.readAtom();
-      ibRdr.acceptEOL();
-      continue;
+  if (ibRdr.tryAcceptAtom("set-logic")) {
+    if (_logicSet) {
+      USER_ERROR("set-logic can appear only once in a problem");
     }
+    readLogic(ibRdr.readAtom());
+    ibRdr.acceptEOL();
+    return CR_DONE;
+  }
 
-    if (ibRdr.tryAcceptAtom("declare-sort")) {
-      vstring name = ibRdr.readAtom();
-      vstring arity = ibRdr.readAtom();
-
-      readDeclareSort(name,arity);
+  if (ibRdr.tryAcceptAtom("set-info")) {
 
+    if (ibRdr.tryAcceptAtom(":status")) {
+      _statusStr = ibRdr.readAtom();
       ibRdr.acceptEOL();
+      return CR_DONE;
+    }
 
-      continue;
+    if (ibRdr.tryAcceptAtom(":source")) {
+      _sourceInfo = ibRdr.readAtom();
+      ibRdr.acceptEOL();
+      return CR_DONE;
     }
 
-    if (ibRdr.tryAcceptAtom("define-sort")) {
-      vstring name = ibRdr.readAtom();
-      LExprList* args = ibRdr.readList();
-      LExpr* body = ibRdr.readNext();
+    // ignore unknown info
+    ibRdr.readAtom();
+    ibRdr.readAtom();
+    ibRdr.acceptEOL();
+    return CR_DONE;
+  }
 
-      readDefineSort(name,args,body);
+  if (ibRdr.tryAcceptAtom("declare-sort")) {
+    vstring name = ibRdr.readAtom();
+    vstring arity = ibRdr.readAtom();
 
-      ibRdr.acceptEOL();
+    readDeclareSort(name,arity);
 
-      continue;
-    }
+    ibRdr.acceptEOL();
 
-    if (ibRdr.tryAcceptAtom("declare-fun")) {
-      vstring name = ibRdr.readAtom();
-      LExprList* iSorts = ibRdr.readList();
-      LExpr* oSort = ibRdr.readNext();
+    return CR_DONE;
+  }
 
-      readDeclareFun(name,iSorts,oSort);
+  if (ibRdr.tryAcceptAtom("define-sort")) {
+    vstring name = ibRdr.readAtom();
+    LExprList* args = ibRdr.readList();
+    LExpr* body = ibRdr.readNext();
 
-      ibRdr.acceptEOL();
+    readDefineSort(name,args,body);
 
-      continue;
-    }
+    ibRdr.acceptEOL();
 
-    if (ibRdr.tryAcceptAtom("declare-datatypes")) {
-      LExprList* sorts = ibRdr.readList();
-      LExprList* datatypes = ibRdr.readList();
+    // the sort definition keeps pointing into this command
+    return CR_RETAINED;
+  }
 
-      readDeclareDatatypes(sorts, datatypes, false);
+  if (ibRdr.tryAcceptAtom("declare-fun")) {
+    vstring name = ibRdr.readAtom();
+    LExprList* iSorts = ibRdr.readList();
+    LExpr* oSort = ibRdr.readNext();
 
-      ibRdr.acceptEOL();
+    readDeclareFun(name,iSorts,oSort);
 
-      continue;
-    }
+    ibRdr.acceptEOL();
 
-    if (ibRdr.tryAcceptAtom("declare-codatatypes")) {
-      LExprList* sorts = ibRdr.readList();
-      LExprList* datatypes = ibRdr.readList();
+    return CR_DONE;
+  }
 
-      readDeclareDatatypes(sorts, datatypes, true);
+  if (ibRdr.tryAcceptAtom("declare-datatypes")) {
+    LExprList* sorts = ibRdr.readList();
+    LExprList* datatypes = ibRdr.readList();
 
-      ibRdr.acceptEOL();
+    readDeclareDatatypes(sorts, datatypes, false);
 
-      continue;
-    }
-    
-    if (ibRdr.tryAcceptAtom("declare-const")) {
-      vstring name = ibRdr.readAtom();
-      LExpr* oSort = ibRdr.readNext();
+    ibRdr.acceptEOL();
 
-      readDeclareFun(name,nullptr,oSort);
+    return CR_DONE;
+  }
 
-      ibRdr.acceptEOL();
+  if (ibRdr.tryAcceptAtom("declare-codatatypes")) {
+    LExprList* sorts = ibRdr.readList();
+    LExprList* datatypes = ibRdr.readList();
 
-      continue;
-    }
+    readDeclareDatatypes(sorts, datatypes, true);
 
-    if (ibRdr.tryAcceptAtom("define-fun")) {
-      vstring name = ibRdr.readAtom();
-      LExprList* iArgs = ibRdr.readList();
-      LExpr* oSort = ibRdr.readNext();
-      LExpr* body = ibRdr.readNext();
+    ibRdr.acceptEOL();
 
-      readDefineFun(name,iArgs,oSort,body);
+    return CR_DONE;
+  }
+  
+  if (ibRdr.tryAcceptAtom("declare-const")) {
+    vstring name = ibRdr.readAtom();
+    LExpr* oSort = ibRdr.readNext();
 
-      ibRdr.acceptEOL();
+    readDeclareFun(name,nullptr,oSort);
 
-      continue;
-    }
+    ibRdr.acceptEOL();
 
-    if (ibRdr.tryAcceptAtom("assert")) {
-      readAssert(ibRdr.readNext());
+    return CR_DONE;
+  }
 
-      ibRdr.acceptEOL();
+  if (ibRdr.tryAcceptAtom("define-fun")) {
+    vstring name = ibRdr.readAtom();
+    LExprList* iArgs = ibRdr.readList();
+    LExpr* oSort = ibRdr.readNext();
+    LExpr* body = ibRdr.readNext();
 
-      continue;
-    }
+    readDefineFun(name,iArgs,oSort,body);
 
-    if (ibRdr.tryAcceptAtom("check-sat")) {
-      if (bRdr.hasNext()) {
-        LispListReader exitRdr(bRdr.readList());
-        if (!exitRdr.tryAcceptAtom("exit")) {
-          if(env.options->mode()!=Options::Mode::SPIDER) {
-            env.beginOutput();
-            env.out() << "% Warning: check-sat is not the last entry. Skipping the rest!" << endl;
-            env.endOutput();
-          }
-        }
-      }
-      break;
-    }
+    ibRdr.acceptEOL();
 
-    if (ibRdr.tryAcceptAtom("exit")) {
-      bRdr.acceptEOL();
-      break;
-    }
+    return CR_DONE;
+  }
 
-    if (ibRdr.tryAcceptAtom("reset")) {
-      LOG1("ignoring reset");
-      continue;
-    }
+  if (ibRdr.tryAcceptAtom("assert")) {
+    readAssert(ibRdr.readNext());
 
-    if (ibRdr.tryAcceptAtom("set-option")) {
-      LOG2("ignoring set-option", ibRdr.readAtom());
-      continue;
-    }
+    ibRdr.acceptEOL();
 
-    if (ibRdr.tryAcceptAtom("push")) {
-      LOG1("ignoring push");
-      continue;
-    }
+    return CR_DONE;
+  }
 
-    if (ibRdr.tryAcceptAtom("get-info")) {
-      LOG2("ignoring get-info", ibRdr.readAtom());
-      continue;
-    }
+  if (ibRdr.tryAcceptAtom("check-sat")) {
+    return CR_CHECK_SAT;
+  }
+
+  if (ibRdr.tryAcceptAtom("exit")) {
+    return CR_EXIT;
+  }
+
+  if (ibRdr.tryAcceptAtom("reset")) {
+    LOG1("ignoring reset");
+    return CR_DONE;
+  }
+
+  if (ibRdr.tryAcceptAtom("set-option")) {
+    LOG2("ignoring set-option", ibRdr.readAtom());
+    return CR_DONE;
+  }
 
-    USER_ERROR("unrecognized entry "+ibRdr.readAtom());
+  if (ibRdr.tryAcceptAtom("push")) {
+    LOG1("ignoring push");
+    return CR_DONE;
   }
+
+  if (ibRdr.tryAcceptAtom("get-info")) {
+    LOG2("ignoring get-info", ibRdr.readAtom());
+    return CR_DONE;
+  }
+
+  USER_ERROR("unrecognized entry "+ibRdr.readAtom());
 }
 
 //  ----------------------------------------------------------------------
@@ -436,6 +436,25 @@ private:
    */
   Set<vstring> _overflow;
 
+  /** Outcome of reading a single toplevel command */
+  enum CommandResult {
+    /** the command is processed and its expression can be released */
+    CR_DONE,
+    /** the command is processed, but its expression is still referenced */
+    CR_RETAINED,
+    /** check-sat was read, no further commands are processed */
+    CR_CHECK_SAT,
+    /** exit was read, it has to be the last command */
+    CR_EXIT
+  };
+
+  /**
+   * Toplevel parsing dispatch for a single command.
+   */
+  CommandResult readCommand(LExpr* lexp);
+
+  void warnIfNotExit(LExpr* next);
+
   /**
    * Toplevel parsing dispatch for a benchmark.
    */
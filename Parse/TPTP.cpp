@@ -3530,10 +3530,18 @@ Formula* TPTP::makeJunction (Connective c,Formula* lhs,Formula* rhs)
  * @param arg some argument of the function, require to resolve its type for overloaded
  *        built-in functions
  */
-unsigned TPTP::addFunction(vstring name,int arity,bool& added,TermList& arg)
+unsigned TPTP::addFunction(const vstring& name,int arity,bool& added,TermList& arg)
 {
   CALL("TPTP::addFunction");
 
+  if (name[0] != '$') {
+    // not a built-in function, skip the comparisons below
+    if (arity > 0) {
+      return env.signature->addFunction(name,arity,added);
+    }
+    return addUninterpretedConstant(name,_overflow,added);
+  }
+
   if (name == "$sum") {
     return addOverloadedFunction(name,arity,2,added,arg,
 				 Theory::INT_PLUS,
@@ -3695,10 +3703,15 @@ unsigned TPTP::addFunction(vstring name,int arity,bool& added,TermList& arg)
  * @return the predicate number in the signature, or -1 if it is a different name for an equality
  *         predicate
  */
-int TPTP::addPredicate(vstring name,int arity,bool& added,TermList& arg)
+int TPTP::addPredicate(const vstring& name,int arity,bool& added,TermList& arg)
 {
   CALL("TPTP::addPredicate");
 
+  if (name[0] != '$') {
+    // not a built-in predicate
+    return env.signature->addPredicate(name,arity,added);
+  }
+
   if (name == "$evaleq" || name == "$equal") {
     return -1;
   }
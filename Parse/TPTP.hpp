@@ -745,8 +745,8 @@ private:
   void unbindVariables();
   void skipToRPAR();
   void skipToRBRA();
-  unsigned addFunction(vstring name,int arity,bool& added,TermList& someArgument);
-  int addPredicate(vstring name,int arity,bool& added,TermList& someArgument);
+  unsigned addFunction(const vstring& name,int arity,bool& added,TermList& someArgument);
+  int addPredicate(const vstring& name,int arity,bool& added,TermList& someArgument);
   unsigned addOverloadedFunction(vstring name,int arity,int symbolArity,bool& added,TermList& arg,
 				 Theory::Interpretation integer,Theory::Interpretation rational,
 				 Theory::Interpretation real);
@@ -0,0 +1,1124 @@
+/*
+ * File CDCLSolver.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file CDCLSolver.cpp
+ * Implements class CDCLSolver.
+ */
+
+#include <algorithm>
+#include <climits>
+
+#include "Debug/Tracer.hpp"
+
+#include "Lib/Sort.hpp"
+
+#include "SATInference.hpp"
+
+#include "CDCLSolver.hpp"
+
+namespace SAT
+{
+
+using namespace Lib;
+
+const CDCLSolver::ClauseRef CDCLSolver::NO_CLAUSE;
+const CDCLSolver::Lit CDCLSolver::NO_LIT;
+const unsigned CDCLSolver::NO_NODE;
+const unsigned CDCLSolver::HEADER_SIZE;
+
+/** Number of conflicts in the unit of the Luby restart sequence */
+static const unsigned RESTART_BASE = 100;
+static const double VAR_DECAY = 0.95;
+static const unsigned FIRST_REDUCE = 2000;
+static const unsigned REDUCE_INCREMENT = 300;
+
+CDCLSolver::CDCLSolver(const Shell::Options& opts, bool generateProofs)
+: _generateProofs(generateProofs), _status(SATISFIABLE), _unsat(false), _varCnt(0),
+  _varIncrement(1), _propagated(0), _wasted(0), _nextReduce(FIRST_REDUCE),
+  _reduceInterval(FIRST_REDUCE), _simplifiedTrail(0), _levelStamp(0), _nodeStamp(0),
+  _refutationPremises(0), _refutationPremisesValid(false),
+  _refutation(new(0) SATClause(0)), _refutationInference(new PropInference(SATClauseList::empty())),
+  _addedClauses(0), _conflicts(0)
+{
+  CALL("CDCLSolver::CDCLSolver");
+
+  _refutation->setInference(_refutationInference);
+
+  // variable zero is not used
+  _values.push(0);
+  _values.push(0);
+  _watches.push(Stack<Watch>());
+  _watches.push(Stack<Watch>());
+  _levels.push(0);
+  _reasons.push(NO_CLAUSE);
+  _phases.push(0);
+  _seen.push(0);
+  _activities.push(0);
+  _heapPositions.push(-1);
+  _unitNodes.push(NO_NODE);
+  _levelStamps.push(0);
+}
+
+void CDCLSolver::ensureVarCount(unsigned newVarCnt)
+{
+  CALL("CDCLSolver::ensureVarCount");
+
+  while(_varCnt<newVarCnt) {
+    newVar();
+  }
+}
+
+unsigned CDCLSolver::newVar()
+{
+  CALL("CDCLSolver::newVar");
+
+  unsigned var = ++_varCnt;
+  _values.push(0);
+  _values.push(0);
+  _watches.push(Stack<Watch>());
+  _watches.push(Stack<Watch>());
+  _levels.push(0);
+  _reasons.push(NO_CLAUSE);
+  _phases.push(0);
+  _seen.push(0);
+  _activities.push(0);
+  _heapPositions.push(-1);
+  _unitNodes.push(NO_NODE);
+  _levelStamps.push(0);
+  heapInsert(var);
+  return var;
+}
+
+void CDCLSolver::suggestPolarity(unsigned var, unsigned pol)
+{
+  CALL("CDCLSolver::suggestPolarity");
+  ASS_G(var,0); ASS_LE(var,_varCnt);
+
+  _phases[var] = pol ? 1 : 0;
+}
+
+void CDCLSolver::addAssumption(SATLiteral lit)
+{
+  CALL("CDCLSolver::addAssumption");
+  ASS_LE(lit.var(),_varCnt);
+
+  _assumptions.push(lit.content());
+}
+
+void CDCLSolver::retractAllAssumptions()
+{
+  CALL("CDCLSolver::retractAllAssumptions");
+
+  _assumptions.reset();
+  _status = UNKNOWN;
+}
+
+/**
+ * Add clause into the solver. Can be called only when there are no
+ * assumptions. Each variable may occur in the clause at most once.
+ */
+void CDCLSolver::addClause(SATClause* cl)
+{
+  CALL("CDCLSolver::addClause");
+  ASS(_assumptions.isEmpty());
+
+  if(!_generateProofs) {
+    SATClauseList::push(cl,_addedClauses);
+  }
+  if(_unsat) {
+    return;
+  }
+  backtrack(0);
+
+  static Stack<Lit> lits;
+  lits.reset();
+  _premises.reset();
+  unsigned clen = cl->length();
+  for(unsigned i=0;i<clen;i++) {
+    Lit l = (*cl)[i].content();
+    ASS_LE(lit2var(l),_varCnt);
+    int val = value(l);
+    if(val>0) {
+      // satisfied at level zero
+      return;
+    }
+    if(val<0) {
+      if(_generateProofs) {
+        _premises.push(_unitNodes[lit2var(l)]);
+      }
+      continue;
+    }
+    lits.push(l);
+  }
+  unsigned node = _generateProofs ? addProofNode(cl, _premises) : NO_NODE;
+
+  if(lits.isEmpty()) {
+    _unsat = true;
+    _topLevelRoots.reset();
+    _topLevelRoots.push(node);
+    return;
+  }
+  if(lits.size()==1) {
+    assign(lits[0], NO_CLAUSE);
+    _unitNodes[lit2var(lits[0])] = node;
+    ClauseRef confl = propagate();
+    if(confl!=NO_CLAUSE) {
+      handleTopLevelConflict(confl);
+    }
+    return;
+  }
+  ClauseRef cr = allocClause(lits, false, 0, node);
+  _inputClauses.push(cr);
+  attachClause(cr);
+}
+
+CDCLSolver::ClauseRef CDCLSolver::allocClause(const Stack<Lit>& lits, bool learnt, unsigned lbd, unsigned node)
+{
+  CALL("CDCLSolver::allocClause");
+  ASS_GE(lits.size(),2);
+
+  ClauseRef cr = _arena.size();
+  _arena.push(lits.size());
+  _arena.push((lbd<<FLAG_BITS) | (learnt ? LEARNT : 0));
+  _arena.push(node);
+  for(unsigned i=0;i<lits.size();i++) {
+    _arena.push(lits[i]);
+  }
+  return cr;
+}
+
+void CDCLSolver::attachClause(ClauseRef cr)
+{
+  Lit* lits = clauseLits(cr);
+  _watches[lits[0]].push(Watch(cr, lits[1]));
+  _watches[lits[1]].push(Watch(cr, lits[0]));
+}
+
+/**
+ * Return true if the clause is the reason of an assignment
+ */
+bool CDCLSolver::isLocked(ClauseRef cr)
+{
+  Lit l = clauseLits(cr)[0];
+  return value(l)>0 && _reasons[lit2var(l)]==cr;
+}
+
+/**
+ * Mark the clause as deleted. Its watches are removed by collectGarbage().
+ */
+void CDCLSolver::deleteClause(ClauseRef cr)
+{
+  ASS(!(clauseFlags(cr)&DELETED));
+
+  clauseFlags(cr) |= DELETED;
+  _wasted += HEADER_SIZE+clauseSize(cr);
+}
+
+/**
+ * Make @c l true. The reason must have @c l as its first literal.
+ *
+ * Reasons are not kept at level zero, so that no clause is locked by
+ * an assignment that is never undone. With proofs, a level zero
+ * assignment by a clause instead gets a proof node of its own.
+ */
+void CDCLSolver::assign(Lit l, ClauseRef reason)
+{
+  ASS_EQ(value(l),0);
+
+  unsigned var = lit2var(l);
+  _values[l] = 1;
+  _values[l^1] = -1;
+  _levels[var] = decisionLevel();
+  _trail.push(l);
+  if(decisionLevel()) {
+    _reasons[var] = reason;
+    return;
+  }
+  _reasons[var] = NO_CLAUSE;
+  if(_generateProofs && reason!=NO_CLAUSE) {
+    static Stack<unsigned> premises;
+    premises.reset();
+    premises.push(clauseNode(reason));
+    addUnitPremises(reason, 1, premises);
+    _unitNodes[var] = addProofNode(0, premises);
+  }
+}
+
+/**
+ * Propagate the assignments on the trail and return a falsified
+ * clause, or NO_CLAUSE if there is none
+ */
+CDCLSolver::ClauseRef CDCLSolver::propagate()
+{
+  CALL("CDCLSolver::propagate");
+
+  ClauseRef confl = NO_CLAUSE;
+  while(_propagated<_trail.size()) {
+    Lit falseLit = _trail[_propagated++]^1;
+    Stack<Watch>& ws = _watches[falseLit];
+
+    Watch* i = ws.begin();
+    Watch* j = i;
+    Watch* end = ws.end();
+    while(i!=end) {
+      if(value(i->blocker)>0) {
+        *j++ = *i++;
+        continue;
+      }
+      ClauseRef cr = i->cref;
+      Lit* lits = clauseLits(cr);
+      if(lits[0]==falseLit) {
+        lits[0] = lits[1];
+        lits[1] = falseLit;
+      }
+      ASS_EQ(lits[1],falseLit);
+      i++;
+
+      Watch w(cr, lits[0]);
+      if(value(lits[0])>0) {
+        *j++ = w;
+        continue;
+      }
+
+      unsigned size = clauseSize(cr);
+      bool moved = false;
+      for(unsigned k=2;k<size;k++) {
+        if(value(lits[k])>=0) {
+          lits[1] = lits[k];
+          lits[k] = falseLit;
+          _watches[lits[1]].push(w);
+          moved = true;
+          break;
+        }
+      }
+      if(moved) {
+        continue;
+      }
+
+      *j++ = w;
+      if(value(lits[0])<0) {
+        confl = cr;
+        _propagated = _trail.size();
+        while(i!=end) {
+          *j++ = *i++;
+        }
+      }
+      else {
+        assign(lits[0], cr);
+      }
+    }
+    ws.truncate(j-ws.begin());
+    if(confl!=NO_CLAUSE) {
+      break;
+    }
+  }
+  return confl;
+}
+
+void CDCLSolver::backtrack(unsigned level)
+{
+  CALL("CDCLSolver::backtrack");
+
+  if(decisionLevel()<=level) {
+    return;
+  }
+  unsigned limit = _trailLimits[level];
+  for(unsigned i=_trail.size();i>limit;) {
+    Lit l = _trail[--i];
+    unsigned var = lit2var(l);
+    _values[l] = 0;
+    _values[l^1] = 0;
+    _phases[var] = l&1;
+    _reasons[var] = NO_CLAUSE;
+    if(_heapPositions[var]<0) {
+      heapInsert(var);
+    }
+  }
+  _trail.truncate(limit);
+  _trailLimits.truncate(level);
+  _propagated = limit;
+}
+
+SATSolver::Status CDCLSolver::solveUnderAssumptions(const SATLiteralStack& assumps, unsigned conflictCountLimit, bool)
+{
+  CALL("CDCLSolver::solveUnderAssumptions");
+  ASS(!hasAssumptions());
+
+  for(unsigned i=0;i<assumps.size();i++) {
+    addAssumption(assumps[i]);
+  }
+  Status res = solve(conflictCountLimit);
+  _assumptions.reset();
+  if(res==UNSATISFIABLE) {
+    _failedAssumptionBuffer = _failedAssumptions;
+  }
+  return res;
+}
+
+/**
+ * Solve under the current assumptions. At most @c conflictCountLimit
+ * conflicts are encountered, UINT_MAX stands for no limit.
+ */
+SATSolver::Status CDCLSolver::solve(unsigned conflictCountLimit)
+{
+  CALL("CDCLSolver::solve");
+
+  _failedAssumptions.reset();
+  if(_unsat) {
+    setRefutation(_topLevelRoots);
+    _status = UNSATISFIABLE;
+    return _status;
+  }
+
+  backtrack(0);
+  ClauseRef confl = propagate();
+  if(confl!=NO_CLAUSE) {
+    handleTopLevelConflict(confl);
+    _status = UNSATISFIABLE;
+    return _status;
+  }
+  if(_trail.size()!=_simplifiedTrail) {
+    simplify();
+  }
+
+  unsigned long budgetEnd = conflictCountLimit==UINT_MAX ? ULONG_MAX : _conflicts+conflictCountLimit;
+  Status res = UNKNOWN;
+  for(unsigned restarts=0;res==UNKNOWN && _conflicts<=budgetEnd;restarts++) {
+    backtrack(0);
+    unsigned long restartEnd = _conflicts+luby(restarts)*RESTART_BASE;
+    res = search(std::min(restartEnd, budgetEnd));
+    if(res==UNKNOWN && _conflicts>=budgetEnd) {
+      break;
+    }
+  }
+
+  if(res==SATISFIABLE) {
+    _model.reset();
+    _model.push(0);
+    for(unsigned var=1;var<=_varCnt;var++) {
+      _model.push(value(var2lit(var, true)));
+    }
+  }
+  backtrack(0);
+  _status = res;
+  return res;
+}
+
+/**
+ * Search for a model until the conflict count reaches @c conflictLimit
+ */
+SATSolver::Status CDCLSolver::search(unsigned long conflictLimit)
+{
+  CALL("CDCLSolver::search");
+
+  for(;;) {
+    ClauseRef confl = propagate();
+    if(confl!=NO_CLAUSE) {
+      _conflicts++;
+      if(!decisionLevel()) {
+        handleTopLevelConflict(confl);
+        return UNSATISFIABLE;
+      }
+      learn(confl);
+      continue;
+    }
+
+    if(_conflicts>=_nextReduce) {
+      _reduceInterval += REDUCE_INCREMENT;
+      _nextReduce = _conflicts+_reduceInterval;
+      reduceLearnts();
+    }
+
+    Lit next = NO_LIT;
+    while(decisionLevel()<_assumptions.size()) {
+      Lit a = _assumptions[decisionLevel()];
+      int val = value(a);
+      if(val>0) {
+        // a dummy level keeps the levels of the assumptions aligned
+        _trailLimits.push(_trail.size());
+      }
+      else if(val<0) {
+        analyzeFinal(a);
+        return UNSATISFIABLE;
+      }
+      else {
+        next = a;
+        break;
+      }
+    }
+    if(next==NO_LIT) {
+      // the assumptions are decided even when the limit is reached, so
+      // that propagation alone can refute them
+      if(_conflicts>=conflictLimit) {
+        return UNKNOWN;
+      }
+      next = pickBranchLiteral();
+      if(next==NO_LIT) {
+        return SATISFIABLE;
+      }
+    }
+    _trailLimits.push(_trail.size());
+    assign(next, NO_CLAUSE);
+  }
+}
+
+/**
+ * Learn a clause from the conflict, backjump and assert it
+ */
+void CDCLSolver::learn(ClauseRef confl)
+{
+  CALL("CDCLSolver::learn");
+
+  unsigned btLevel;
+  unsigned lbd;
+  analyze(confl, btLevel, lbd);
+  backtrack(btLevel);
+
+  unsigned node = _generateProofs ? addProofNode(0, _premises) : NO_NODE;
+  if(_learnt.size()==1) {
+    ASS_EQ(btLevel,0);
+    assign(_learnt[0], NO_CLAUSE);
+    _unitNodes[lit2var(_learnt[0])] = node;
+  }
+  else {
+    ClauseRef cr = allocClause(_learnt, true, lbd, node);
+    _learntClauses.push(cr);
+    attachClause(cr);
+    assign(_learnt[0], cr);
+  }
+  _varIncrement /= VAR_DECAY;
+}
+
+/**
+ * Derive the first UIP clause of the conflict into _learnt, with the
+ * asserting literal first and a literal of the backjump level second.
+ * With proofs, the proof nodes it was derived from are put into _premises.
+ */
+void CDCLSolver::analyze(ClauseRef confl, unsigned& backtrackLevel, unsigned& lbd)
+{
+  CALL("CDCLSolver::analyze");
+
+  _learnt.reset();
+  _learnt.push(NO_LIT);
+  _premises.reset();
+
+  unsigned pathCnt = 0;
+  Lit p = NO_LIT;
+  unsigned index = _trail.size();
+  ClauseRef cr = confl;
+  for(;;) {
+    ASS_NEQ(cr,NO_CLAUSE);
+    if(_generateProofs) {
+      _premises.push(clauseNode(cr));
+    }
+    if(clauseFlags(cr)&LEARNT) {
+      clauseFlags(cr) |= USED;
+    }
+    Lit* lits = clauseLits(cr);
+    unsigned size = clauseSize(cr);
+    ASS(p==NO_LIT || lits[0]==p);
+    for(unsigned j=(p==NO_LIT) ? 0 : 1;j<size;j++) {
+      Lit q = lits[j];
+      unsigned var = lit2var(q);
+      if(_seen[var]) {
+        continue;
+      }
+      if(!_levels[var]) {
+        if(_generateProofs) {
+          _premises.push(_unitNodes[var]);
+        }
+        continue;
+      }
+      _seen[var] = 1;
+      bumpVariable(var);
+      if(_levels[var]>=decisionLevel()) {
+        pathCnt++;
+      }
+      else {
+        _learnt.push(q);
+      }
+    }
+    do {
+      p = _trail[--index];
+    } while(!_seen[lit2var(p)]);
+    _seen[lit2var(p)] = 0;
+    pathCnt--;
+    if(!pathCnt) {
+      break;
+    }
+    cr = _reasons[lit2var(p)];
+  }
+  _learnt[0] = p^1;
+
+  // remove literals implied by the others
+  _toClear = _learnt;
+  unsigned levels = 0;
+  for(unsigned i=1;i<_learnt.size();i++) {
+    levels |= 1u<<(_levels[lit2var(_learnt[i])]&31);
+  }
+  unsigned j = 1;
+  for(unsigned i=1;i<_learnt.size();i++) {
+    Lit l = _learnt[i];
+    if(_reasons[lit2var(l)]==NO_CLAUSE || !isRedundant(l, levels)) {
+      _learnt[j++] = l;
+    }
+  }
+  _learnt.truncate(j);
+  for(unsigned i=0;i<_toClear.size();i++) {
+    _seen[lit2var(_toClear[i])] = 0;
+  }
+
+  backtrackLevel = 0;
+  if(_learnt.size()>1) {
+    unsigned maxIdx = 1;
+    for(unsigned i=2;i<_learnt.size();i++) {
+      if(_levels[lit2var(_learnt[i])]>_levels[lit2var(_learnt[maxIdx])]) {
+        maxIdx = i;
+      }
+    }
+    std::swap(_learnt[1], _learnt[maxIdx]);
+    backtrackLevel = _levels[lit2var(_learnt[1])];
+  }
+
+  while(_levelStamps.size()<=decisionLevel()) {
+    _levelStamps.push(0);
+  }
+  _levelStamp++;
+  lbd = 0;
+  for(unsigned i=0;i<_learnt.size();i++) {
+    unsigned level = _levels[lit2var(_learnt[i])];
+    if(_levelStamps[level]!=_levelStamp) {
+      _levelStamps[level] = _levelStamp;
+      lbd++;
+    }
+  }
+}
+
+/**
+ * Return true if the false literal @c l of the learnt clause is implied by
+ * the other literals of the clause. @c levels is an abstraction of the
+ * decision levels of the literals of the clause.
+ */
+bool CDCLSolver::isRedundant(Lit l, unsigned levels)
+{
+  CALL("CDCLSolver::isRedundant");
+
+  _redundancyStack.reset();
+  _redundancyStack.push(l);
+  unsigned clearTop = _toClear.size();
+  unsigned premiseTop = _premises.size();
+  while(_redundancyStack.isNonEmpty()) {
+    ClauseRef cr = _reasons[lit2var(_redundancyStack.pop())];
+    ASS_NEQ(cr,NO_CLAUSE);
+    if(_generateProofs) {
+      _premises.push(clauseNode(cr));
+    }
+    Lit* lits = clauseLits(cr);
+    unsigned size = clauseSize(cr);
+    for(unsigned j=1;j<size;j++) {
+      Lit q = lits[j];
+      unsigned var = lit2var(q);
+      if(_seen[var]) {
+        continue;
+      }
+      if(!_levels[var]) {
+        if(_generateProofs) {
+          _premises.push(_unitNodes[var]);
+        }
+        continue;
+      }
+      if(_reasons[var]!=NO_CLAUSE && (levels & (1u<<(_levels[var]&31)))) {
+        _seen[var] = 1;
+        _redundancyStack.push(q);
+        _toClear.push(q);
+        continue;
+      }
+      for(unsigned k=clearTop;k<_toClear.size();k++) {
+        _seen[lit2var(_toClear[k])] = 0;
+      }
+      _toClear.truncate(clearTop);
+      _premises.truncate(premiseTop);
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Put into _failedAssumptions the assumptions that imply the
+ * negation of the assumption @c failed, together with @c failed itself
+ */
+void CDCLSolver::analyzeFinal(Lit failed)
+{
+  CALL("CDCLSolver::analyzeFinal");
+  ASS_L(value(failed),0);
+
+  _failedAssumptions.reset();
+  _failedAssumptions.push(SATLiteral(failed));
+  _premises.reset();
+
+  unsigned failedVar = lit2var(failed);
+  if(!_levels[failedVar]) {
+    if(_generateProofs) {
+      _premises.push(_unitNodes[failedVar]);
+    }
+    setRefutation(_premises);
+    return;
+  }
+
+  _seen[failedVar] = 1;
+  for(unsigned i=_trail.size();i>_trailLimits[0];) {
+    Lit l = _trail[--i];
+    unsigned var = lit2var(l);
+    if(!_seen[var]) {
+      continue;
+    }
+    _seen[var] = 0;
+    ClauseRef cr = _reasons[var];
+    if(cr==NO_CLAUSE) {
+      // decisions below the level of the failed assumption are assumptions
+      _failedAssumptions.push(SATLiteral(l));
+      continue;
+    }
+    if(_generateProofs) {
+      _premises.push(clauseNode(cr));
+    }
+    Lit* lits = clauseLits(cr);
+    unsigned size = clauseSize(cr);
+    for(unsigned j=1;j<size;j++) {
+      unsigned qvar = lit2var(lits[j]);
+      if(_levels[qvar]) {
+        _seen[qvar] = 1;
+      }
+      else if(_generateProofs) {
+        _premises.push(_unitNodes[qvar]);
+      }
+    }
+  }
+  setRefutation(_premises);
+}
+
+/**
+ * The clauses are unsatisfiable regardless of the assumptions
+ */
+void CDCLSolver::handleTopLevelConflict(ClauseRef confl)
+{
+  CALL("CDCLSolver::handleTopLevelConflict");
+
+  _unsat = true;
+  _failedAssumptions.reset();
+  _topLevelRoots.reset();
+  if(_generateProofs) {
+    _topLevelRoots.push(clauseNode(confl));
+    addUnitPremises(confl, 0, _topLevelRoots);
+  }
+  setRefutation(_topLevelRoots);
+}
+
+CDCLSolver::Lit CDCLSolver::pickBranchLiteral()
+{
+  CALL("CDCLSolver::pickBranchLiteral");
+
+  while(_heap.isNonEmpty()) {
+    unsigned var = heapPop();
+    if(!value(var2lit(var, true))) {
+      return var2lit(var, _phases[var]);
+    }
+  }
+  return NO_LIT;
+}
+
+void CDCLSolver::bumpVariable(unsigned var)
+{
+  _activities[var] += _varIncrement;
+  if(_activities[var]>1e100) {
+    for(unsigned v=1;v<=_varCnt;v++) {
+      _activities[v] *= 1e-100;
+    }
+    _varIncrement *= 1e-100;
+  }
+  if(_heapPositions[var]>=0) {
+    heapUp(_heapPositions[var]);
+  }
+}
+
+void CDCLSolver::heapInsert(unsigned var)
+{
+  ASS_L(_heapPositions[var],0);
+
+  _heapPositions[var] = _heap.size();
+  _heap.push(var);
+  heapUp(_heap.size()-1);
+}
+
+unsigned CDCLSolver::heapPop()
+{
+  ASS(_heap.isNonEmpty());
+
+  unsigned top = _heap[0];
+  unsigned last = _heap.pop();
+  _heapPositions[top] = -1;
+  if(_heap.isNonEmpty()) {
+    _heap[0] = last;
+    _heapPositions[last] = 0;
+    heapDown(0);
+  }
+  return top;
+}
+
+void CDCLSolver::heapUp(unsigned pos)
+{
+  unsigned var = _heap[pos];
+  double act = _activities[var];
+  while(pos) {
+    unsigned parent = (pos-1)>>1;
+    if(_activities[_heap[parent]]>=act) {
+      break;
+    }
+    _heap[pos] = _heap[parent];
+    _heapPositions[_heap[pos]] = pos;
+    pos = parent;
+  }
+  _heap[pos] = var;
+  _heapPositions[var] = pos;
+}
+
+void CDCLSolver::heapDown(unsigned pos)
+{
+  unsigned var = _heap[pos];
+  double act = _activities[var];
+  unsigned size = _heap.size();
+  for(;;) {
+    unsigned child = 2*pos+1;
+    if(child>=size) {
+      break;
+    }
+    if(child+1<size && _activities[_heap[child+1]]>_activities[_heap[child]]) {
+      child++;
+    }
+    if(_activities[_heap[child]]<=act) {
+      break;
+    }
+    _heap[pos] = _heap[child];
+    _heapPositions[_heap[pos]] = pos;
+    pos = child;
+  }
+  _heap[pos] = var;
+  _heapPositions[var] = pos;
+}
+
+/**
+ * Delete about half of the learnt clauses that are neither glue clauses
+ * (LBD at most two), reasons, nor used in a conflict since the last reduction.
+ * The ones with the largest LBD go first.
+ */
+void CDCLSolver::reduceLearnts()
+{
+  CALL("CDCLSolver::reduceLearnts");
+
+  static Stack<ClauseRef> candidates;
+  candidates.reset();
+  unsigned j = 0;
+  for(unsigned i=0;i<_learntClauses.size();i++) {
+    ClauseRef cr = _learntClauses[i];
+    unsigned& flags = clauseFlags(cr);
+    if(clauseLbd(cr)<=2 || isLocked(cr) || (flags&USED)) {
+      flags &= ~USED;
+      _learntClauses[j++] = cr;
+      continue;
+    }
+    candidates.push(cr);
+  }
+  _learntClauses.truncate(j);
+
+  std::sort(candidates.begin(), candidates.end(), [this](ClauseRef a, ClauseRef b) {
+    if(clauseLbd(a)!=clauseLbd(b)) {
+      return clauseLbd(a)>clauseLbd(b);
+    }
+    return clauseSize(a)>clauseSize(b);
+  });
+  unsigned half = candidates.size()/2;
+  for(unsigned i=0;i<candidates.size();i++) {
+    if(i<half) {
+      deleteClause(candidates[i]);
+    }
+    else {
+      _learntClauses.push(candidates[i]);
+    }
+  }
+  collectGarbage();
+}
+
+/**
+ * Delete clauses satisfied at level zero. To be called at level zero.
+ */
+void CDCLSolver::removeSatisfied(Stack<ClauseRef>& clauses)
+{
+  CALL("CDCLSolver::removeSatisfied");
+  ASS_EQ(decisionLevel(),0);
+
+  unsigned j = 0;
+  for(unsigned i=0;i<clauses.size();i++) {
+    ClauseRef cr = clauses[i];
+    Lit* lits = clauseLits(cr);
+    unsigned size = clauseSize(cr);
+    bool satisfied = false;
+    for(unsigned k=0;k<size;k++) {
+      if(value(lits[k])>0) {
+        satisfied = true;
+        break;
+      }
+    }
+    if(satisfied) {
+      deleteClause(cr);
+    }
+    else {
+      clauses[j++] = cr;
+    }
+  }
+  clauses.truncate(j);
+}
+
+/**
+ * Remove the watches of the deleted clauses and, if the deleted clauses
+ * take more than half of the arena, compact it
+ */
+void CDCLSolver::collectGarbage()
+{
+  CALL("CDCLSolver::collectGarbage");
+
+  if(!_wasted) {
+    return;
+  }
+  if(2*_wasted<=_arena.size()) {
+    for(unsigned l=0;l<_watches.size();l++) {
+      Stack<Watch>& ws = _watches[l];
+      unsigned j = 0;
+      for(unsigned i=0;i<ws.size();i++) {
+        if(!(clauseFlags(ws[i].cref)&DELETED)) {
+          ws[j++] = ws[i];
+        }
+      }
+      ws.truncate(j);
+    }
+    return;
+  }
+
+  static Stack<unsigned> newArena;
+  newArena.reset();
+  Stack<ClauseRef>* lists[] = { &_inputClauses, &_learntClauses };
+  for(unsigned li=0;li<2;li++) {
+    Stack<ClauseRef>& clauses = *lists[li];
+    for(unsigned i=0;i<clauses.size();i++) {
+      ClauseRef cr = clauses[i];
+      ClauseRef newCr = newArena.size();
+      unsigned end = cr+HEADER_SIZE+clauseSize(cr);
+      for(unsigned k=cr;k<end;k++) {
+        newArena.push(_arena[k]);
+      }
+      // the size of the old clause is replaced by its new position
+      _arena[cr] = newCr;
+      clauses[i] = newCr;
+    }
+  }
+  for(unsigned i=0;i<_trail.size();i++) {
+    unsigned var = lit2var(_trail[i]);
+    if(_reasons[var]!=NO_CLAUSE) {
+      _reasons[var] = _arena[_reasons[var]];
+    }
+  }
+  std::swap(_arena, newArena);
+  _wasted = 0;
+
+  for(unsigned l=0;l<_watches.size();l++) {
+    _watches[l].reset();
+  }
+  for(unsigned li=0;li<2;li++) {
+    Stack<ClauseRef>& clauses = *lists[li];
+    for(unsigned i=0;i<clauses.size();i++) {
+      attachClause(clauses[i]);
+    }
+  }
+}
+
+/**
+ * Delete the clauses satisfied at level zero
+ */
+void CDCLSolver::simplify()
+{
+  CALL("CDCLSolver::simplify");
+  ASS(!hasAssumptions() || decisionLevel()==0);
+
+  if(_unsat) {
+    return;
+  }
+  backtrack(0);
+  ClauseRef confl = propagate();
+  if(confl!=NO_CLAUSE) {
+    handleTopLevelConflict(confl);
+    return;
+  }
+  removeSatisfied(_inputClauses);
+  removeSatisfied(_learntClauses);
+  collectGarbage();
+  _simplifiedTrail = _trail.size();
+}
+
+SATSolver::VarAssignment CDCLSolver::getAssignment(unsigned var)
+{
+  CALL("CDCLSolver::getAssignment");
+  ASS_EQ(_status,SATISFIABLE);
+  ASS_G(var,0); ASS_LE(var,_varCnt);
+
+  if(var>=_model.size()) {
+    // new vars have been added but the model didn't grow yet
+    return DONT_CARE;
+  }
+  return _model[var]>0 ? TRUE : FALSE;
+}
+
+bool CDCLSolver::isZeroImplied(unsigned var)
+{
+  CALL("CDCLSolver::isZeroImplied");
+  ASS_G(var,0); ASS_LE(var,_varCnt);
+
+  return value(var2lit(var, true)) && !_levels[var];
+}
+
+void CDCLSolver::collectZeroImplied(SATLiteralStack& acc)
+{
+  CALL("CDCLSolver::collectZeroImplied");
+
+  unsigned end = decisionLevel() ? _trailLimits[0] : _trail.size();
+  for(unsigned i=0;i<end;i++) {
+    acc.push(SATLiteral(_trail[i]));
+  }
+}
+
+/**
+ * Push into @c premises the proof nodes of the level zero assignments
+ * that falsify the literals of the clause from the @c first one on
+ */
+void CDCLSolver::addUnitPremises(ClauseRef cr, unsigned first, Stack<unsigned>& premises)
+{
+  Lit* lits = clauseLits(cr);
+  unsigned size = clauseSize(cr);
+  for(unsigned j=first;j<size;j++) {
+    ASS_L(value(lits[j]),0);
+    ASS_EQ(_levels[lit2var(lits[j])],0);
+    premises.push(_unitNodes[lit2var(lits[j])]);
+  }
+}
+
+/**
+ * Add a proof node of the input clause @c input, or of a clause derived
+ * from the proof nodes in @c premises. The order of @c premises is not kept.
+ */
+unsigned CDCLSolver::addProofNode(SATClause* input, Stack<unsigned>& premises)
+{
+  CALL("CDCLSolver::addProofNode");
+
+  ProofNode node;
+  node.input = input;
+  node.firstPremise = _proofPremises.size();
+  sort<DefaultComparator>(premises.begin(), premises.end());
+  for(unsigned i=0;i<premises.size();i++) {
+    if(i && premises[i]==premises[i-1]) {
+      continue;
+    }
+    ASS_NEQ(premises[i],NO_NODE);
+    _proofPremises.push(premises[i]);
+  }
+  node.premiseCnt = _proofPremises.size()-node.firstPremise;
+  _proofNodes.push(node);
+  _nodeStamps.push(0);
+  return _proofNodes.size()-1;
+}
+
+void CDCLSolver::setRefutation(Stack<unsigned>& roots)
+{
+  _refutationRoots = roots;
+  _refutationPremisesValid = false;
+}
+
+/**
+ * Return the input clauses the last refutation was derived from. Without
+ * proofs, these are all the clauses added so far.
+ */
+SATClauseList* CDCLSolver::getRefutationPremiseList()
+{
+  CALL("CDCLSolver::getRefutationPremiseList");
+
+  if(!_generateProofs) {
+    return _addedClauses;
+  }
+  if(_refutationPremisesValid) {
+    return _refutationPremises;
+  }
+
+  // the list is not destroyed, it may be kept by the inferences of earlier refutations
+  _refutationPremises = 0;
+  _nodeStamp++;
+  static Stack<unsigned> todo;
+  todo = _refutationRoots;
+  while(todo.isNonEmpty()) {
+    unsigned n = todo.pop();
+    if(_nodeStamps[n]==_nodeStamp) {
+      continue;
+    }
+    _nodeStamps[n] = _nodeStamp;
+    const ProofNode& node = _proofNodes[n];
+    if(node.input) {
+      SATClauseList::push(node.input, _refutationPremises);
+    }
+    for(unsigned i=0;i<node.premiseCnt;i++) {
+      todo.push(_proofPremises[node.firstPremise+i]);
+    }
+  }
+  _refutationPremisesValid = true;
+  return _refutationPremises;
+}
+
+SATClause* CDCLSolver::getRefutation()
+{
+  CALL("CDCLSolver::getRefutation");
+
+  _refutationInference->setPremises(getRefutationPremiseList());
+  return _refutation;
+}
+
+/**
+ * The @c i-th element of the Luby sequence 1,1,2,1,1,2,4,1,...
+ */
+unsigned CDCLSolver::luby(unsigned i)
+{
+  unsigned size = 1;
+  unsigned seq = 0;
+  while(size<i+1) {
+    seq++;
+    size = 2*size+1;
+  }
+  while(size-1!=i) {
+    size = (size-1)>>1;
+    seq--;
+    i = i%size;
+  }
+  return 1u<<seq;
+}
+
+}
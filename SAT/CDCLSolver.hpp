@@ -0,0 +1,242 @@
+/*
+ * File CDCLSolver.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file CDCLSolver.hpp
+ * Defines class CDCLSolver.
+ */
+
+#ifndef __CDCLSolver__
+#define __CDCLSolver__
+
+#include "Forwards.hpp"
+
+#include "Lib/Stack.hpp"
+
+#include "SATSolver.hpp"
+#include "SATLiteral.hpp"
+#include "SATClause.hpp"
+
+namespace SAT {
+
+using namespace Lib;
+
+/**
+ * An incremental CDCL solver with native support of assumptions
+ *
+ * Clauses are kept in a single arena and watched by two literals with
+ * blocking literals. Decisions follow VSIDS with phase saving, restarts
+ * follow the Luby sequence and learnt clauses are reduced by their LBD.
+ * Assumptions are decided first, one per decision level, so that a failed
+ * assumption is explained by the assumptions it was implied by.
+ *
+ * If proofs are generated, every clause has a node recording the input
+ * clause or the clauses it was derived from. The premises of a refutation
+ * are then only the input clauses actually used to derive it, rather than
+ * all the clauses added so far.
+ */
+class CDCLSolver : public SATSolverWithAssumptions
+{
+public:
+  CLASS_NAME(CDCLSolver);
+  USE_ALLOCATOR(CDCLSolver);
+
+  CDCLSolver(const Shell::Options& opts, bool generateProofs=false);
+
+  virtual void addClause(SATClause* cl) override;
+  virtual void simplify() override;
+  virtual Status solve(unsigned conflictCountLimit) override;
+
+  virtual VarAssignment getAssignment(unsigned var) override;
+  virtual bool isZeroImplied(unsigned var) override;
+  virtual void collectZeroImplied(SATLiteralStack& acc) override;
+  /** Not supported, as in MinisatInterfacing */
+  virtual SATClause* getZeroImpliedCertificate(unsigned var) override { return 0; }
+
+  virtual void ensureVarCount(unsigned newVarCnt) override;
+  virtual unsigned newVar() override;
+  virtual void suggestPolarity(unsigned var, unsigned pol) override;
+
+  virtual void addAssumption(SATLiteral lit) override;
+  virtual void retractAllAssumptions() override;
+  virtual bool hasAssumptions() const override { return _assumptions.isNonEmpty(); }
+
+  virtual Status solveUnderAssumptions(const SATLiteralStack& assumps, unsigned conflictCountLimit, bool) override;
+
+  virtual SATClause* getRefutation() override;
+  virtual SATClauseList* getRefutationPremiseList() override;
+
+  virtual void recordSource(unsigned satlitvar, Literal* lit) override {}
+
+private:
+  /** Literals are represented by the content of SATLiteral, i.e. 2*var+polarity */
+  typedef unsigned Lit;
+  /** Offset of a clause in _arena */
+  typedef unsigned ClauseRef;
+
+  static const ClauseRef NO_CLAUSE = 0xFFFFFFFF;
+  static const Lit NO_LIT = 0xFFFFFFFF;
+  static const unsigned NO_NODE = 0xFFFFFFFF;
+
+  /** A clause in _arena is its size, flags and LBD, proof node and literals */
+  static const unsigned HEADER_SIZE = 3;
+  enum ClauseFlags {
+    LEARNT = 1,
+    DELETED = 2,
+    /** the clause took part in a conflict since the last reduction */
+    USED = 4,
+    FLAG_BITS = 3
+  };
+
+  struct Watch
+  {
+    Watch() {}
+    Watch(ClauseRef cref, Lit blocker) : cref(cref), blocker(blocker) {}
+
+    ClauseRef cref;
+    /** a literal of the clause; if true, the clause need not be visited */
+    Lit blocker;
+  };
+
+  struct ProofNode
+  {
+    /** the input clause, or zero for a derived clause */
+    SATClause* input;
+    unsigned firstPremise;
+    unsigned premiseCnt;
+  };
+
+  static Lit var2lit(unsigned var, bool positive) { return (var<<1)|(positive ? 1 : 0); }
+  static unsigned lit2var(Lit l) { return l>>1; }
+
+  int value(Lit l) const { return _values[l]; }
+  unsigned decisionLevel() const { return _trailLimits.size(); }
+
+  unsigned clauseSize(ClauseRef cr) const { return _arena[cr]; }
+  unsigned& clauseFlags(ClauseRef cr) { return _arena[cr+1]; }
+  unsigned clauseLbd(ClauseRef cr) const { return _arena[cr+1]>>FLAG_BITS; }
+  unsigned clauseNode(ClauseRef cr) const { return _arena[cr+2]; }
+  Lit* clauseLits(ClauseRef cr) { return _arena.begin()+cr+HEADER_SIZE; }
+
+  ClauseRef allocClause(const Stack<Lit>& lits, bool learnt, unsigned lbd, unsigned node);
+  void attachClause(ClauseRef cr);
+  bool isLocked(ClauseRef cr);
+  void deleteClause(ClauseRef cr);
+
+  void assign(Lit l, ClauseRef reason);
+  ClauseRef propagate();
+  void backtrack(unsigned level);
+
+  Status search(unsigned long conflictLimit);
+  void learn(ClauseRef confl);
+  void analyze(ClauseRef confl, unsigned& backtrackLevel, unsigned& lbd);
+  bool isRedundant(Lit l, unsigned levels);
+  void analyzeFinal(Lit failed);
+  void handleTopLevelConflict(ClauseRef confl);
+
+  Lit pickBranchLiteral();
+  void bumpVariable(unsigned var);
+  void heapInsert(unsigned var);
+  unsigned heapPop();
+  void heapUp(unsigned pos);
+  void heapDown(unsigned pos);
+
+  void reduceLearnts();
+  void removeSatisfied(Stack<ClauseRef>& clauses);
+  void collectGarbage();
+
+  unsigned addProofNode(SATClause* input, Stack<unsigned>& premises);
+  void addUnitPremises(ClauseRef cr, unsigned first, Stack<unsigned>& premises);
+  void setRefutation(Stack<unsigned>& roots);
+
+  static unsigned luby(unsigned i);
+
+  bool _generateProofs;
+  Status _status;
+  /** true once the clauses added so far are unsatisfiable without assumptions */
+  bool _unsat;
+
+  unsigned _varCnt;
+  /** indexed by literals */
+  Stack<signed char> _values;
+  Stack<Stack<Watch> > _watches;
+  /** indexed by variables */
+  Stack<unsigned> _levels;
+  Stack<ClauseRef> _reasons;
+  Stack<unsigned char> _phases;
+  Stack<unsigned char> _seen;
+  Stack<double> _activities;
+  Stack<int> _heapPositions;
+  /** proof node of a variable assigned at level zero */
+  Stack<unsigned> _unitNodes;
+
+  Stack<unsigned> _heap;
+  double _varIncrement;
+
+  Stack<Lit> _trail;
+  Stack<unsigned> _trailLimits;
+  unsigned _propagated;
+
+  Stack<unsigned> _arena;
+  /** number of words of deleted clauses in _arena */
+  unsigned _wasted;
+  Stack<ClauseRef> _inputClauses;
+  Stack<ClauseRef> _learntClauses;
+  /** the learnt clauses are reduced when the conflict count reaches this */
+  unsigned long _nextReduce;
+  unsigned _reduceInterval;
+  /** size of the trail at level zero when satisfied clauses were last removed */
+  unsigned _simplifiedTrail;
+
+  Stack<Lit> _assumptions;
+  /**
+   * Assumptions responsible for the last unsatisfiable result. Kept apart
+   * from _failedAssumptionBuffer, which is minimized by repeated calls to solve().
+   */
+  SATLiteralStack _failedAssumptions;
+  Stack<signed char> _model;
+
+  Stack<Lit> _learnt;
+  Stack<Lit> _toClear;
+  Stack<Lit> _redundancyStack;
+  Stack<unsigned> _premises;
+  Stack<unsigned> _levelStamps;
+  unsigned _levelStamp;
+
+  Stack<ProofNode> _proofNodes;
+  Stack<unsigned> _proofPremises;
+  Stack<unsigned> _nodeStamps;
+  unsigned _nodeStamp;
+  /** proof nodes the last refutation was derived from */
+  Stack<unsigned> _refutationRoots;
+  /** proof nodes of the refutation without assumptions, if _unsat */
+  Stack<unsigned> _topLevelRoots;
+  /** premises computed from _refutationRoots, valid if _refutationPremisesValid */
+  SATClauseList* _refutationPremises;
+  bool _refutationPremisesValid;
+  /** empty clause returned by getRefutation, recycled between calls */
+  SATClause* _refutation;
+  PropInference* _refutationInference;
+  /** all clauses added so far, used as premises when proofs are not generated */
+  SATClauseList* _addedClauses;
+
+  unsigned long _conflicts;
+};
+
+}
+
+#endif // __CDCLSolver__
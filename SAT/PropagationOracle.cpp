@@ -0,0 +1,451 @@
+/*
+ * File PropagationOracle.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file PropagationOracle.cpp
+ * Implements class PropagationOracle.
+ */
+
+#include <algorithm>
+
+#include "Debug/Tracer.hpp"
+
+#include "Lib/Random.hpp"
+
+#include "SATInference.hpp"
+
+#include "PropagationOracle.hpp"
+
+namespace SAT
+{
+
+using namespace Lib;
+
+const PropagationOracle::ClauseRef PropagationOracle::NO_CLAUSE;
+const unsigned PropagationOracle::HEADER_SIZE;
+
+PropagationOracle::PropagationOracle()
+: _unsat(false), _varCnt(0), _stamp(0), _levelZero(0), _propagated(0),
+  _refutationPremises(0), _refutationPremisesValid(false),
+  _refutation(new(0) SATClause(0)), _refutationInference(new PropInference(SATClauseList::empty()))
+{
+  CALL("PropagationOracle::PropagationOracle");
+
+  _refutation->setInference(_refutationInference);
+
+  // variable zero is not used
+  _values.push(0);
+  _values.push(0);
+  _watches.push(Stack<Watch>());
+  _watches.push(Stack<Watch>());
+  _reasons.push(0);
+  _stamps.push(0);
+}
+
+void PropagationOracle::ensureVarCount(unsigned newVarCnt)
+{
+  CALL("PropagationOracle::ensureVarCount");
+
+  while(_varCnt<newVarCnt) {
+    newVar();
+  }
+}
+
+unsigned PropagationOracle::newVar()
+{
+  CALL("PropagationOracle::newVar");
+
+  unsigned var = ++_varCnt;
+  _values.push(0);
+  _values.push(0);
+  _watches.push(Stack<Watch>());
+  _watches.push(Stack<Watch>());
+  _reasons.push(0);
+  _stamps.push(0);
+  return var;
+}
+
+void PropagationOracle::addAssumption(SATLiteral lit)
+{
+  CALL("PropagationOracle::addAssumption");
+  ASS_LE(lit.var(),_varCnt);
+
+  _assumptions.push(lit);
+}
+
+void PropagationOracle::retractAllAssumptions()
+{
+  CALL("PropagationOracle::retractAllAssumptions");
+
+  _assumptions.reset();
+}
+
+/**
+ * Add clause into the solver and propagate it at level zero. Can be
+ * called only when there are no assumptions.
+ */
+void PropagationOracle::addClause(SATClause* cl)
+{
+  CALL("PropagationOracle::addClause");
+  ASS(_assumptions.isEmpty());
+  ASS_EQ(_trail.size(),_levelZero);
+
+  if(_unsat) {
+    return;
+  }
+
+  static Stack<Lit> lits;
+  lits.reset();
+  unsigned clen = cl->length();
+  for(unsigned i=0;i<clen;i++) {
+    Lit l = (*cl)[i].content();
+    ASS_LE(lit2var(l),_varCnt);
+    int val = value(l);
+    if(val>0) {
+      // satisfied at level zero
+      return;
+    }
+    if(val<0 || lits.find(l)) {
+      continue;
+    }
+    if(lits.find(l^1)) {
+      // tautology
+      return;
+    }
+    lits.push(l);
+  }
+
+  if(lits.size()>1) {
+    ClauseRef cr = _arena.size();
+    _arena.push(lits.size());
+    _arena.push(_clauses.size());
+    _clauses.push(cl);
+    for(unsigned i=0;i<lits.size();i++) {
+      _arena.push(lits[i]);
+    }
+    _watches[lits[0]].push(Watch(cr, lits[1]));
+    _watches[lits[1]].push(Watch(cr, lits[0]));
+    return;
+  }
+
+  SATClause* confl = cl;
+  if(lits.size()==1) {
+    assign(lits[0], cl);
+    ClauseRef cr = propagate();
+    _levelZero = _trail.size();
+    if(cr==NO_CLAUSE) {
+      return;
+    }
+    confl = clause(cr);
+  }
+  analyze(confl, SATLiteral::dummy());
+  _unsat = true;
+  _topLevelPremises = _premises;
+}
+
+void PropagationOracle::assign(Lit l, SATClause* reason)
+{
+  ASS_EQ(value(l),0);
+
+  _values[l] = 1;
+  _values[l^1] = -1;
+  _reasons[lit2var(l)] = reason;
+  _trail.push(l);
+}
+
+/**
+ * Propagate the literals on the trail and return a conflicting clause,
+ * or NO_CLAUSE if there is none
+ */
+PropagationOracle::ClauseRef PropagationOracle::propagate()
+{
+  CALL("PropagationOracle::propagate");
+
+  while(_propagated<_trail.size()) {
+    Lit falseLit = _trail[_propagated++]^1;
+    Stack<Watch>& ws = _watches[falseLit];
+    unsigned i = 0;
+    unsigned j = 0;
+    unsigned n = ws.size();
+    while(i<n) {
+      Watch w = ws[i++];
+      if(value(w.blocker)>0) {
+        ws[j++] = w;
+        continue;
+      }
+      ClauseRef cr = w.cref;
+      Lit* lits = clauseLits(cr);
+      if(lits[0]==falseLit) {
+        lits[0] = lits[1];
+        lits[1] = falseLit;
+      }
+      ASS_EQ(lits[1],falseLit);
+      Lit first = lits[0];
+      if(first!=w.blocker && value(first)>0) {
+        ws[j++] = Watch(cr, first);
+        continue;
+      }
+
+      unsigned size = clauseSize(cr);
+      bool moved = false;
+      for(unsigned k=2;k<size;k++) {
+        if(value(lits[k])>=0) {
+          lits[1] = lits[k];
+          lits[k] = falseLit;
+          _watches[lits[1]].push(Watch(cr, first));
+          moved = true;
+          break;
+        }
+      }
+      if(moved) {
+        continue;
+      }
+
+      ws[j++] = Watch(cr, first);
+      if(value(first)<0) {
+        while(i<n) {
+          ws[j++] = ws[i++];
+        }
+        ws.truncate(j);
+        _propagated = _trail.size();
+        return cr;
+      }
+      assign(first, clause(cr));
+    }
+    ws.truncate(j);
+  }
+  return NO_CLAUSE;
+}
+
+void PropagationOracle::undoAssumptions()
+{
+  CALL("PropagationOracle::undoAssumptions");
+
+  while(_trail.size()>_levelZero) {
+    Lit l = _trail.pop();
+    _values[l] = 0;
+    _values[l^1] = 0;
+    _reasons[lit2var(l)] = 0;
+  }
+  _propagated = _levelZero;
+}
+
+/**
+ * Collect the assumptions and the clauses the conflict was derived from.
+ * The conflict is either the clause @c confl, all of whose literals are
+ * false, or the assumption @c failed whose negation is true.
+ */
+void PropagationOracle::analyze(SATClause* confl, SATLiteral failed)
+{
+  CALL("PropagationOracle::analyze");
+
+  _failedAssumptionBuffer.reset();
+  _premises.reset();
+  _refutationPremisesValid = false;
+  _stamp++;
+
+  static Stack<unsigned> todo;
+  todo.reset();
+  if(confl) {
+    _premises.push(confl);
+    unsigned clen = confl->length();
+    for(unsigned i=0;i<clen;i++) {
+      todo.push((*confl)[i].var());
+    }
+  }
+  else {
+    _failedAssumptionBuffer.push(failed);
+    todo.push(failed.var());
+  }
+
+  while(todo.isNonEmpty()) {
+    unsigned var = todo.pop();
+    if(_stamps[var]==_stamp) {
+      continue;
+    }
+    _stamps[var] = _stamp;
+    SATClause* reason = _reasons[var];
+    if(!reason) {
+      _failedAssumptionBuffer.push(SATLiteral(var, value(SATLiteral(var,1).content())>0 ? 1 : 0));
+      continue;
+    }
+    _premises.push(reason);
+    unsigned rlen = reason->length();
+    for(unsigned i=0;i<rlen;i++) {
+      unsigned rvar = (*reason)[i].var();
+      if(rvar!=var) {
+        todo.push(rvar);
+      }
+    }
+  }
+}
+
+/**
+ * Propagate the assumptions in turn. If they lead to a conflict, analyze
+ * it and return UNSATISFIABLE, otherwise return UNKNOWN. The assignments
+ * of the assumptions are undone before returning.
+ */
+SATSolver::Status PropagationOracle::propagateAssumptions(const SATLiteralStack& assumps)
+{
+  CALL("PropagationOracle::propagateAssumptions");
+  ASS_EQ(_trail.size(),_levelZero);
+
+  if(_unsat) {
+    _failedAssumptionBuffer.reset();
+    _premises = _topLevelPremises;
+    _refutationPremisesValid = false;
+    return UNSATISFIABLE;
+  }
+
+  Status res = UNKNOWN;
+  for(unsigned i=0;i<assumps.size();i++) {
+    Lit a = assumps[i].content();
+    ASS_LE(lit2var(a),_varCnt);
+    int val = value(a);
+    if(val>0) {
+      continue;
+    }
+    if(val<0) {
+      analyze(0, assumps[i]);
+      res = UNSATISFIABLE;
+      break;
+    }
+    assign(a, 0);
+    ClauseRef confl = propagate();
+    if(confl!=NO_CLAUSE) {
+      analyze(clause(confl), SATLiteral::dummy());
+      res = UNSATISFIABLE;
+      break;
+    }
+  }
+  undoAssumptions();
+  return res;
+}
+
+SATSolver::Status PropagationOracle::solve(unsigned conflictCountLimit)
+{
+  CALL("PropagationOracle::solve");
+
+  return propagateAssumptions(_assumptions);
+}
+
+SATSolver::Status PropagationOracle::solveUnderAssumptions(const SATLiteralStack& assumps, unsigned conflictCountLimit, bool)
+{
+  CALL("PropagationOracle::solveUnderAssumptions");
+  ASS(!hasAssumptions());
+
+  return propagateAssumptions(assumps);
+}
+
+/**
+ * Minimize the failed assumptions by leaving them out one by one, as
+ * SATSolverWithAssumptions does. After each successful attempt the
+ * assumptions are replaced by the ones the new conflict was derived from.
+ */
+const SATLiteralStack& PropagationOracle::explicitlyMinimizedFailedAssumptions(unsigned conflictCountLimit, bool randomize)
+{
+  CALL("PropagationOracle::explicitlyMinimizedFailedAssumptions");
+  ASS(!hasAssumptions());
+
+  static SATLiteralStack failed;
+  static SATLiteralStack attempt;
+  failed = _failedAssumptionBuffer;
+
+  if (randomize) {
+    for(unsigned i=failed.size();i>1;i--) {
+      std::swap(failed[i-1], failed[Random::getInteger(i)]);
+    }
+  }
+
+  unsigned i = 0;
+  while(i<failed.size()) {
+    attempt.reset();
+    for(unsigned j=0;j<failed.size();j++) {
+      if(j!=i) {
+        attempt.push(failed[j]);
+      }
+    }
+    if(propagateAssumptions(attempt)==UNSATISFIABLE) {
+      // the premises are now those of the smaller set
+      failed = _failedAssumptionBuffer;
+    }
+    else {
+      i++;
+    }
+  }
+
+  _failedAssumptionBuffer = failed;
+  return _failedAssumptionBuffer;
+}
+
+SATSolver::VarAssignment PropagationOracle::getAssignment(unsigned var)
+{
+  CALL("PropagationOracle::getAssignment");
+  ASS_G(var,0); ASS_LE(var,_varCnt);
+
+  int val = value(SATLiteral(var,1).content());
+  if(!val) {
+    return NOT_KNOWN;
+  }
+  return val>0 ? TRUE : FALSE;
+}
+
+bool PropagationOracle::isZeroImplied(unsigned var)
+{
+  CALL("PropagationOracle::isZeroImplied");
+  ASS_G(var,0); ASS_LE(var,_varCnt);
+
+  return value(SATLiteral(var,1).content());
+}
+
+void PropagationOracle::collectZeroImplied(SATLiteralStack& acc)
+{
+  CALL("PropagationOracle::collectZeroImplied");
+
+  for(unsigned i=0;i<_levelZero;i++) {
+    acc.push(SATLiteral(_trail[i]));
+  }
+}
+
+/**
+ * Return the input clauses the last refutation was derived from
+ */
+SATClauseList* PropagationOracle::getRefutationPremiseList()
+{
+  CALL("PropagationOracle::getRefutationPremiseList");
+
+  if(_refutationPremisesValid) {
+    return _refutationPremises;
+  }
+  // the list is not destroyed, it may be kept by the inferences of earlier refutations
+  _refutationPremises = 0;
+  for(unsigned i=0;i<_premises.size();i++) {
+    SATClauseList::push(_premises[i], _refutationPremises);
+  }
+  _refutationPremisesValid = true;
+  return _refutationPremises;
+}
+
+SATClause* PropagationOracle::getRefutation()
+{
+  CALL("PropagationOracle::getRefutation");
+
+  _refutationInference->setPremises(getRefutationPremiseList());
+  return _refutation;
+}
+
+}
@@ -0,0 +1,156 @@
+/*
+ * File PropagationOracle.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file PropagationOracle.hpp
+ * Defines class PropagationOracle.
+ */
+
+#ifndef __PropagationOracle__
+#define __PropagationOracle__
+
+#include "Forwards.hpp"
+
+#include "Lib/Stack.hpp"
+
+#include "SATSolver.hpp"
+#include "SATLiteral.hpp"
+#include "SATClause.hpp"
+
+namespace SAT {
+
+using namespace Lib;
+
+/**
+ * A solver deciding assumptions by unit propagation only
+ *
+ * The clauses are watched by two literals and the consequences of the
+ * clauses alone are kept on the trail between calls, so that a query only
+ * propagates its assumptions and then undoes them. The solver never
+ * branches nor learns, it answers UNSATISFIABLE if the assumptions lead
+ * to a conflict by propagation and UNKNOWN otherwise.
+ *
+ * The failed assumptions and the premises of a refutation are read off the
+ * implication graph, so they contain only the assumptions and the clauses
+ * the conflict was actually derived from.
+ */
+class PropagationOracle : public SATSolverWithAssumptions
+{
+public:
+  CLASS_NAME(PropagationOracle);
+  USE_ALLOCATOR(PropagationOracle);
+
+  PropagationOracle();
+
+  virtual void addClause(SATClause* cl) override;
+  /** Propagate the added assumptions, the conflict count limit is ignored */
+  virtual Status solve(unsigned conflictCountLimit) override;
+
+  virtual VarAssignment getAssignment(unsigned var) override;
+  virtual bool isZeroImplied(unsigned var) override;
+  virtual void collectZeroImplied(SATLiteralStack& acc) override;
+  virtual SATClause* getZeroImpliedCertificate(unsigned var) override { return 0; }
+
+  virtual void ensureVarCount(unsigned newVarCnt) override;
+  virtual unsigned newVar() override;
+  virtual void suggestPolarity(unsigned var, unsigned pol) override {}
+
+  virtual void addAssumption(SATLiteral lit) override;
+  virtual void retractAllAssumptions() override;
+  virtual bool hasAssumptions() const override { return _assumptions.isNonEmpty(); }
+
+  virtual Status solveUnderAssumptions(const SATLiteralStack& assumps, unsigned conflictCountLimit, bool) override;
+  virtual const SATLiteralStack& explicitlyMinimizedFailedAssumptions(unsigned conflictCountLimit, bool randomize) override;
+
+  virtual SATClause* getRefutation() override;
+  virtual SATClauseList* getRefutationPremiseList() override;
+
+  virtual void recordSource(unsigned satlitvar, Literal* lit) override {}
+
+  unsigned varCnt() const { return _varCnt; }
+
+private:
+  /** Literals are represented by the content of SATLiteral, i.e. 2*var+polarity */
+  typedef unsigned Lit;
+  /** Offset of a clause in _arena */
+  typedef unsigned ClauseRef;
+
+  static const ClauseRef NO_CLAUSE = 0xFFFFFFFF;
+
+  /** A clause in _arena is its size, its index in _clauses and its literals */
+  static const unsigned HEADER_SIZE = 2;
+
+  struct Watch
+  {
+    Watch() {}
+    Watch(ClauseRef cref, Lit blocker) : cref(cref), blocker(blocker) {}
+
+    ClauseRef cref;
+    /** a literal of the clause; if true, the clause need not be visited */
+    Lit blocker;
+  };
+
+  static unsigned lit2var(Lit l) { return l>>1; }
+
+  int value(Lit l) const { return _values[l]; }
+
+  unsigned clauseSize(ClauseRef cr) const { return _arena[cr]; }
+  SATClause* clause(ClauseRef cr) const { return _clauses[_arena[cr+1]]; }
+  Lit* clauseLits(ClauseRef cr) { return _arena.begin()+cr+HEADER_SIZE; }
+
+  void assign(Lit l, SATClause* reason);
+  ClauseRef propagate();
+  void undoAssumptions();
+  Status propagateAssumptions(const SATLiteralStack& assumps);
+  void analyze(SATClause* confl, SATLiteral failed);
+
+  /** true once the clauses added so far are inconsistent by propagation */
+  bool _unsat;
+
+  unsigned _varCnt;
+  /** indexed by literals */
+  Stack<signed char> _values;
+  Stack<Stack<Watch> > _watches;
+  /** indexed by variables, zero for assumptions */
+  Stack<SATClause*> _reasons;
+  Stack<unsigned> _stamps;
+  unsigned _stamp;
+
+  Stack<Lit> _trail;
+  /** the trail up to here consists of the consequences of the clauses alone */
+  unsigned _levelZero;
+  unsigned _propagated;
+
+  Stack<unsigned> _arena;
+  Stack<SATClause*> _clauses;
+
+  SATLiteralStack _assumptions;
+  /** input clauses the last refutation was derived from */
+  Stack<SATClause*> _premises;
+  /** premises of the refutation without assumptions, if _unsat */
+  Stack<SATClause*> _topLevelPremises;
+  /** list built from _premises, valid if _refutationPremisesValid */
+  SATClauseList* _refutationPremises;
+  bool _refutationPremisesValid;
+  /** empty clause returned by getRefutation, recycled between calls */
+  SATClause* _refutation;
+  PropInference* _refutationInference;
+};
+
+}
+
+#endif // __PropagationOracle__
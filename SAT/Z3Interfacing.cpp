@@ -381,15 +381,15 @@ z3::expr Z3Interfacing::getz3expr(Term* trm,bool isLit,bool&nameExpression,bool
     if(trm->arity()==0){
       if(symb->integerConstant()){
         IntegerConstantType value = symb->integerValue();
-        return _context.int_val(value.toInner());
+        return _context.int_val(value.toString().c_str());
       }
       if(symb->realConstant()){
         RealConstantType value = symb->realValue();
-        return _context.real_val(value.numerator().toInner(),value.denominator().toInner());
+        return _context.real_val(value.toString().c_str());
       }
       if(symb->rationalConstant()){
         RationalConstantType value = symb->rationalValue();
-        return _context.real_val(value.numerator().toInner(),value.denominator().toInner());
+        return _context.real_val(value.toString().c_str());
       }
       if(!isLit && env.signature->isFoolConstantSymbol(true,trm->functor())){
         return _context.bool_val(true);
@@ -0,0 +1,662 @@
+/*
+ * File Checkpoint.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file Checkpoint.cpp
+ * Implements classes CheckpointWriter and CheckpointReader.
+ */
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Lib/Allocator.hpp"
+#include "Lib/Environment.hpp"
+#include "Lib/Hash.hpp"
+#include "Lib/Int.hpp"
+#include "Lib/SharedSet.hpp"
+#include "Lib/Varint.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Inference.hpp"
+#include "Kernel/Problem.hpp"
+#include "Kernel/Signature.hpp"
+#include "Kernel/SortHelper.hpp"
+#include "Kernel/Sorts.hpp"
+
+#include "Checkpoint.hpp"
+
+namespace Saturation
+{
+
+using namespace std;
+
+const char CHECKPOINT_MAGIC[8] = { 'V', 'C', 'H', 'K', 'P', 'T', '0', '2' };
+
+/**
+ * Return a hash of the clauses of @c prb, so that a checkpoint is only
+ * resumed for the problem it was logged for
+ *
+ * The clauses are those of the preprocessed problem, so the options that
+ * affect preprocessing have to agree as well. Options of the saturation
+ * itself may differ.
+ */
+unsigned checkpointFingerprint(Problem& prb)
+{
+  CALL("checkpointFingerprint");
+
+  unsigned res = 2166136261u;
+  ClauseIterator cit = prb.clauseIterator();
+  while(cit.hasNext()) {
+    Clause* cl = cit.next();
+    vstring str = cl->literalsOnlyToString();
+    res = Hash::hash(reinterpret_cast<const unsigned char*>(str.c_str()), str.size(), res);
+    res = HashUtils::combine(res, cl->inputType());
+  }
+  return res;
+}
+
+/////////////////////////////////////
+// CheckpointWriter
+//
+
+CheckpointWriter::CheckpointWriter(vstring fileName, unsigned fingerprint)
+: _selected(0)
+{
+  CALL("CheckpointWriter::CheckpointWriter");
+
+  {
+    BYPASSING_ALLOCATOR; // the buffers of ofstream are not allocated via Allocator
+    _out = new ofstream(fileName.c_str(), ios::out | ios::binary | ios::trunc);
+  }
+  if(!*_out) {
+    USER_ERROR("Cannot open checkpoint file "+fileName);
+  }
+  _out->write(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+  writeUnsigned(fingerprint);
+  _out->write(reinterpret_cast<const char*>(_buf.begin()), _buf.size());
+  _buf.reset();
+  _out->flush();
+}
+
+CheckpointWriter::~CheckpointWriter()
+{
+  CALL("CheckpointWriter::~CheckpointWriter");
+
+  BYPASSING_ALLOCATOR;
+  delete _out;
+}
+
+/**
+ * Write the records collected since the last segment as a new segment
+ * and flush the file
+ */
+void CheckpointWriter::writeSegment()
+{
+  CALL("CheckpointWriter::writeSegment");
+
+  if(_buf.isEmpty()) {
+    return;
+  }
+  Varint::write(static_cast<unsigned>(_buf.size()), *_out);
+  _out->write(reinterpret_cast<const char*>(_buf.begin()), _buf.size());
+  _out->flush();
+  _buf.reset();
+}
+
+void CheckpointWriter::writeUnsigned(unsigned val)
+{
+  Varint::write(val, _buf);
+}
+
+void CheckpointWriter::writeName(const vstring& name)
+{
+  writeUnsigned(name.size());
+  for(size_t i=0;i<name.size();i++) {
+    put(static_cast<unsigned char>(name[i]));
+  }
+}
+
+/**
+ * Declare @c sort unless it has been declared already.
+ * Return false if it is a structured sort, which cannot be logged.
+ */
+bool CheckpointWriter::declareSort(unsigned sort)
+{
+  CALL("CheckpointWriter::declareSort");
+
+  if(_sorts.find(sort)) {
+    return true;
+  }
+  if(env.sorts->isStructuredSort(sort)) {
+    return false;
+  }
+  _sorts.insert(sort);
+  put(CR_SORT);
+  writeUnsigned(sort);
+  writeName(env.sorts->sortName(sort));
+  return true;
+}
+
+/**
+ * Declare the sorts and symbols of @c cl which have not been declared yet.
+ * Return false if the clause cannot be logged.
+ */
+bool CheckpointWriter::declareSymbols(Clause* cl)
+{
+  CALL("CheckpointWriter::declareSymbols");
+
+  if(cl->splits() && !cl->splits()->isEmpty()) {
+    return false;
+  }
+
+  static Stack<TermList> todo;
+  todo.reset();
+  unsigned clen = cl->length();
+  for(unsigned i=0;i<clen;i++) {
+    Literal* lit = (*cl)[i];
+    unsigned pred = lit->functor();
+    if(lit->isEquality()) {
+      if(!declareSort(SortHelper::getEqualityArgumentSort(lit))) {
+        return false;
+      }
+    }
+    else if(!_predicates.find(pred)) {
+      Signature::Symbol* sym = env.signature->getPredicate(pred);
+      if(sym->interpreted()) {
+        return false;
+      }
+      OperatorType* type = sym->predType();
+      for(unsigned j=0;j<lit->arity();j++) {
+        if(!declareSort(type->arg(j))) {
+          return false;
+        }
+      }
+      _predicates.insert(pred);
+      put(CR_PREDICATE);
+      writeUnsigned(pred);
+      writeName(sym->name());
+      writeUnsigned(lit->arity());
+      for(unsigned j=0;j<lit->arity();j++) {
+        writeUnsigned(type->arg(j));
+      }
+    }
+    for(unsigned j=0;j<lit->arity();j++) {
+      todo.push(*lit->nthArgument(j));
+    }
+  }
+
+  while(todo.isNonEmpty()) {
+    TermList t = todo.pop();
+    if(t.isVar()) {
+      if(!t.isOrdinaryVar()) {
+        return false;
+      }
+      continue;
+    }
+    Term* trm = t.term();
+    if(trm->isSpecial()) {
+      return false;
+    }
+    for(unsigned j=0;j<trm->arity();j++) {
+      todo.push(*trm->nthArgument(j));
+    }
+    unsigned fn = trm->functor();
+    if(_functions.find(fn)) {
+      continue;
+    }
+    Signature::Symbol* sym = env.signature->getFunction(fn);
+    if(sym->interpreted() || sym->interpretedNumber()) {
+      return false;
+    }
+    OperatorType* type = sym->fnType();
+    for(unsigned j=0;j<trm->arity();j++) {
+      if(!declareSort(type->arg(j))) {
+        return false;
+      }
+    }
+    if(!declareSort(type->result())) {
+      return false;
+    }
+    _functions.insert(fn);
+    put(CR_FUNCTION);
+    writeUnsigned(fn);
+    writeName(sym->name());
+    writeUnsigned(trm->arity());
+    for(unsigned j=0;j<trm->arity();j++) {
+      writeUnsigned(type->arg(j));
+    }
+    writeUnsigned(type->result());
+  }
+  return true;
+}
+
+void CheckpointWriter::writeTerm(TermList t)
+{
+  CALL("CheckpointWriter::writeTerm");
+
+  static Stack<TermList> todo;
+  todo.reset();
+  todo.push(t);
+  while(todo.isNonEmpty()) {
+    TermList s = todo.pop();
+    if(s.isVar()) {
+      writeUnsigned(s.var()<<1);
+      continue;
+    }
+    Term* trm = s.term();
+    writeUnsigned((trm->functor()<<1)|1);
+    for(unsigned i=trm->arity();i>0;i--) {
+      todo.push(*trm->nthArgument(i-1));
+    }
+  }
+}
+
+void CheckpointWriter::writeClause(CheckpointRecord rec, Clause* cl)
+{
+  CALL("CheckpointWriter::writeClause");
+
+  put(rec);
+  writeUnsigned(cl->number());
+  writeUnsigned(cl->inputType());
+  writeUnsigned(cl->age());
+  unsigned clen = cl->length();
+  writeUnsigned(clen);
+  for(unsigned i=0;i<clen;i++) {
+    Literal* lit = (*cl)[i];
+    writeUnsigned((lit->functor()<<1)|(lit->polarity() ? 1 : 0));
+    if(lit->isEquality()) {
+      writeUnsigned(SortHelper::getEqualityArgumentSort(lit));
+    }
+    for(unsigned j=0;j<lit->arity();j++) {
+      writeTerm(*lit->nthArgument(j));
+    }
+  }
+}
+
+void CheckpointWriter::writeNumber(CheckpointRecord rec, unsigned number)
+{
+  put(rec);
+  writeUnsigned(number);
+}
+
+void CheckpointWriter::onPassiveAdded(Clause* cl)
+{
+  CALL("CheckpointWriter::onPassiveAdded");
+
+  if(declareSymbols(cl)) {
+    writeClause(CR_PASSIVE, cl);
+    _logged.insert(cl->number());
+  }
+}
+
+/**
+ * Called when @c cl is selected for activation
+ *
+ * The unprocessed clauses have all been added to the passive container
+ * by now, so the records collected so far describe a state from which
+ * the saturation can be resumed, and they are written as a segment.
+ */
+void CheckpointWriter::onPassiveSelected(Clause* cl)
+{
+  CALL("CheckpointWriter::onPassiveSelected");
+
+  if(_selected) {
+    // the previously selected clause was not activated
+    writeNumber(CR_REMOVED, _selected);
+    _selected = 0;
+  }
+  writeSegment();
+  if(_logged.remove(cl->number())) {
+    writeNumber(CR_SELECTED, cl->number());
+    _selected = cl->number();
+  }
+}
+
+void CheckpointWriter::onActiveAdded(Clause* cl)
+{
+  CALL("CheckpointWriter::onActiveAdded");
+
+  if(_selected && _selected==cl->number()) {
+    writeNumber(CR_ACTIVATED, _selected);
+    _logged.insert(_selected);
+    _selected = 0;
+  }
+  else if(declareSymbols(cl)) {
+    writeClause(CR_ACTIVE, cl);
+    _logged.insert(cl->number());
+  }
+}
+
+void CheckpointWriter::onRemoved(Clause* cl)
+{
+  CALL("CheckpointWriter::onRemoved");
+
+  if(_logged.remove(cl->number())) {
+    writeNumber(CR_REMOVED, cl->number());
+  }
+}
+
+/////////////////////////////////////
+// CheckpointReader
+//
+
+bool CheckpointReader::fail(vstring error)
+{
+  _error = error;
+  return false;
+}
+
+bool CheckpointReader::readUnsigned(unsigned& val)
+{
+  return Varint::read(_pos, _end, val);
+}
+
+bool CheckpointReader::readName(vstring& name)
+{
+  unsigned len;
+  if(!readUnsigned(len) || static_cast<size_t>(_end-_pos)<len) {
+    return false;
+  }
+  name = vstring(reinterpret_cast<const char*>(_pos), len);
+  _pos += len;
+  return true;
+}
+
+/**
+ * Read @c cnt recorded sorts and push the corresponding sorts of the signature into @c sorts
+ */
+bool CheckpointReader::readSorts(unsigned cnt, Stack<unsigned>& sorts)
+{
+  sorts.reset();
+  for(unsigned i=0;i<cnt;i++) {
+    unsigned sort;
+    if(!readUnsigned(sort) || !_sortMap.find(sort, sort)) {
+      return false;
+    }
+    sorts.push(sort);
+  }
+  return true;
+}
+
+bool CheckpointReader::readTerm(TermList& t)
+{
+  CALL("CheckpointReader::readTerm");
+
+  unsigned val;
+  if(!readUnsigned(val)) {
+    return false;
+  }
+  if(!(val&1)) {
+    t.makeVar(val>>1);
+    return true;
+  }
+  unsigned fn;
+  if(!_functionMap.find(val>>1, fn)) {
+    return false;
+  }
+  unsigned arity = env.signature->functionArity(fn);
+  static Stack<TermList> args;
+  unsigned argsStart = args.size();
+  for(unsigned i=0;i<arity;i++) {
+    TermList arg;
+    if(!readTerm(arg)) {
+      args.truncate(argsStart);
+      return false;
+    }
+    args.push(arg);
+  }
+  t = TermList(Term::create(fn, arity, args.begin()+argsStart));
+  args.truncate(argsStart);
+  return true;
+}
+
+bool CheckpointReader::readLiteral(Literal*& lit)
+{
+  CALL("CheckpointReader::readLiteral");
+
+  unsigned header;
+  if(!readUnsigned(header)) {
+    return false;
+  }
+  bool polarity = header&1;
+  if(!(header>>1)) {
+    unsigned sort;
+    TermList lhs, rhs;
+    if(!readUnsigned(sort) || !_sortMap.find(sort, sort) || !readTerm(lhs) || !readTerm(rhs)) {
+      return false;
+    }
+    lit = Literal::createEquality(polarity, lhs, rhs, sort);
+    return true;
+  }
+  unsigned pred;
+  if(!_predicateMap.find(header>>1, pred)) {
+    return false;
+  }
+  unsigned arity = env.signature->predicateArity(pred);
+  static Stack<TermList> args;
+  args.reset();
+  for(unsigned i=0;i<arity;i++) {
+    TermList arg;
+    if(!readTerm(arg)) {
+      return false;
+    }
+    args.push(arg);
+  }
+  lit = Literal::create(pred, arity, polarity, false, args.begin());
+  return true;
+}
+
+bool CheckpointReader::readClause(bool active)
+{
+  CALL("CheckpointReader::readClause");
+
+  unsigned number, inputType, age, length;
+  if(!readUnsigned(number) || !readUnsigned(inputType) || !readUnsigned(age) || !readUnsigned(length)) {
+    return false;
+  }
+  static Stack<Literal*> lits;
+  lits.reset();
+  for(unsigned i=0;i<length;i++) {
+    Literal* lit;
+    if(!readLiteral(lit)) {
+      return false;
+    }
+    lits.push(lit);
+  }
+  Clause* cl = Clause::fromStack(lits, static_cast<Unit::InputType>(inputType), new Inference(Inference::CHECKPOINT));
+  cl->setAge(age);
+
+  Entry* entry;
+  if(_entries.getValuePtr(number, entry)) {
+    _order.push(number);
+  }
+  else {
+    entry->clause->destroyIfUnnecessary();
+  }
+  entry->clause = cl;
+  entry->active = active;
+  return true;
+}
+
+/**
+ * Read the segments from @c data, ignoring a truncated last segment
+ */
+bool CheckpointReader::read(unsigned char* data, size_t size, unsigned fingerprint)
+{
+  CALL("CheckpointReader::read");
+
+  if(size<sizeof(CHECKPOINT_MAGIC) || memcmp(data, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC))) {
+    return fail("not a checkpoint");
+  }
+  _pos = data+sizeof(CHECKPOINT_MAGIC);
+  const unsigned char* end = data+size;
+  _end = end;
+
+  unsigned recorded;
+  if(!readUnsigned(recorded)) {
+    return fail("not a checkpoint");
+  }
+  if(recorded!=fingerprint) {
+    return fail("it was logged for a different problem or preprocessing");
+  }
+
+  for(;;) {
+    unsigned len;
+    if(!readUnsigned(len) || static_cast<size_t>(end-_pos)<len) {
+      // no more segments or a truncated one
+      break;
+    }
+    _end = _pos+len;
+    if(!readSegment()) {
+      return false;
+    }
+    _end = end;
+  }
+
+  for(unsigned i=0;i<_order.size();i++) {
+    Entry entry;
+    if(_entries.find(_order[i], entry)) {
+      (entry.active ? _active : _passive).push(entry.clause);
+    }
+  }
+  return true;
+}
+
+/**
+ * Read the records of a segment which ends at @c _end
+ */
+bool CheckpointReader::readSegment()
+{
+  CALL("CheckpointReader::readSegment");
+
+  static Stack<unsigned> sorts;
+  while(_pos<_end) {
+    unsigned rec = *_pos++;
+    unsigned num, arity;
+    vstring name;
+    Entry* entry;
+    bool complete;
+    switch(rec) {
+    case CR_SORT:
+      complete = readUnsigned(num) && readName(name);
+      if(complete) {
+        _sortMap.insert(num, env.sorts->addSort(name, false));
+      }
+      break;
+    case CR_FUNCTION:
+      complete = readUnsigned(num) && readName(name) && readUnsigned(arity) && readSorts(arity+1, sorts);
+      if(complete) {
+        OperatorType* type = OperatorType::getFunctionType(arity, sorts.begin(), sorts.top());
+        bool added;
+        unsigned fn = env.signature->addFunction(name, arity, added);
+        Signature::Symbol* sym = env.signature->getFunction(fn);
+        if(!added && (sym->interpreted() || sym->interpretedNumber() || sym->fnType()!=type)) {
+          // the name is taken by a different symbol
+          fn = env.signature->addFreshFunction(arity, name.c_str());
+          added = true;
+        }
+        if(added) {
+          env.signature->getFunction(fn)->setType(type);
+        }
+        _functionMap.insert(num, fn);
+      }
+      break;
+    case CR_PREDICATE:
+      complete = readUnsigned(num) && readName(name) && readUnsigned(arity) && readSorts(arity, sorts);
+      if(complete) {
+        OperatorType* type = OperatorType::getPredicateType(arity, sorts.begin());
+        bool added;
+        unsigned pred = env.signature->addPredicate(name, arity, added);
+        Signature::Symbol* sym = env.signature->getPredicate(pred);
+        if(!added && (sym->interpreted() || sym->predType()!=type)) {
+          pred = env.signature->addFreshPredicate(arity, name.c_str());
+          added = true;
+        }
+        if(added) {
+          env.signature->getPredicate(pred)->setType(type);
+        }
+        _predicateMap.insert(num, pred);
+      }
+      break;
+    case CR_PASSIVE:
+    case CR_ACTIVE:
+      complete = readClause(rec==CR_ACTIVE);
+      break;
+    case CR_SELECTED:
+    case CR_ACTIVATED:
+    case CR_REMOVED:
+      complete = readUnsigned(num);
+      if(!complete) {
+        break;
+      }
+      entry = _entries.findPtr(num);
+      if(!entry) {
+        return fail("unknown clause "+Int::toString(num));
+      }
+      if(rec==CR_ACTIVATED) {
+        entry->active = true;
+      }
+      else if(rec==CR_REMOVED) {
+        Clause* cl = entry->clause;
+        _entries.remove(num);
+        cl->destroyIfUnnecessary();
+      }
+      // a selected clause stays passive unless it is activated
+      break;
+    default:
+      return fail("unknown record "+Int::toString(rec));
+    }
+    if(!complete) {
+      return fail("malformed record "+Int::toString(rec));
+    }
+  }
+  return true;
+}
+
+/**
+ * Map the checkpoint @c fileName into memory and read it. Return false
+ * if it cannot be read, is not a checkpoint, or was logged for a problem
+ * with a fingerprint other than @c fingerprint.
+ */
+bool CheckpointReader::load(const vstring& fileName, unsigned fingerprint)
+{
+  CALL("CheckpointReader::load");
+
+  int fd = open(fileName.c_str(), O_RDONLY);
+  if(fd<0) {
+    return fail("cannot open "+fileName);
+  }
+  struct stat st;
+  if(fstat(fd, &st) || !st.st_size) {
+    close(fd);
+    return fail("not a checkpoint");
+  }
+  size_t size = st.st_size;
+  void* data = mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if(data==MAP_FAILED) {
+    return fail("cannot map "+fileName);
+  }
+  bool res = read(static_cast<unsigned char*>(data), size, fingerprint);
+  munmap(data, size);
+  return res;
+}
+
+}
@@ -0,0 +1,188 @@
+/*
+ * File Checkpoint.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file Checkpoint.hpp
+ * Defines classes CheckpointWriter and CheckpointReader.
+ */
+
+#ifndef __Checkpoint__
+#define __Checkpoint__
+
+#include <fstream>
+
+#include "Forwards.hpp"
+
+#include "Lib/DHMap.hpp"
+#include "Lib/DHSet.hpp"
+#include "Lib/Stack.hpp"
+#include "Lib/VString.hpp"
+
+#include "Kernel/Term.hpp"
+
+namespace Saturation {
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * Records of a checkpoint
+ *
+ * A checkpoint starts with CHECKPOINT_MAGIC and the fingerprint of the
+ * problem, and continues with segments. A segment is its length in bytes
+ * followed by one record per change of the active and passive containers:
+ * the record byte followed by its arguments. Unsigned integers are
+ * written in seven bit groups, lowest first. Sorts and symbols are
+ * declared before the first clause using them, a name is its length
+ * followed by its characters.
+ *
+ * A segment ends when the next clause is selected for activation. At that
+ * point the clauses generated by the previous activation are in the
+ * passive container, so resuming from the end of a segment loses no
+ * inferences.
+ *
+ * A term is written in prefix order, a variable as twice its number and
+ * a non-variable term as twice its functor plus one, followed by its
+ * arguments. A literal is twice its predicate plus its polarity, followed
+ * by the sort of the arguments if it is an equality, and by its arguments.
+ */
+enum CheckpointRecord {
+  /** sort, name */
+  CR_SORT = 1,
+  /** functor, name, arity, argument sorts, result sort */
+  CR_FUNCTION = 2,
+  /** predicate, name, arity, argument sorts */
+  CR_PREDICATE = 3,
+  /** clause number, input type, age, length, literals */
+  CR_PASSIVE = 4,
+  CR_ACTIVE = 5,
+  /** clause number */
+  CR_SELECTED = 6,
+  CR_ACTIVATED = 7,
+  CR_REMOVED = 8
+};
+
+extern const char CHECKPOINT_MAGIC[8];
+
+unsigned checkpointFingerprint(Problem& prb);
+
+/**
+ * Appends the changes of the active and passive containers to a
+ * checkpoint file
+ *
+ * The records are collected in memory and written as a segment whenever
+ * a clause is selected for activation.
+ *
+ * Clauses depending on AVATAR splits and clauses with interpreted
+ * symbols other than equality, structured sorts or special terms are
+ * not logged.
+ */
+class CheckpointWriter
+{
+public:
+  CLASS_NAME(CheckpointWriter);
+  USE_ALLOCATOR(CheckpointWriter);
+
+  CheckpointWriter(vstring fileName, unsigned fingerprint);
+  ~CheckpointWriter();
+
+  void onPassiveAdded(Clause* cl);
+  void onPassiveSelected(Clause* cl);
+  void onActiveAdded(Clause* cl);
+  void onRemoved(Clause* cl);
+
+private:
+  void put(unsigned char c) { _buf.push(c); }
+  void writeSegment();
+  void writeUnsigned(unsigned val);
+  void writeName(const vstring& name);
+  bool declareSort(unsigned sort);
+  bool declareSymbols(Clause* cl);
+  void writeTerm(TermList t);
+  void writeClause(CheckpointRecord rec, Clause* cl);
+  void writeNumber(CheckpointRecord rec, unsigned number);
+
+  std::ofstream* _out;
+  /** records of the current segment */
+  Stack<unsigned char> _buf;
+  DHSet<unsigned> _sorts;
+  DHSet<unsigned> _functions;
+  DHSet<unsigned> _predicates;
+  /** numbers of the logged clauses in the active and passive containers */
+  DHSet<unsigned> _logged;
+  /** number of the logged clause selected for activation, or zero */
+  unsigned _selected;
+};
+
+
+/**
+ * Reads a checkpoint by mapping it into memory and recreates the clauses
+ * of the active and passive containers it ended with
+ *
+ * The recorded sorts and symbols are mapped to the ones in the signature
+ * by their names. A symbol whose name is taken by a symbol of a different
+ * type is replaced by a fresh one. A truncated last segment, as written
+ * by a killed prover, is ignored.
+ */
+class CheckpointReader
+{
+public:
+  CheckpointReader() : _pos(0), _end(0) {}
+
+  bool load(const vstring& fileName, unsigned fingerprint);
+
+  /** Clauses in the order they were logged */
+  const Stack<Clause*>& activeClauses() const { return _active; }
+  const Stack<Clause*>& passiveClauses() const { return _passive; }
+  /** If load() failed, the reason of the failure */
+  const vstring& error() const { return _error; }
+
+private:
+  struct Entry {
+    Clause* clause;
+    bool active;
+  };
+
+  bool read(unsigned char* data, size_t size, unsigned fingerprint);
+  bool readSegment();
+  bool readUnsigned(unsigned& val);
+  bool readName(vstring& name);
+  bool readSorts(unsigned cnt, Stack<unsigned>& sorts);
+  bool readTerm(TermList& t);
+  bool readLiteral(Literal*& lit);
+  bool readClause(bool active);
+  bool fail(vstring error);
+
+  const unsigned char* _pos;
+  const unsigned char* _end;
+
+  /** recorded sorts and symbols mapped to the ones in the signature */
+  DHMap<unsigned,unsigned> _sortMap;
+  DHMap<unsigned,unsigned> _functionMap;
+  DHMap<unsigned,unsigned> _predicateMap;
+  DHMap<unsigned,Entry> _entries;
+  /** recorded clause numbers in the order of their records */
+  Stack<unsigned> _order;
+
+  Stack<Clause*> _active;
+  Stack<Clause*> _passive;
+  vstring _error;
+};
+
+}
+
+#endif // __Checkpoint__
@@ -56,6 +56,12 @@ void LRS::onUnprocessedSelected(Clause* c)
   if(shouldUpdateLimits()) {
     TimeCounter tc(TC_LRS_LIMIT_MAINTENANCE);
 
+    if(_useCostModel) {
+      int currTime=env.timer->elapsedMilliseconds();
+      _costModel.endWindow(currTime-max(_lastUpdateTime,_startTime));
+      _lastUpdateTime=currTime;
+    }
+
     long long estimatedReachable=estimatedReachableCount();
     if(estimatedReachable>=0) {
       _passive->updateLimits(estimatedReachable);
@@ -78,20 +84,53 @@ bool LRS::shouldUpdateLimits()
 {
   CALL("LRS::shouldUpdateLimits");
 
-  static unsigned cnt=0;
-  cnt++;
+  _updateCnt++;
 
   //when there are limits, we check more frequently so we don't skip too much inferences
-  if(cnt==500 || ((getLimits()->weightLimited() || getLimits()->ageLimited()) && cnt>50 ) ) {
-    cnt=0;
+  if(_updateCnt==500 || ((getLimits()->weightLimited() || getLimits()->ageLimited()) && _updateCnt>50 ) ) {
+    _updateCnt=0;
     return true;
   }
   return false;
 }
 
+void LRS::onPassiveAdded(Clause* c)
+{
+  CALL("LRS::onPassiveAdded");
+
+  if(_useCostModel) {
+    _costModel.onPassiveAdded(c);
+  }
+  Otter::onPassiveAdded(c);
+}
+
+void LRS::onPassiveRemoved(Clause* c)
+{
+  CALL("LRS::onPassiveRemoved");
+
+  if(_useCostModel) {
+    _costModel.onPassiveRemoved(c);
+  }
+  Otter::onPassiveRemoved(c);
+}
+
+void LRS::onPassiveSelected(Clause* c)
+{
+  CALL("LRS::onPassiveSelected");
+
+  if(_useCostModel) {
+    _costModel.onPassiveSelected(c);
+  }
+  SaturationAlgorithm::onPassiveSelected(c);
+}
+
 /**
  * Resturn an estimate of the number of clauses that the saturation
  * algorithm will be able to activate in the remaining time
+ *
+ * The number of clauses activated so far is extrapolated to the remaining
+ * time. With the lrs_cost_model option, the estimate comes from the cost
+ * model instead, once it has seen enough.
  */
 long long LRS::estimatedReachableCount()
 {
@@ -118,6 +157,12 @@ long long LRS::estimatedReachableCount()
     //we end-up here even if there is no time limit (i.e. time limit is set to 0)
     return -1;
   }
+  if(_useCostModel) {
+    long long modelled=_costModel.estimatedReachableCount(timeLeft, _opt.ageRatio(), _opt.weightRatio());
+    if(modelled>=0) {
+      return modelled;
+    }
+  }
   return (processed*timeLeft)/timeSpent;
 }
 
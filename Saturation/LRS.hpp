@@ -29,6 +29,7 @@
 
 #include "Lib/Event.hpp"
 
+#include "LRSCostModel.hpp"
 #include "Otter.hpp"
 
 namespace Saturation {
@@ -43,7 +44,8 @@ public:
   USE_ALLOCATOR(LRS);
 
   LRS(Problem& prb, const Options& opt)
-  : Otter(prb, opt), _limitsEverActive(false) {}
+  : Otter(prb, opt), _limitsEverActive(false), _updateCnt(0), _lastUpdateTime(0),
+    _useCostModel(opt.lrsCostModel()) {}
 
 
 protected:
@@ -54,11 +56,26 @@ protected:
   //overrides SaturationAlgorithm::onUnprocessedSelected
   void onUnprocessedSelected(Clause* c);
 
+  //overrides Otter::onPassiveAdded
+  void onPassiveAdded(Clause* c);
+  //overrides Otter::onPassiveRemoved
+  void onPassiveRemoved(Clause* c);
+  //overrides SaturationAlgorithm::onPassiveSelected
+  void onPassiveSelected(Clause* c);
+
   bool shouldUpdateLimits();
 
   long long estimatedReachableCount();
 
   bool _limitsEverActive;
+
+  /** Calls of shouldUpdateLimits since the last update */
+  unsigned _updateCnt;
+  /** Time of the last limit update in milliseconds */
+  int _lastUpdateTime;
+  /** True if the lrs_cost_model option is on */
+  bool _useCostModel;
+  LRSCostModel _costModel;
 };
 
 };
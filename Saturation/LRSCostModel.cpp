@@ -0,0 +1,194 @@
+
+/*
+ * File LRSCostModel.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file LRSCostModel.cpp
+ * Implements class LRSCostModel.
+ */
+
+#include <cmath>
+
+#include "Debug/Tracer.hpp"
+
+#include "Kernel/Clause.hpp"
+
+#include "LRSCostModel.hpp"
+
+namespace Saturation
+{
+
+using namespace Lib;
+using namespace Kernel;
+
+const double LRSCostModel::DECAY=0.9;
+
+LRSCostModel::LRSCostModel()
+: _passiveCounts(MAX_BUCKET+1), _passiveCnt(0), _passiveWeight(0),
+  _windowCnt(0), _windowWeight(0), _windowTime(0), _windows(0),
+  _snn(0), _snw(0), _sww(0), _snt(0), _swt(0)
+{
+  _passiveCounts.init(MAX_BUCKET+1, 0);
+}
+
+unsigned LRSCostModel::bucket(Clause* cl)
+{
+  unsigned w=cl->weight();
+  return w>MAX_BUCKET ? MAX_BUCKET : w;
+}
+
+void LRSCostModel::onPassiveAdded(Clause* cl)
+{
+  unsigned b=bucket(cl);
+  _passiveCounts[b]++;
+  _passiveCnt++;
+  _passiveWeight+=b;
+}
+
+void LRSCostModel::onPassiveRemoved(Clause* cl)
+{
+  CALL("LRSCostModel::onPassiveRemoved");
+
+  unsigned b=bucket(cl);
+  ASS_G(_passiveCounts[b],0);
+  _passiveCounts[b]--;
+  _passiveCnt--;
+  _passiveWeight-=b;
+}
+
+void LRSCostModel::onPassiveSelected(Clause* cl)
+{
+  onPassiveRemoved(cl);
+  _windowCnt++;
+  _windowWeight+=cl->weight();
+}
+
+/**
+ * Record that @b timeSpent milliseconds passed since the previous
+ * call, and start a new window.
+ */
+void LRSCostModel::endWindow(int timeSpent)
+{
+  CALL("LRSCostModel::endWindow");
+
+  _windowTime+=timeSpent;
+  if(_windowCnt==0) {
+    //nothing was selected, the time is still spent on simplifying what
+    //the previously selected clauses generated, so it goes to the next window
+    return;
+  }
+
+  double n=_windowCnt;
+  double w=_windowWeight;
+  double t=_windowTime;
+
+  _snn=_snn*DECAY+n*n;
+  _snw=_snw*DECAY+n*w;
+  _sww=_sww*DECAY+w*w;
+  _snt=_snt*DECAY+n*t;
+  _swt=_swt*DECAY+w*t;
+  _windows++;
+
+  _windowCnt=0;
+  _windowWeight=0;
+  _windowTime=0;
+}
+
+/**
+ * Assign to @b a and @b b the coefficients of the cost a+b*w of selecting
+ * a clause of weight w. Return false if there is not enough data yet.
+ */
+bool LRSCostModel::getCoefficients(double& a, double& b)
+{
+  CALL("LRSCostModel::getCoefficients");
+
+  if(_windows<2 || _snt<=0) {
+    return false;
+  }
+
+  double det=_snn*_sww-_snw*_snw;
+  if(det>1e-9*_snn*_sww) {
+    a=(_snt*_sww-_swt*_snw)/det;
+    b=(_snn*_swt-_snw*_snt)/det;
+    if(a>=0 && b>=0) {
+      return true;
+    }
+  }
+  //the weights are too uniform to tell the two coefficients apart, or the
+  //fit makes no sense, so we use the average cost of a selected clause
+  a=_snt/_snn;
+  b=0;
+  return true;
+}
+
+/**
+ * Return an estimate of the number of clauses that can be selected in
+ * @b timeLeft milliseconds, or -1 if the model has not seen enough yet.
+ *
+ * The passive container selects by age and by weight in the ratio
+ * @b ageRatio to @b weightRatio. Selections by weight take the lightest
+ * passive clauses, selections by age are assumed to take clauses of the
+ * average passive weight.
+ */
+long long LRSCostModel::estimatedReachableCount(long long timeLeft, int ageRatio, int weightRatio)
+{
+  CALL("LRSCostModel::estimatedReachableCount");
+  ASS_G(ageRatio+weightRatio,0);
+
+  double a, b;
+  if(!getCoefficients(a, b)) {
+    return -1;
+  }
+  if(_passiveCnt==0) {
+    return 0;
+  }
+
+  double avgCost=a+b*(static_cast<double>(_passiveWeight)/_passiveCnt);
+  if(avgCost<=0) {
+    //the selections take no measurable time
+    return -1;
+  }
+  double budget=timeLeft;
+  double ageShare=static_cast<double>(ageRatio)/(ageRatio+weightRatio);
+  double weightShare=1-ageShare;
+
+  if(weightShare==0) {
+    return static_cast<long long>(budget/avgCost);
+  }
+
+  //for each clause selected by weight, (ageShare/weightShare) clauses
+  //are selected by age
+  double ageCostPerWeightPick=avgCost*ageShare/weightShare;
+  double weightPicks=0;
+  for(unsigned w=0;w<=MAX_BUCKET;w++) {
+    unsigned cnt=_passiveCounts[w];
+    if(!cnt) {
+      continue;
+    }
+    double costPerPick=a+b*w+ageCostPerWeightPick;
+    if(costPerPick*cnt>=budget) {
+      weightPicks+=budget/costPerPick;
+      return static_cast<long long>(weightPicks/weightShare);
+    }
+    budget-=costPerPick*cnt;
+    weightPicks+=cnt;
+  }
+  //everything in passive can be selected, and some time remains
+  return static_cast<long long>(weightPicks/weightShare+budget/avgCost);
+}
+
+}
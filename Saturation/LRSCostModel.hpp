@@ -0,0 +1,101 @@
+
+/*
+ * File LRSCostModel.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file LRSCostModel.hpp
+ * Defines class LRSCostModel.
+ */
+
+#ifndef __LRSCostModel__
+#define __LRSCostModel__
+
+#include "Forwards.hpp"
+
+#include "Lib/Allocator.hpp"
+#include "Lib/DArray.hpp"
+
+namespace Saturation {
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * Cost model used by the LRS saturation algorithm to estimate how many
+ * clauses it can still select in the remaining time.
+ *
+ * The time spent between two limit updates is attributed to the clauses
+ * selected in between. This covers their activation as well as the
+ * simplification of the clauses generated from them. The model assumes
+ * that selecting a clause of weight w costs a+b*w milliseconds and fits
+ * a and b by least squares over these windows. Older windows are given
+ * exponentially decreasing weight, as the cost grows with the indices.
+ *
+ * Besides, the model keeps a histogram of the weights of the passive
+ * clauses, so that the cost of the clauses the passive container will
+ * select next can be predicted without traversing the container.
+ */
+class LRSCostModel
+{
+public:
+  CLASS_NAME(LRSCostModel);
+  USE_ALLOCATOR(LRSCostModel);
+
+  LRSCostModel();
+
+  void onPassiveAdded(Clause* cl);
+  void onPassiveRemoved(Clause* cl);
+  void onPassiveSelected(Clause* cl);
+
+  void endWindow(int timeSpent);
+
+  long long estimatedReachableCount(long long timeLeft, int ageRatio, int weightRatio);
+
+private:
+  bool getCoefficients(double& a, double& b);
+
+  static unsigned bucket(Clause* cl);
+
+  /** Clauses heavier than this share the last bucket of the histogram */
+  static const unsigned MAX_BUCKET=1023;
+  /** Factor by which the influence of older windows decreases */
+  static const double DECAY;
+
+  /** Number of passive clauses of each weight */
+  DArray<unsigned> _passiveCounts;
+  /** Number of passive clauses */
+  unsigned _passiveCnt;
+  /** Sum of the weights of the passive clauses (by bucket) */
+  long long _passiveWeight;
+
+  /** Clauses selected in the current window */
+  unsigned _windowCnt;
+  /** Sum of the weights of the clauses selected in the current window */
+  unsigned long long _windowWeight;
+  /** Time spent in the current window in milliseconds */
+  long long _windowTime;
+
+  /** Number of windows seen */
+  unsigned _windows;
+  /** Decayed sums of the least squares problem, n being the number of
+   * clauses and w the sum of their weights in a window, t its time */
+  double _snn, _snw, _sww, _snt, _swt;
+};
+
+};
+
+#endif /* __LRSCostModel__ */
@@ -74,6 +74,7 @@
 #include "Saturation/ExtensionalityClauseContainer.hpp"
 
 #include "Shell/AnswerExtractor.hpp"
+#include "Shell/MetricsReporter.hpp"
 #include "Shell/Options.hpp"
 #include "Shell/Statistics.hpp"
 #include "Shell/UIHelper.hpp"
@@ -86,6 +87,7 @@
 #include "SymElOutput.hpp"
 #include "SaturationAlgorithm.hpp"
 #include "AWPassiveClauseContainer.hpp"
+#include "Checkpoint.hpp"
 #include "Discount.hpp"
 #include "LRS.hpp"
 #include "Otter.hpp"
@@ -165,6 +167,10 @@ SaturationAlgorithm::SaturationAlgorithm(Problem& prb, const Options& opt)
     _limits.setLimits(0,opt.maxWeight());
   }
 
+  if (opt.checkpoint() != "off") {
+    _checkpoint = new CheckpointWriter(opt.checkpoint(), checkpointFingerprint(prb));
+  }
+
   s_instance=this;
 }
 
@@ -178,6 +184,9 @@ SaturationAlgorithm::~SaturationAlgorithm()
 
   s_instance=0;
 
+  // the clauses removed while destroying the containers are not logged
+  _checkpoint = 0;
+
   if (_splitter) {
     delete _splitter;
   }
@@ -273,6 +282,10 @@ void SaturationAlgorithm::onActiveAdded(Clause* c)
     env.out() << "[SA] active: " << c->toString() << std::endl;
     env.endOutput();             
   }          
+
+  if (_checkpoint) {
+    _checkpoint->onActiveAdded(c);
+  }
 }
 
 /**
@@ -316,6 +329,10 @@ void SaturationAlgorithm::onPassiveAdded(Clause* c)
     env.endOutput();
   }
   
+  if (_checkpoint) {
+    _checkpoint->onPassiveAdded(c);
+  }
+
   //when a clause is added to the passive container,
   //we know it is not redundant
   onNonRedundantClause(c);
@@ -344,6 +361,9 @@ void SaturationAlgorithm::onPassiveRemoved(Clause* c)
  */
 void SaturationAlgorithm::onPassiveSelected(Clause* c)
 {
+  if (_checkpoint) {
+    _checkpoint->onPassiveSelected(c);
+  }
 }
 
 /**
@@ -514,6 +534,9 @@ void SaturationAlgorithm::activeRemovedHandler(Clause* cl)
 {
   CALL("SaturationAlgorithm::activeRemovedHandler");
 
+  if (_checkpoint) {
+    _checkpoint->onRemoved(cl);
+  }
   onActiveRemoved(cl);
 }
 
@@ -526,6 +549,9 @@ void SaturationAlgorithm::passiveRemovedHandler(Clause* cl)
 {
   CALL("SaturationAlgorithm::passiveRemovedHandler");
 
+  if (_checkpoint) {
+    _checkpoint->onRemoved(cl);
+  }
   onPassiveRemoved(cl);
 }
 
@@ -574,6 +600,46 @@ void SaturationAlgorithm::addInputClause(Clause* cl)
   env.statistics->initialClauses++;
 }
 
+/**
+ * Fill the active and passive containers with the clauses logged
+ * in the checkpoint given by the checkpoint_resume option
+ *
+ * The clauses are added without simplification, as they were already
+ * simplified by the run which logged them. The indices are built by
+ * adding the clauses to the containers.
+ */
+void SaturationAlgorithm::restoreCheckpoint()
+{
+  CALL("SaturationAlgorithm::restoreCheckpoint");
+
+  CheckpointReader reader;
+  if (!reader.load(_opt.checkpointResume(), checkpointFingerprint(_prb))) {
+    USER_ERROR("Cannot resume from checkpoint "+_opt.checkpointResume()+": "+reader.error());
+  }
+  // clauses discarded or not logged by the previous run are missing
+  _completeOptionSettings = false;
+
+  const Stack<Clause*>& active = reader.activeClauses();
+  for (unsigned i = 0; i < active.size(); i++) {
+    Clause* cl = active[i];
+    onNewClause(cl);
+    _selector->select(cl);
+    cl->setStore(Clause::ACTIVE);
+    env.statistics->activeClauses++;
+    _active->add(cl);
+    // like set-of-support clauses, they enter the active container directly
+    onSOSClauseAdded(cl);
+  }
+
+  const Stack<Clause*>& passive = reader.passiveClauses();
+  for (unsigned i = 0; i < passive.size(); i++) {
+    Clause* cl = passive[i];
+    onNewClause(cl);
+    cl->setStore(Clause::UNPROCESSED);
+    addToPassive(cl);
+  }
+}
+
 /**
  * Return literal selector that is to be used for set-of-support clauses
  */
@@ -654,11 +720,16 @@ void SaturationAlgorithm::init()
 {
   CALL("SaturationAlgorithm::init");
 
-  ClauseIterator toAdd = _prb.clauseIterator();
+  if (_opt.checkpointResume() != "off") {
+    restoreCheckpoint();
+  }
+  else {
+    ClauseIterator toAdd = _prb.clauseIterator();
 
-  while (toAdd.hasNext()) {
-    Clause* cl=toAdd.next();
-    addInputClause(cl);
+    while (toAdd.hasNext()) {
+      Clause* cl=toAdd.next();
+      addInputClause(cl);
+    }
   }
 
   if (_splitter) {
@@ -1158,6 +1229,8 @@ void SaturationAlgorithm::doOneAlgorithmStep()
 {
   CALL("SaturationAlgorithm::doOneAlgorithmStep");
 
+  MetricsReporter::poll();
+
   doUnprocessedLoop();
 
   if (_passive->isEmpty()) {
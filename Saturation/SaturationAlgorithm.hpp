@@ -152,7 +152,7 @@ protected:
   virtual void onActiveRemoved(Clause* c);
   virtual void onPassiveAdded(Clause* c);
   virtual void onPassiveRemoved(Clause* c);
-  void onPassiveSelected(Clause* c);
+  virtual void onPassiveSelected(Clause* c);
   void onUnprocessedAdded(Clause* c);
   void onUnprocessedRemoved(Clause* c);
   virtual void onUnprocessedSelected(Clause* c);
@@ -166,6 +166,7 @@ private:
   void passiveRemovedHandler(Clause* cl);
   void activeRemovedHandler(Clause* cl);
   void addInputClause(Clause* cl);
+  void restoreCheckpoint();
 
   LiteralSelector& getSosLiteralSelector();
 
@@ -229,6 +230,9 @@ protected:
    */
   ScopedPtr<LiteralSelector> _sosLiteralSelector;
 
+  /** Logs the changes of the active and passive containers, if enabled */
+  ScopedPtr<CheckpointWriter> _checkpoint;
+
 
   // counters
 
@@ -52,8 +52,11 @@
 #include "SAT/BufferedSolver.hpp"
 #include "SAT/FallbackSolverWrapper.hpp"
 #include "SAT/MinisatInterfacing.hpp"
+#include "SAT/CDCLSolver.hpp"
 #include "SAT/Z3Interfacing.hpp"
 
+#include "Test/RecordingSatSolver.hpp"
+
 #include "DP/ShortConflictMetaDP.hpp"
 
 #include "SaturationAlgorithm.hpp"
@@ -78,11 +81,14 @@ void SplittingBranchSelector::init()
 
   switch(_parent.getOptions().satSolver()){
     case Options::SatSolver::VAMPIRE:  
-      _solver = new TWLSolver(_parent.getOptions(), true);
+      _solver = Test::RecordingSatSolver::record(new TWLSolver(_parent.getOptions(), true), _parent.getOptions(), "avatar");
       break;
     case Options::SatSolver::MINISAT:
-      _solver = new MinisatInterfacing(_parent.getOptions(),true);
+      _solver = Test::RecordingSatSolver::record(new MinisatInterfacing(_parent.getOptions(),true), _parent.getOptions(), "avatar");
       break;      
+    case Options::SatSolver::CDCL:
+      _solver = Test::RecordingSatSolver::record(new CDCLSolver(_parent.getOptions(),true), _parent.getOptions(), "avatar");
+      break;
 #if VZ3
     case Options::SatSolver::Z3:
       { BYPASSING_ALLOCATOR
@@ -411,6 +417,43 @@ int SplittingBranchSelector::assertedGroundPositiveEqualityCompomentMaxAge()
   return max;
 }
 
+/**
+ * Make the literals asserted in the decision procedure equal to the
+ * ground literals of @c assignment
+ *
+ * Consecutive models usually differ in a few literals. The levels
+ * above the first asserted literal that is no longer true are popped
+ * and only the missing literals are asserted again.
+ */
+void SplittingBranchSelector::updateDPAssignment(const LiteralStack& assignment)
+{
+  CALL("SplittingBranchSelector::updateDPAssignment");
+
+  static DHSet<Literal*> current;
+  current.reset();
+  current.loadFromIterator(LiteralStack::ConstIterator(assignment));
+
+  unsigned keep = 0;
+  while(keep<_dpAsserted.size() && current.contains(_dpAsserted[keep])) {
+    keep++;
+  }
+  _dp->pop(_dpAsserted.size()-keep);
+  while(_dpAsserted.size()>keep) {
+    _dpAssertedSet.remove(_dpAsserted.pop());
+  }
+
+  LiteralStack::ConstIterator ait(assignment);
+  while(ait.hasNext()) {
+    Literal* lit = ait.next();
+    if(!lit->ground() || !_dpAssertedSet.insert(lit)) {
+      continue;
+    }
+    _dp->push();
+    _dp->addLiterals(pvi(getSingletonIterator(lit)));
+    _dpAsserted.push(lit);
+  }
+}
+
 SATSolver::Status SplittingBranchSelector::processDPConflicts()
 {
   CALL("SplittingBranchSelector::processDPConflicts");
@@ -433,8 +476,7 @@ SATSolver::Status SplittingBranchSelector::processDPConflicts()
       s2f.collectAssignment(*_solver, gndAssignment); 
       // ... moreover, _dp->addLiterals will filter the set anyway
 
-      _dp->reset();
-      _dp->addLiterals(pvi( LiteralStack::ConstIterator(gndAssignment) ));
+      updateDPAssignment(gndAssignment);
       DecisionProcedure::Status dpStatus = _dp->getStatus(_ccMultipleCores);
 
       if(dpStatus!=DecisionProcedure::UNSATISFIABLE) {
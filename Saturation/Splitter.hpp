@@ -29,6 +29,7 @@
 #include "Lib/Allocator.hpp"
 #include "Lib/ArrayMap.hpp"
 #include "Lib/DHMap.hpp"
+#include "Lib/DHSet.hpp"
 #include "Lib/Stack.hpp"
 #include "Lib/ScopedPtr.hpp"
 
@@ -88,6 +89,7 @@ _solver=0;
 
 private:
   SATSolver::Status processDPConflicts();
+  void updateDPAssignment(const LiteralStack& assignment);
   SATSolver::VarAssignment getSolverAssimentConsideringCCModel(unsigned var);
 
   void handleSatRefutation();
@@ -107,6 +109,12 @@ private:
 
   SATSolverSCP _solver;
   ScopedPtr<DecisionProcedure> _dp;
+  /**
+   * Ground literals asserted in _dp, each on its own level,
+   * so that only the difference between two models needs to be processed
+   */
+  LiteralStack _dpAsserted;
+  DHSet<Literal*> _dpAssertedSet;
   // use a separate copy of the decision procedure for ccModel computations and fill it up only with equalities
   ScopedPtr<SimpleCongruenceClosure> _dpModel;
   
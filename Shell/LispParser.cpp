@@ -170,6 +170,93 @@ void LispParser::parse(List** expr0)
 
 } // parse()
 
+/**
+ * Read the next top-level expression from the lexer and return it,
+ * or return 0 if the input is exhausted.
+ *
+ * Unlike parse(), this reads only as much input as the returned
+ * expression spans, so that a caller can process a file one command
+ * at a time and release each command by destroy() before reading
+ * the next one.
+ */
+LispParser::Expression* LispParser::parseNext()
+{
+  CALL("LispParser::parseNext");
+  ASS_EQ(_balance,0);
+
+  static Stack<Expression*> open;
+  static Stack<List**> tails;
+  open.reset();
+  tails.reset();
+
+  Token t;
+  for(;;) {
+    _lexer.readToken(t);
+    Expression* done;
+    switch (t.tag) {
+    case TT_LPAR:
+      _balance++;
+      {
+        Expression* subexpr = new Expression(LIST);
+        open.push(subexpr);
+        tails.push(&subexpr->list);
+      }
+      continue;
+    case TT_RPAR:
+      if (_balance == 0) {
+        throw Exception("unmatched right parenthesis",t);
+      }
+      _balance--;
+      tails.pop();
+      done = open.pop();
+      break;
+    case TT_NAME:
+    case TT_INTEGER:
+    case TT_REAL:
+      done = new Expression(ATOM,t.text);
+      break;
+    case TT_EOF:
+      if (_balance == 0) {
+        return 0;
+      }
+      throw Exception("unmatched left parenthesis",t);
+    default:
+      ASSERTION_VIOLATION;
+    }
+
+    if (open.isEmpty()) {
+      return done;
+    }
+    List* sub = new List(done);
+    List**& tail = tails.top();
+    *tail = sub;
+    tail = sub->tailPtr();
+  }
+} // parseNext()
+
+/**
+ * Delete expression @c expr together with all its subexpressions.
+ */
+void LispParser::destroy(Expression* expr)
+{
+  CALL("LispParser::destroy");
+
+  static Stack<Expression*> todo;
+  todo.reset();
+  todo.push(expr);
+  while (todo.isNonEmpty()) {
+    Expression* e = todo.pop();
+    List* l = e->list;
+    while (l) {
+      todo.push(l->head());
+      List* next = l->tail();
+      delete l;
+      l = next;
+    }
+    delete e;
+  }
+} // destroy()
+
 /**
  * Return a LISP string corresponding to this expression
  * @since 26/08/2009 Redmond
@@ -96,6 +96,9 @@ public:
   explicit LispParser(LispLexer& lexer);
   Expression* parse();
   void parse(List**);
+  Expression* parseNext();
+
+  static void destroy(Expression* expr);
 
   /**
    * Class Exception. Implements parser exceptions.
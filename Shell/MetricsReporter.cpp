@@ -0,0 +1,159 @@
+/*
+ * File MetricsReporter.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file MetricsReporter.cpp
+ * Implements class MetricsReporter.
+ */
+
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "Lib/Allocator.hpp"
+#include "Lib/Int.hpp"
+#include "Lib/System.hpp"
+#include "Lib/TimeCounter.hpp"
+
+#include "Saturation/SaturationAlgorithm.hpp"
+
+#include "Options.hpp"
+#include "Statistics.hpp"
+
+#include "MetricsReporter.hpp"
+
+namespace Shell
+{
+
+using namespace std;
+using namespace Saturation;
+
+int MetricsReporter::s_fd = -1;
+int MetricsReporter::s_nextSnapshot = 0;
+unsigned MetricsReporter::s_interval = 0;
+vstring MetricsReporter::s_slice;
+
+/**
+ * Open the metrics file if the metrics option is set. Must be called
+ * before the portfolio mode forks the slices.
+ */
+void MetricsReporter::init()
+{
+  CALL("MetricsReporter::init");
+
+  vstring fileName = env.options->metrics();
+  if (fileName=="off") {
+    return;
+  }
+  s_fd = open(fileName.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+  if (s_fd<0) {
+    USER_ERROR("Cannot open metrics file "+fileName);
+  }
+  s_interval = env.options->metricsInterval();
+  s_nextSnapshot = env.timer->elapsedMilliseconds()+s_interval;
+}
+
+/**
+ * Called in a child of the portfolio mode which runs @c slice. The timer
+ * of the child is restarted from zero.
+ */
+void MetricsReporter::startSlice(const vstring& slice)
+{
+  CALL("MetricsReporter::startSlice");
+
+  s_slice = slice;
+  s_nextSnapshot = s_interval;
+}
+
+void MetricsReporter::onChildSpawned(pid_t child, const vstring& slice)
+{
+  CALL("MetricsReporter::onChildSpawned");
+
+  if (s_fd<0) {
+    return;
+  }
+  vostringstream record;
+  record << "{\"event\":\"spawn\",\"pid\":" << getpid() << ",\"time\":" << env.timer->elapsedMilliseconds()
+         << ",\"child\":" << child << ",\"slice\":\"" << slice << "\"}\n";
+  writeRecord(record.str());
+}
+
+void MetricsReporter::onChildExited(pid_t child, int code)
+{
+  CALL("MetricsReporter::onChildExited");
+
+  if (s_fd<0) {
+    return;
+  }
+  vostringstream record;
+  record << "{\"event\":\"exit\",\"pid\":" << getpid() << ",\"time\":" << env.timer->elapsedMilliseconds()
+         << ",\"child\":" << child << ",\"code\":" << code << "}\n";
+  writeRecord(record.str());
+}
+
+void MetricsReporter::writeSnapshot()
+{
+  CALL("MetricsReporter::writeSnapshot");
+  ASS_GE(s_fd,0);
+
+  int now = env.timer->elapsedMilliseconds();
+  s_nextSnapshot = now+s_interval;
+
+  SaturationAlgorithm::tryUpdateFinalClauseCount();
+
+  vostringstream record;
+  record << "{\"event\":\"snapshot\",\"pid\":" << getpid() << ",\"time\":" << now;
+  if (!s_slice.empty()) {
+    record << ",\"slice\":\"" << s_slice << "\"";
+  }
+  record << ",\"phase\":\"" << Statistics::phaseToString(env.statistics->phase) << "\""
+         << ",\"memory\":" << Allocator::getUsedMemory()
+         << ",\"active\":" << env.statistics->finalActiveClauses
+         << ",\"passive\":" << env.statistics->finalPassiveClauses
+         << ",\"counters\":{";
+  env.statistics->printCounters(record, true);
+  record << "},\"time_counters\":{";
+  TimeCounter::printJson(record);
+  record << "}}\n";
+  writeRecord(record.str());
+}
+
+void MetricsReporter::writeRecord(const vstring& record)
+{
+  CALL("MetricsReporter::writeRecord");
+
+  // a single write to a file opened for appending is not interleaved
+  // with the records of the other processes
+  const char* data = record.c_str();
+  size_t left = record.size();
+  while (left) {
+    ssize_t written = write(s_fd, data, left);
+    if (written<0) {
+      if (errno==EINTR) {
+        continue;
+      }
+      // metrics are not essential, stop reporting
+      close(s_fd);
+      s_fd = -1;
+      return;
+    }
+    data += written;
+    left -= written;
+  }
+}
+
+}
@@ -0,0 +1,78 @@
+/*
+ * File MetricsReporter.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file MetricsReporter.hpp
+ * Defines class MetricsReporter.
+ */
+
+#ifndef __MetricsReporter__
+#define __MetricsReporter__
+
+#include <sys/types.h>
+
+#include "Lib/Environment.hpp"
+#include "Lib/Timer.hpp"
+#include "Lib/VString.hpp"
+
+namespace Shell {
+
+using namespace Lib;
+
+/**
+ * Appends snapshots of the statistics to the file given by the metrics
+ * option, one JSON object per line
+ *
+ * Snapshots are only taken at the points where poll() is called, never
+ * from a signal handler, so the counters are in a consistent state. Each
+ * record is written by a single write() to a file opened for appending,
+ * so the processes of a portfolio run can share the file: the parent
+ * records which slice each child runs and how it ended, and the records
+ * of the children carry their pid.
+ */
+class MetricsReporter
+{
+public:
+  static void init();
+  static void startSlice(const vstring& slice);
+  static void onChildSpawned(pid_t child, const vstring& slice);
+  static void onChildExited(pid_t child, int code);
+
+  /** Write a snapshot if one is due */
+  static void poll()
+  {
+    if (s_fd>=0 && env.timer->elapsedMilliseconds()>=s_nextSnapshot) {
+      writeSnapshot();
+    }
+  }
+
+  static void writeSnapshot();
+
+private:
+  static void writeRecord(const vstring& record);
+
+  /** the metrics file, or -1 if the metrics are not reported */
+  static int s_fd;
+  static int s_nextSnapshot;
+  static unsigned s_interval;
+  /** the slice run by this process in portfolio mode */
+  static vstring s_slice;
+};
+
+}
+
+#endif // __MetricsReporter__
@@ -132,6 +132,8 @@ void NewCNF::clausify(FormulaUnit* unit,Stack<Clause*>& output)
     }
   }
 
+  _arena.release();
+
   ASS(_queue.isEmpty());
   ASS(_occurrences.isEmpty());
 }
@@ -483,7 +485,7 @@ void NewCNF::processBoolVar(SIGN sign, unsigned var, Occurrences &occurrences)
 
     if (!bound) {
       Term* constant = (occurrenceSign == POSITIVE) ? Term::foolFalse() : Term::foolTrue();
-      _bindingStore.pushAndRemember(Binding(var, constant), occ.gc->bindings);
+      pushBinding(Binding(var, constant), occ.gc->bindings);
       removeGenLit(occ);
       continue;
     }
@@ -968,12 +970,12 @@ void NewCNF::skolemise(QuantifiedFormula* g, BindingList*& bindings, BindingList
   // extend the given binding
   BindingList::Iterator it(processedBindings);
   while (it.hasNext()) {
-    _bindingStore.pushAndRemember(it.next(),bindings);
+    pushBinding(it.next(),bindings);
   }
 
   BindingList::Iterator fit(processedFoolBindings);
   while (fit.hasNext()) {
-    _foolBindingStore.pushAndRemember(fit.next(),foolBindings);
+    pushBinding(fit.next(),foolBindings);
   }
 }
 
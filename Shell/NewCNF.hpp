@@ -25,9 +25,9 @@
 #ifndef __NEWCNF__
 #define __NEWCNF__
 
+#include "Lib/Arena.hpp"
 #include "Lib/Stack.hpp"
 #include "Lib/List.hpp"
-#include "Lib/DArray.hpp"
 #include "Lib/Deque.hpp"
 #include "Lib/STLAllocator.hpp"
 #include "Lib/SmartPtr.hpp"
@@ -96,25 +96,17 @@ private:
 
   typedef List<Binding> BindingList;
 
-  // all allocations of shared BindingLists should go via BindingStore so that they get destroyed in the end
-  struct BindingStore {
-    void pushAndRemember(Binding b, BindingList* &lst) {
-      lst = new BindingList(b,lst);
-      _stored.push(lst);
-    }
-    ~BindingStore() {
-      Stack<BindingList*>::Iterator it(_stored);
-      while(it.hasNext()) {
-        BindingList* cell = it.next();
-        delete cell;
-      }
-    }
-  private:
-    Stack<BindingList*> _stored;
-  };
+  /**
+   * Objects that do not outlive the clausification of one formula: the
+   * literals of GenClauses, shared BindingLists and the temporary lists
+   * of GenLits. Released at the end of clausify().
+   */
+  Arena _arena;
 
-  BindingStore _bindingStore;
-  BindingStore _foolBindingStore;
+  // all allocations of shared BindingLists should go via pushBinding so that they get released in the end
+  void pushBinding(Binding b, BindingList* &lst) {
+    lst = ::new(_arena.allocate(sizeof(BindingList))) BindingList(b,lst);
+  }
 
   struct BindingGetVarFunctor
   {
@@ -147,8 +139,8 @@ private:
     CLASS_NAME(NewCNF::GenClause);
     USE_ALLOCATOR(NewCNF::GenClause);
 
-    GenClause(unsigned size, BindingList* bindings, BindingList* foolBindings)
-      : valid(true), bindings(bindings), foolBindings(foolBindings), _literals(size), _size(0) {}
+    GenClause(GenLit* literals, BindingList* bindings, BindingList* foolBindings)
+      : valid(true), bindings(bindings), foolBindings(foolBindings), _literals(literals), _size(0) {}
 
     bool valid; // used for lazy deletion from Occurrences(s); see below
 
@@ -156,29 +148,28 @@ private:
     BindingList* foolBindings;
     // we could/should carry bindings on the GenLits-level; but GenClause seems sufficient as long as we are rectified
 
-    DArray<GenLit> _literals; // TODO: remove the extra indirection and allocate inside GenClause
+    GenLit* _literals; // allocated in the arena of NewCNF
     unsigned _size;
 
     struct Iterator {
-      Iterator(DArray<GenLit>::Iterator iter, unsigned left) : _iter(iter), _left(left) {}
+      Iterator(GenLit* literals, unsigned left) : _current(literals), _left(left) {}
 
       bool hasNext() {
-        if (_left == 0) return false;
-        return _iter.hasNext();
+        return _left != 0;
       }
 
       GenLit next() {
         _left--;
-        return _iter.next();
+        return *_current++;
       }
 
       private:
-        DArray<GenLit>::Iterator _iter;
+        GenLit* _current;
         unsigned _left;
     };
 
     Iterator genLiterals() {
-      return Iterator(DArray<GenLit>::Iterator(_literals), _size);
+      return Iterator(_literals, _size);
     }
 
     unsigned size() {
@@ -435,7 +426,8 @@ private:
   };
 
   SPGenClause makeGenClause(List<GenLit>* gls, BindingList* bindings, BindingList* foolBindings) {
-    SPGenClause gc = SPGenClause(new GenClause(List<GenLit>::length(gls), bindings, foolBindings));
+    unsigned size = List<GenLit>::length(gls);
+    SPGenClause gc = SPGenClause(new GenClause(_arena.allocateArray<GenLit>(size), bindings, foolBindings));
 
     ASS(_literalsCache.isEmpty());
     ASS(_formulasCache.isEmpty());
@@ -477,12 +469,17 @@ private:
     }
   }
 
+  // a temporary list cell, released with the arena
+  List<GenLit>* genLits(GenLit gl, List<GenLit>* tail=List<GenLit>::empty()) {
+    return ::new(_arena.allocate(sizeof(List<GenLit>))) List<GenLit>(gl, tail);
+  }
+
   void introduceGenClause(GenLit gl, BindingList* bindings=BindingList::empty(), BindingList* foolBindings=BindingList::empty()) {
-    introduceGenClause(new List<GenLit>(gl), bindings, foolBindings);
+    introduceGenClause(genLits(gl), bindings, foolBindings);
   }
 
   void introduceGenClause(GenLit gl0, GenLit gl1, BindingList* bindings=BindingList::empty(), BindingList* foolBindings=BindingList::empty()) {
-    introduceGenClause(new List<GenLit>(gl0, new List<GenLit>(gl1)), bindings, foolBindings);
+    introduceGenClause(genLits(gl0, genLits(gl1)), bindings, foolBindings);
   }
 
   void introduceExtendedGenClause(Occurrence occ, List<GenLit>* gls) {
@@ -492,7 +489,7 @@ private:
     unsigned position = occ.position;
 
     unsigned size = gc->size() + List<GenLit>::length(gls) - 1;
-    SPGenClause newGc = SPGenClause(new GenClause(size, gc->bindings, gc->foolBindings));
+    SPGenClause newGc = SPGenClause(new GenClause(_arena.allocateArray<GenLit>(size), gc->bindings, gc->foolBindings));
 
     ASS(_literalsCache.isEmpty());
     ASS(_formulasCache.isEmpty());
@@ -543,11 +540,11 @@ private:
   }
 
   void introduceExtendedGenClause(Occurrence occ, GenLit replacement) {
-    introduceExtendedGenClause(occ, new List<GenLit>(replacement));
+    introduceExtendedGenClause(occ, genLits(replacement));
   }
 
   void introduceExtendedGenClause(Occurrence occ, GenLit replacement, GenLit extension) {
-    introduceExtendedGenClause(occ, new List<GenLit>(replacement, new List<GenLit>(extension)));
+    introduceExtendedGenClause(occ, genLits(replacement, genLits(extension)));
   }
 
   Occurrence pop(Occurrences &occurrences) {
@@ -189,7 +189,8 @@ void Options::Options::init()
     _multicore.reliesOnHard(_mode.is(equal(Mode::CASC)->
         Or(_mode.is(equal(Mode::CASC_SAT)))->
         Or(_mode.is(equal(Mode::SMTCOMP)))->
-        Or(_mode.is(equal(Mode::PORTFOLIO)))));
+        Or(_mode.is(equal(Mode::PORTFOLIO)))->
+        Or(_mode.is(equal(Mode::CLAUSIFY)))));
 
     _ltbLearning = ChoiceOptionValue<LTBLearning>("ltb_learning","ltbl",LTBLearning::OFF,{"on","off","biased"});
     _ltbLearning.description = "Perform learning in LTB mode";
@@ -340,6 +341,21 @@ void Options::Options::init()
     _lookup.insert(&_timeStatistics);
     _timeStatistics.tag(OptionTag::OUTPUT);
 
+    _metrics = StringOptionValue("metrics","","off");
+    _metrics.description="File to which snapshots of the statistics, clause container sizes and memory use are appended "
+      "periodically during saturation, one JSON object per line. In portfolio mode all slices append to the same file "
+      "and the records of the parent tell which slice each process runs. Time measurements are included with time_statistics.";
+    _lookup.insert(&_metrics);
+    _metrics.tag(OptionTag::OUTPUT);
+    _metrics.setExperimental();
+
+    _metricsInterval = UnsignedOptionValue("metrics_interval","",1000);
+    _metricsInterval.description="Interval between two snapshots written to the metrics file, in milliseconds";
+    _lookup.insert(&_metricsInterval);
+    _metricsInterval.tag(OptionTag::OUTPUT);
+    _metricsInterval.setExperimental();
+    _metricsInterval.reliesOn(_metrics.is(notEqual(vstring("off"))));
+
 //*********************** Input  ***********************
 
     _include = StringOptionValue("include","","");
@@ -347,6 +363,14 @@ void Options::Options::init()
     _lookup.insert(&_include);
     _include.tag(OptionTag::INPUT);
 
+    _clausifyBatch = StringOptionValue("clausify_batch","","");
+    _clausifyBatch.description="File listing problems to be clausified, one file name per line. "
+      "The problems are clausified in parallel (see the cores option) and the results are output in the order of the list.";
+    _lookup.insert(&_clausifyBatch);
+    _clausifyBatch.tag(OptionTag::INPUT);
+    _clausifyBatch.reliesOnHard(_mode.is(equal(Mode::CLAUSIFY)));
+    _clausifyBatch.setExperimental();
+
     _inputFile= InputFileOptionValue("input_file","","",this);
     _inputFile.description="Problem file to be solved (if not specified, standard input is used)";
     _lookup.insert(&_inputFile);
@@ -552,6 +576,21 @@ void Options::Options::init()
     _lookup.insert(&_newCNF);
     _newCNF.tag(OptionTag::PREPROCESSING);
 
+    _clausificationWorkers = UnsignedOptionValue("clausification_workers","clw",0);
+    _clausificationWorkers.description="Number of worker processes over which formulas are clausified. "
+      "Values 0 and 1 mean sequential clausification. The result, including the names of the "
+      "introduced symbols, is the same as that of sequential clausification.";
+    _lookup.insert(&_clausificationWorkers);
+    _clausificationWorkers.tag(OptionTag::PREPROCESSING);
+    _clausificationWorkers.setExperimental();
+
+    _preprocessingReport = StringOptionValue("preprocessing_report","","off");
+    _preprocessingReport.description="File into which the statistics of the preprocessing stages "
+      "(units in and out, time and memory) are written as tab separated values.";
+    _lookup.insert(&_preprocessingReport);
+    _preprocessingReport.tag(OptionTag::PREPROCESSING);
+    _preprocessingReport.setExperimental();
+
     _iteInliningThreshold = IntOptionValue("ite_inlining_threshold","", 0);
     _iteInliningThreshold.description="Threashold of inlining of if-then-else expressions. "
                                       "0 means that all expressions are named. "
@@ -851,6 +890,15 @@ void Options::Options::init()
 	    _lookup.insert(&_lrsWeightLimitOnly);
 	    _lrsWeightLimitOnly.tag(OptionTag::LRS);
 
+	    _lrsCostModel = BoolOptionValue("lrs_cost_model","lrscm",false);
+	    _lrsCostModel.description=
+	    "If on, the lrs estimates the number of reachable clauses from a cost model fitted to the time spent on clauses of different weights"
+	    " and from the weights of the passive clauses, otherwise it extrapolates the number of clauses activated so far";
+	    _lookup.insert(&_lrsCostModel);
+	    _lrsCostModel.tag(OptionTag::LRS);
+	    _lrsCostModel.setExperimental();
+	    _lrsCostModel.reliesOn(_saturationAlgorithm.is(equal(SaturationAlgorithm::LRS)));
+
 	    _simulatedTimeLimit = TimeLimitOptionValue("simulated_time_limit","stl",0);
 	    _simulatedTimeLimit.description=
 	    "Time limit in seconds for the purpose of reachability estimations of the LRS saturation algorithm (if 0, the actual time limit is used)";
@@ -1522,12 +1570,13 @@ void Options::Options::init()
 
     _satSolver = ChoiceOptionValue<SatSolver>("sat_solver","sas",SatSolver::MINISAT,
 #if VZ3
-            {"minisat","vampire","z3"});
+            {"minisat","vampire","cdcl","z3"});
 #else
-    {"minisat","vampire"});
+    {"minisat","vampire","cdcl"});
 #endif
     _satSolver.description=
-    "Select the SAT solver to be used throughout the solver. This will be used in AVATAR (for splitting) when the saturation algorithm is discount,lrs or otter and in instance generation for selection and global subsumption.";
+    "Select the SAT solver to be used throughout the solver. This will be used in AVATAR (for splitting) when the saturation algorithm is discount,lrs or otter and in instance generation for selection and global subsumption."
+    " cdcl is an in-house CDCL solver which tracks the clauses each refutation depends on, so that only those are reported as its premises.";
     _lookup.insert(&_satSolver);
     _satSolver.tag(OptionTag::SAT);
     _satSolver.setRandomChoices(
@@ -1566,6 +1615,22 @@ void Options::Options::init()
     _satVarSelector.tag(OptionTag::SAT);
     _satVarSelector.setExperimental();
 
+    _satTrace = StringOptionValue("sat_trace","","off");
+    _satTrace.description="Prefix of files into which the calls received by the SAT solvers of AVATAR, "
+      "global subsumption, instance generation and finite model building are recorded. "
+      "The traces can be replayed against each of the SAT solvers by vsat -replay.";
+    _lookup.insert(&_satTrace);
+    _satTrace.tag(OptionTag::SAT);
+    _satTrace.setExperimental();
+
+    _indexTrace = StringOptionValue("index_trace","","off");
+    _indexTrace.description="Prefix of files into which the operations on the term indices of superposition "
+      "and demodulation are recorded. The traces can be replayed against each of the term indexing "
+      "structures by vcompit -replay.";
+    _lookup.insert(&_indexTrace);
+    _indexTrace.tag(OptionTag::DEVELOPMENT);
+    _indexTrace.setExperimental();
+
     //*************************************************************
     //*********************** which mode or tag?  ************************
     //*************************************************************
@@ -1669,6 +1734,20 @@ void Options::Options::init()
     _activationLimit.setExperimental();
     _lookup.insert(&_activationLimit);
 
+    _checkpoint = StringOptionValue("checkpoint","","off");
+    _checkpoint.description="File into which the changes of the active and passive clause containers are logged, "
+      "so that the saturation can later be resumed from the last logged state by checkpoint_resume.";
+    _lookup.insert(&_checkpoint);
+    _checkpoint.tag(OptionTag::SATURATION);
+    _checkpoint.setExperimental();
+
+    _checkpointResume = StringOptionValue("checkpoint_resume","","off");
+    _checkpointResume.description="Start the saturation from the active and passive clauses logged in this checkpoint "
+      "file instead of the clauses of the problem. The strategy may differ from the one of the logging run.";
+    _lookup.insert(&_checkpointResume);
+    _checkpointResume.tag(OptionTag::SATURATION);
+    _checkpointResume.setExperimental();
+
     _termOrdering = ChoiceOptionValue<TermOrdering>("term_ordering","to", TermOrdering::KBO,
                                                     {"kbo","lpo"});
     _termOrdering.description="The term ordering used by Vampire to orient equations and order literals";
@@ -505,9 +505,10 @@ public:
   /** Possible values for sat_solver */
   enum class SatSolver : unsigned int {
      MINISAT = 0,
-     VAMPIRE = 1
+     VAMPIRE = 1,
+     CDCL = 2
 #if VZ3
-     ,Z3 = 2
+     ,Z3 = 3
 #endif
   };
 
@@ -1840,6 +1841,7 @@ public:
   LTBLearning ltbLearning() const { return _ltbLearning.actualValue; }
   vstring ltbDirectory() const { return _ltbDirectory.actualValue; }
   Mode mode() const { return _mode.actualValue; }
+  void setMode(Mode newVal) { _mode.actualValue = newVal; }
   Schedule schedule() const { return _schedule.actualValue; }
   vstring scheduleName() const { return _schedule.getStringOfValue(_schedule.actualValue); }
   void setSchedule(Schedule newVal) {  _schedule.actualValue = newVal; }
@@ -1857,7 +1859,10 @@ public:
   void setInclude(vstring val) { _include.actualValue = val; }
   vstring logFile() const { return _logFile.actualValue; }
   vstring inputFile() const { return _inputFile.actualValue; }
+  vstring clausifyBatch() const { return _clausifyBatch.actualValue; }
   int activationLimit() const { return _activationLimit.actualValue; }
+  vstring checkpoint() const { return _checkpoint.actualValue; }
+  vstring checkpointResume() const { return _checkpointResume.actualValue; }
   int randomSeed() const { return _randomSeed.actualValue; }
   int rowVariableMaxLength() const { return _rowVariableMaxLength.actualValue; }
   //void setRowVariableMaxLength(int newVal) { _rowVariableMaxLength = newVal; }
@@ -1939,6 +1944,7 @@ public:
   bool forwardLiteralRewriting() const { return _forwardLiteralRewriting.actualValue; }
   int lrsFirstTimeCheck() const { return _lrsFirstTimeCheck.actualValue; }
   int lrsWeightLimitOnly() const { return _lrsWeightLimitOnly.actualValue; }
+  bool lrsCostModel() const { return _lrsCostModel.actualValue; }
   int lookaheadDelay() const { return _lookaheadDelay.actualValue; }
   int simulatedTimeLimit() const { return _simulatedTimeLimit.actualValue; }
   void setSimulatedTimeLimit(int newVal) { _simulatedTimeLimit.actualValue = newVal; }
@@ -2002,6 +2008,8 @@ public:
   RuleActivity generalSplitting() const { return _generalSplitting.actualValue; }
   vstring namePrefix() const { return _namePrefix.actualValue; }
   bool timeStatistics() const { return _timeStatistics.actualValue; }
+  vstring metrics() const { return _metrics.actualValue; }
+  unsigned metricsInterval() const { return _metricsInterval.actualValue; }
   bool splitting() const { return _splitting.actualValue; }
   void setSplitting(bool value){ _splitting.actualValue=value; }
   bool nonliteralsInClauseWeight() const { return _nonliteralsInClauseWeight.actualValue; }
@@ -2050,6 +2058,8 @@ public:
   SatRestartStrategy satRestartStrategy() const { return _satRestartStrategy.actualValue; }
   float satVarActivityDecay() const { return _satVarActivityDecay.actualValue; }
   SatVarSelector satVarSelector() const { return _satVarSelector.actualValue; }
+  vstring satTrace() const { return _satTrace.actualValue; }
+  vstring indexTrace() const { return _indexTrace.actualValue; }
 
   Niceness nicenessOption() const { return _nicenessOption.actualValue; }
 
@@ -2096,6 +2106,8 @@ public:
   bool bpStartWithRational() const { return _bpStartWithRational.actualValue;}
     
   bool newCNF() const { return _newCNF.actualValue; }
+  unsigned clausificationWorkers() const { return _clausificationWorkers.actualValue; }
+  vstring preprocessingReport() const { return _preprocessingReport.actualValue; }
   int getIteInliningThreshold() const { return _iteInliningThreshold.actualValue; }
   bool getIteInlineLet() const { return _inlineLet.actualValue; }
 private:
@@ -2228,6 +2240,8 @@ private:
   BoolOptionValue _bpStartWithRational;
   ChoiceOptionValue<BPVariableSelector> _bpVariableSelector;
 
+  UnsignedOptionValue _clausificationWorkers;
+  StringOptionValue _clausifyBatch;
   BoolOptionValue _colorUnblocking;
   ChoiceOptionValue<Condensation> _condensation;
 
@@ -2318,6 +2332,7 @@ private:
   IntOptionValue _lookaheadDelay;
   IntOptionValue _lrsFirstTimeCheck;
   BoolOptionValue _lrsWeightLimitOnly;
+  BoolOptionValue _lrsCostModel;
   ChoiceOptionValue<LTBLearning> _ltbLearning;
   StringOptionValue _ltbDirectory;
 
@@ -2340,6 +2355,7 @@ private:
 
   BoolOptionValue _outputAxiomNames;
 
+  StringOptionValue _preprocessingReport;
   BoolOptionValue _printClausifierPremises;
   StringOptionValue _problemName;
   ChoiceOptionValue<Proof> _proof;
@@ -2354,6 +2370,8 @@ private:
   IntOptionValue _rowVariableMaxLength;
 
   IntOptionValue _activationLimit;
+  StringOptionValue _checkpoint;
+  StringOptionValue _checkpointResume;
 
   FloatOptionValue _satClauseActivityDecay;
   ChoiceOptionValue<SatClauseDisposer> _satClauseDisposer;
@@ -2368,6 +2386,8 @@ private:
   ChoiceOptionValue<SatRestartStrategy> _satRestartStrategy;
   FloatOptionValue _satVarActivityDecay;
   ChoiceOptionValue<SatVarSelector> _satVarSelector;
+  StringOptionValue _satTrace;
+  StringOptionValue _indexTrace;
   ChoiceOptionValue<SatSolver> _satSolver;
   ChoiceOptionValue<SaturationAlgorithm> _saturationAlgorithm;
   BoolOptionValue _selectUnusedVariablesFirst;
@@ -2443,6 +2463,8 @@ private:
   /** Time limit in deciseconds */
   TimeLimitOptionValue _timeLimitInDeciseconds;
   BoolOptionValue _timeStatistics;
+  StringOptionValue _metrics;
+  UnsignedOptionValue _metricsInterval;
 
   ChoiceOptionValue<URResolution> _unitResultingResolution;
   BoolOptionValue _unusedPredicateDefinitionRemoval;
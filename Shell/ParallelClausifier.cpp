@@ -0,0 +1,705 @@
+/*
+ * File ParallelClausifier.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file ParallelClausifier.cpp
+ * Implements class ParallelClausifier.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <climits>
+#include <unistd.h>
+
+#include "Debug/Tracer.hpp"
+
+#include "Lib/Environment.hpp"
+#include "Lib/Exception.hpp"
+#include "Lib/System.hpp"
+#include "Lib/Sys/Multiprocessing.hpp"
+#include "Lib/Varint.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Formula.hpp"
+#include "Kernel/FormulaUnit.hpp"
+#include "Kernel/Inference.hpp"
+#include "Kernel/Signature.hpp"
+#include "Kernel/Sorts.hpp"
+#include "Kernel/SortHelper.hpp"
+#include "Kernel/Term.hpp"
+
+#include "CNF.hpp"
+#include "NewCNF.hpp"
+#include "Statistics.hpp"
+
+#include "ParallelClausifier.hpp"
+
+namespace Shell
+{
+
+using namespace Lib::Sys;
+
+const unsigned ParallelClausifier::MIN_WORKER_WEIGHT;
+
+/** Flags of symbols introduced by a worker */
+enum SymbolFlags {
+  SYM_SKOLEM = 1,
+  SYM_INTRODUCED = 2,
+  SYM_IN_GOAL = 4,
+  SYM_FUNCTION = 8
+};
+
+class ParallelClausifier::Writer
+{
+public:
+  void writeVarint(unsigned val)
+  {
+    Varint::write(val, _buf);
+  }
+
+  void writeString(const vstring& str)
+  {
+    writeVarint(str.size());
+    for(size_t i=0;i<str.size();i++) {
+      _buf.push(static_cast<unsigned char>(str[i]));
+    }
+  }
+
+  /** Write @c t in prefix order */
+  void writeTerm(TermList t)
+  {
+    CALL("ParallelClausifier::Writer::writeTerm");
+
+    static Stack<TermList> todo;
+    ASS(todo.isEmpty());
+    todo.push(t);
+    while(todo.isNonEmpty()) {
+      TermList s = todo.pop();
+      if(s.isVar()) {
+        if(!s.isOrdinaryVar()) {
+          INVALID_OPERATION("special variable in a clause");
+        }
+        writeVarint(s.var()<<1);
+        continue;
+      }
+      Term* trm = s.term();
+      if(trm->isSpecial()) {
+        INVALID_OPERATION("special term in a clause");
+      }
+      writeVarint((trm->functor()<<1)|1);
+      for(unsigned i=trm->arity();i>0;i--) {
+        todo.push(*trm->nthArgument(i-1));
+      }
+    }
+  }
+
+  void writeClause(Clause* cl)
+  {
+    CALL("ParallelClausifier::Writer::writeClause");
+
+    writeVarint(cl->length());
+    for(unsigned i=0;i<cl->length();i++) {
+      Literal* lit = (*cl)[i];
+      writeVarint((lit->functor()<<1) | (lit->polarity() ? 1 : 0));
+      if(lit->isEquality()) {
+        writeVarint(SortHelper::getEqualityArgumentSort(lit));
+      }
+      for(unsigned j=0;j<lit->arity();j++) {
+        writeTerm(*lit->nthArgument(j));
+      }
+    }
+  }
+
+  void append(const Writer& other)
+  {
+    for(size_t i=0;i<other._buf.size();i++) {
+      _buf.push(other._buf[i]);
+    }
+  }
+
+  void save(vstring fileName)
+  {
+    CALL("ParallelClausifier::Writer::save");
+
+    BYPASSING_ALLOCATOR;
+
+    FILE* f = fopen(fileName.c_str(), "wb");
+    if(!f) {
+      SYSTEM_FAIL("Cannot create file "+fileName, errno);
+    }
+    size_t written = fwrite(_buf.begin(), 1, _buf.size(), f);
+    if(fclose(f) || written!=_buf.size()) {
+      SYSTEM_FAIL("Cannot write file "+fileName, errno);
+    }
+  }
+
+private:
+  Stack<unsigned char> _buf;
+};
+
+class ParallelClausifier::Reader
+{
+public:
+  /** Load the content of @c fileName, return false if it cannot be read */
+  bool load(vstring fileName)
+  {
+    CALL("ParallelClausifier::Reader::load");
+
+    _buf.reset();
+    _pos = 0;
+
+    BYPASSING_ALLOCATOR;
+
+    FILE* f = fopen(fileName.c_str(), "rb");
+    if(!f) {
+      return false;
+    }
+    unsigned char chunk[4096];
+    size_t read;
+    while((read = fread(chunk, 1, sizeof(chunk), f))>0) {
+      for(size_t i=0;i<read;i++) {
+        _buf.push(chunk[i]);
+      }
+    }
+    bool ok = !ferror(f);
+    fclose(f);
+    return ok;
+  }
+
+  unsigned readVarint()
+  {
+    unsigned res;
+    const unsigned char* pos = _buf.begin()+_pos;
+    ALWAYS(Varint::read(pos, _buf.end(), res));
+    _pos = pos-_buf.begin();
+    return res;
+  }
+
+  vstring readString()
+  {
+    unsigned len = readVarint();
+    vstring res(reinterpret_cast<const char*>(_buf.begin()+_pos), len);
+    _pos += len;
+    return res;
+  }
+
+private:
+  Stack<unsigned char> _buf;
+  size_t _pos;
+};
+
+ParallelClausifier::ParallelClausifier(bool newCnf, int namingThreshold)
+  : _newCnf(newCnf), _namingThreshold(namingThreshold)
+{
+}
+
+/**
+ * Destroy the clauses that were not taken by @c clausify(), which happens
+ * when the caller stops early after finding an empty clause
+ */
+ParallelClausifier::~ParallelClausifier()
+{
+  CALL("ParallelClausifier::~ParallelClausifier");
+
+  for(unsigned i=0;i<_clauses.size();i++) {
+    while(_clauses[i].isNonEmpty()) {
+      _clauses[i].pop()->destroy();
+    }
+  }
+}
+
+/**
+ * Create an empty result file for each of @c count workers in the
+ * directory given by the TMPDIR environment variable (or /tmp),
+ * return false if that fails
+ *
+ * The files are created by mkstemp in the parent before forking, so
+ * their names cannot be guessed or taken by another process.
+ */
+bool ParallelClausifier::createTempFiles(unsigned count)
+{
+  CALL("ParallelClausifier::createTempFiles");
+
+  BYPASSING_ALLOCATOR;
+
+  const char* dir = getenv("TMPDIR");
+  vstring pattern = vstring(dir && *dir ? dir : "/tmp")+"/vampire_clausify_XXXXXX";
+  for(unsigned i=0;i<count;i++) {
+    DArray<char> name(pattern.size()+1);
+    strcpy(name.array(), pattern.c_str());
+    int fd = mkstemp(name.array());
+    if(fd==-1) {
+      removeTempFiles();
+      return false;
+    }
+    close(fd);
+    _tempFiles.push(vstring(name.array()));
+  }
+  return true;
+}
+
+void ParallelClausifier::removeTempFiles()
+{
+  CALL("ParallelClausifier::removeTempFiles");
+
+  BYPASSING_ALLOCATOR;
+
+  while(_tempFiles.isNonEmpty()) {
+    remove(_tempFiles.pop().c_str());
+  }
+}
+
+/**
+ * Clausify the formula units of @c units over at most @c workerCount
+ * worker processes. Return false if the problem is too small to be split
+ * or if the clausification failed in some worker. In that case the
+ * signature is left unchanged.
+ *
+ * The clauses are obtained afterwards by calling @c clausify().
+ */
+bool ParallelClausifier::run(UnitList* units, unsigned workerCount)
+{
+  CALL("ParallelClausifier::run");
+
+  if(workerCount<2 || env.colorUsed) {
+    return false;
+  }
+
+  Stack<unsigned> weights;
+  unsigned totalWeight = 0;
+  UnitList::Iterator uit(units);
+  while(uit.hasNext()) {
+    Unit* u = uit.next();
+    if(u->isClause()) {
+      continue;
+    }
+    FormulaUnit* fu = static_cast<FormulaUnit*>(u);
+    _units.push(fu);
+    weights.push(fu->formula()->weight());
+    totalWeight += weights.top();
+  }
+  workerCount = min(workerCount, totalWeight/MIN_WORKER_WEIGHT);
+  workerCount = min(workerCount, static_cast<unsigned>(_units.size()));
+  if(workerCount<2) {
+    _units.reset();
+    return false;
+  }
+
+  //contiguous ranges of similar weight
+  _rangeStarts.push(0);
+  unsigned acc = 0;
+  for(unsigned i=0;i+1<_units.size();i++) {
+    acc += weights[i];
+    if(_rangeStarts.size()<workerCount && acc>=(totalWeight/workerCount)*_rangeStarts.size()) {
+      _rangeStarts.push(i+1);
+    }
+  }
+  _rangeStarts.push(_units.size());
+  workerCount = _rangeStarts.size()-1;
+
+  _funCnt = env.signature->functions();
+  _predCnt = env.signature->predicates();
+  _sortCnt = env.sorts->count();
+  _lastUnitNumber = Unit::getLastNumber();
+  unsigned forkUnitNumber = _lastUnitNumber;
+  if(!createTempFiles(workerCount)) {
+    _units.reset();
+    return false;
+  }
+
+  Stack<pid_t> workers;
+  for(unsigned i=0;i<workerCount;i++) {
+    pid_t pid = Multiprocessing::instance()->fork();
+    if(!pid) {
+      System::registerForSIGHUPOnParentDeath();
+      int resultValue = 1;
+      try {
+        runWorker(i);
+        resultValue = 0;
+      }
+      catch(Exception&) {
+      }
+      catch(std::bad_alloc&) {
+      }
+      System::terminateImmediately(resultValue);
+    }
+    workers.push(pid);
+  }
+
+  bool ok = true;
+  for(unsigned i=0;i<workerCount;i++) {
+    int exitCode;
+    Multiprocessing::instance()->waitForParticularChildTermination(workers[i], exitCode);
+    ok &= exitCode==0;
+  }
+
+  _clauses.ensure(_units.size());
+  for(unsigned i=0;i<workerCount && ok;i++) {
+    ok = readResult(i);
+  }
+  removeTempFiles();
+  if(!ok) {
+    ASS_EQ(env.signature->functions(), _funCnt);
+    ASS_EQ(env.signature->predicates(), _predCnt);
+    Unit::setLastNumber(forkUnitNumber);
+    _units.reset();
+    return false;
+  }
+  Unit::setLastNumber(_lastUnitNumber);
+
+  for(unsigned i=0;i<_units.size();i++) {
+    _unitIndexes.insert(_units[i], i);
+  }
+  return true;
+}
+
+/**
+ * Put into @c output the clauses obtained from @c unit, in the same
+ * order as the sequential clausifier would
+ */
+void ParallelClausifier::clausify(Unit* unit, Stack<Clause*>& output)
+{
+  CALL("ParallelClausifier::clausify");
+
+  Stack<Clause*>& clauses = _clauses[_unitIndexes.get(unit)];
+  for(unsigned i=0;i<clauses.size();i++) {
+    output.push(clauses[i]);
+  }
+  clauses.reset();
+}
+
+/**
+ * Clausify the range of worker @c index and save the result
+ */
+void ParallelClausifier::runWorker(unsigned index)
+{
+  CALL("ParallelClausifier::runWorker");
+
+  unsigned formulaNames = env.statistics->formulaNames;
+  unsigned skolemFunctions = env.statistics->skolemFunctions;
+
+  Writer clauseWr;
+  NewCNF newCnf(_namingThreshold);
+  CNF cnf;
+  Stack<Clause*> clauses;
+  for(unsigned i=_rangeStarts[index];i<_rangeStarts[index+1];i++) {
+    clauses.reset();
+    if(_newCnf) {
+      newCnf.clausify(_units[i], clauses);
+    }
+    else {
+      cnf.clausify(_units[i], clauses);
+    }
+    clauseWr.writeVarint(clauses.size());
+    for(unsigned j=0;j<clauses.size();j++) {
+      clauseWr.writeVarint(clauses[j]->number()-_lastUnitNumber);
+      clauseWr.writeClause(clauses[j]);
+    }
+  }
+
+  if(env.sorts->count()!=_sortCnt) {
+    INVALID_OPERATION("new sort introduced by clausification");
+  }
+
+  Writer wr;
+  writeSymbols(wr);
+  wr.writeVarint(env.statistics->formulaNames-formulaNames);
+  wr.writeVarint(env.statistics->skolemFunctions-skolemFunctions);
+  wr.writeVarint(Unit::getLastNumber()-_lastUnitNumber);
+  wr.append(clauseWr);
+  wr.save(_tempFiles[index]);
+}
+
+/**
+ * Return the number assigned to a fresh symbol by the counter of the
+ * signature, or UINT_MAX if @c sym is not a fresh symbol
+ *
+ * The name of a fresh symbol is a prefix, the number and optionally
+ * an underscore and a suffix.
+ */
+static unsigned freshNumber(Signature::Symbol* sym)
+{
+  if(!sym->skolem() && !sym->introduced()) {
+    return UINT_MAX;
+  }
+  const vstring& name = sym->name();
+  size_t pos = 0;
+  while(pos<name.size() && (name[pos]<'0' || name[pos]>'9')) {
+    pos++;
+  }
+  unsigned res = 0;
+  while(pos<name.size() && name[pos]>='0' && name[pos]<='9') {
+    res = res*10+(name[pos]-'0');
+    pos++;
+  }
+  return res;
+}
+
+/**
+ * Write the symbols introduced by this worker
+ *
+ * Fresh functions and predicates share a counter in the signature, so
+ * the two kinds of symbols are written interleaved in the order in which
+ * the counter assigned them. The parent can then create them in the same
+ * order and get the names the sequential clausifier would give them.
+ */
+void ParallelClausifier::writeSymbols(Writer& wr)
+{
+  CALL("ParallelClausifier::writeSymbols");
+
+  unsigned funCnt = env.signature->functions();
+  unsigned predCnt = env.signature->predicates();
+  wr.writeVarint(funCnt-_funCnt+predCnt-_predCnt);
+
+  unsigned fn = _funCnt;
+  unsigned pred = _predCnt;
+  while(fn<funCnt || pred<predCnt) {
+    bool function;
+    if(fn==funCnt || pred==predCnt) {
+      function = fn<funCnt;
+    }
+    else {
+      unsigned fnNum = freshNumber(env.signature->getFunction(fn));
+      unsigned predNum = freshNumber(env.signature->getPredicate(pred));
+      //symbols that are not fresh do not use the counter and can go first
+      function = fnNum==UINT_MAX || (predNum!=UINT_MAX && fnNum<predNum);
+    }
+    Signature::Symbol* sym = function ? env.signature->getFunction(fn++) : env.signature->getPredicate(pred++);
+    if(sym->interpreted()) {
+      INVALID_OPERATION("interpreted symbol introduced by clausification");
+    }
+    unsigned flags = 0;
+    if(function) {
+      flags |= SYM_FUNCTION;
+    }
+    if(sym->skolem()) {
+      flags |= SYM_SKOLEM;
+    }
+    if(sym->introduced()) {
+      flags |= SYM_INTRODUCED;
+    }
+    if(sym->inGoal()) {
+      flags |= SYM_IN_GOAL;
+    }
+    wr.writeString(sym->name());
+    wr.writeVarint(sym->arity());
+    wr.writeVarint(flags);
+    OperatorType* type = function ? sym->fnType() : sym->predType();
+    for(unsigned j=0;j<sym->arity();j++) {
+      wr.writeVarint(type->arg(j));
+    }
+    if(function) {
+      wr.writeVarint(type->result());
+    }
+  }
+}
+
+/**
+ * Add symbols introduced by a worker into the signature, and into
+ * @c funMap and @c predMap the parent's number of each of the worker's
+ * symbols
+ *
+ * Fresh symbols are renamed by the counter of the parent's signature,
+ * the rest of the name (such as the sK prefix) is kept.
+ */
+void ParallelClausifier::readSymbols(Reader& rd, DArray<unsigned>& funMap, DArray<unsigned>& predMap)
+{
+  CALL("ParallelClausifier::readSymbols");
+
+  unsigned cnt = rd.readVarint();
+  funMap.ensure(_funCnt+cnt);
+  predMap.ensure(_predCnt+cnt);
+  for(unsigned i=0;i<_funCnt;i++) {
+    funMap[i] = i;
+  }
+  for(unsigned i=0;i<_predCnt;i++) {
+    predMap[i] = i;
+  }
+  unsigned nextFn = _funCnt;
+  unsigned nextPred = _predCnt;
+
+  static Stack<unsigned> sorts;
+  for(unsigned i=0;i<cnt;i++) {
+    vstring name = rd.readString();
+    unsigned arity = rd.readVarint();
+    unsigned flags = rd.readVarint();
+    bool function = flags & SYM_FUNCTION;
+    sorts.reset();
+    for(unsigned j=0;j<arity;j++) {
+      sorts.push(rd.readVarint());
+    }
+    unsigned resultSort = function ? rd.readVarint() : 0;
+
+    //skip the prefix and the number
+    size_t pos = 0;
+    while(pos<name.size() && (name[pos]<'0' || name[pos]>'9')) {
+      pos++;
+    }
+    vstring prefix = name.substr(0, pos);
+    while(pos<name.size() && name[pos]>='0' && name[pos]<='9') {
+      pos++;
+    }
+    vstring suffix;
+    bool hasSuffix = pos<name.size() && name[pos]=='_';
+    if(hasSuffix) {
+      suffix = name.substr(pos+1);
+    }
+    const char* suf = hasSuffix ? suffix.c_str() : 0;
+
+    unsigned res;
+    bool added = true;
+    if(function) {
+      if(flags & SYM_SKOLEM) {
+        res = env.signature->addSkolemFunction(arity, suf);
+      }
+      else if(flags & SYM_INTRODUCED) {
+        res = env.signature->addFreshFunction(arity, prefix.c_str(), suf);
+      }
+      else {
+        res = env.signature->addFunction(name, arity, added);
+      }
+      if(added) {
+        env.signature->getFunction(res)->setType(
+            OperatorType::getFunctionType(arity, sorts.begin(), resultSort));
+      }
+      funMap[nextFn++] = res;
+    }
+    else {
+      if(flags & SYM_SKOLEM) {
+        res = env.signature->addSkolemPredicate(arity, suf);
+      }
+      else if(flags & SYM_INTRODUCED) {
+        res = env.signature->addFreshPredicate(arity, prefix.c_str(), suf);
+      }
+      else {
+        res = env.signature->addPredicate(name, arity, added);
+      }
+      if(added) {
+        env.signature->getPredicate(res)->setType(
+            OperatorType::getPredicateType(arity, sorts.begin()));
+      }
+      predMap[nextPred++] = res;
+    }
+    if(flags & SYM_IN_GOAL) {
+      Signature::Symbol* sym = function ? env.signature->getFunction(res) : env.signature->getPredicate(res);
+      sym->markInGoal();
+    }
+  }
+}
+
+TermList ParallelClausifier::readTerm(Reader& rd, const DArray<unsigned>& funMap)
+{
+  CALL("ParallelClausifier::readTerm");
+
+  //functors of the terms being read, with the position of their first argument in args
+  static Stack<pair<unsigned,unsigned> > open;
+  static Stack<TermList> args;
+  ASS(open.isEmpty());
+  ASS(args.isEmpty());
+
+  for(;;) {
+    unsigned code = rd.readVarint();
+    TermList res;
+    if(!(code&1)) {
+      res = TermList(code>>1, false);
+    }
+    else {
+      unsigned fn = funMap[code>>1];
+      if(env.signature->functionArity(fn)) {
+        open.push(make_pair(fn, args.size()));
+        continue;
+      }
+      res = TermList(Term::createConstant(fn));
+    }
+
+    for(;;) {
+      if(open.isEmpty()) {
+        return res;
+      }
+      args.push(res);
+      unsigned fn = open.top().first;
+      unsigned start = open.top().second;
+      unsigned arity = env.signature->functionArity(fn);
+      if(args.size()-start<arity) {
+        break;
+      }
+      res = TermList(Term::create(fn, arity, args.begin()+start));
+      args.truncate(start);
+      open.pop();
+    }
+  }
+}
+
+/**
+ * Read the output of worker @c index, return false if it cannot be read
+ */
+bool ParallelClausifier::readResult(unsigned index)
+{
+  CALL("ParallelClausifier::readResult");
+
+  Reader rd;
+  if(!rd.load(_tempFiles[index])) {
+    return false;
+  }
+
+  DArray<unsigned> funMap;
+  DArray<unsigned> predMap;
+  readSymbols(rd, funMap, predMap);
+  env.statistics->formulaNames += rd.readVarint();
+  env.statistics->skolemFunctions += rd.readVarint();
+  //clauses get the numbers that sequential clausification would give them
+  unsigned unitBase = _lastUnitNumber;
+  _lastUnitNumber += rd.readVarint();
+
+  static Stack<Literal*> lits;
+  static Stack<TermList> args;
+  for(unsigned i=_rangeStarts[index];i<_rangeStarts[index+1];i++) {
+    FormulaUnit* unit = _units[i];
+    unsigned clauseCnt = rd.readVarint();
+    for(unsigned j=0;j<clauseCnt;j++) {
+      unsigned number = unitBase+rd.readVarint();
+      unsigned len = rd.readVarint();
+      lits.reset();
+      for(unsigned k=0;k<len;k++) {
+        unsigned header = rd.readVarint();
+        unsigned pred = predMap[header>>1];
+        bool polarity = header&1;
+        if(pred==0) {
+          unsigned sort = rd.readVarint();
+          TermList lhs = readTerm(rd, funMap);
+          TermList rhs = readTerm(rd, funMap);
+          lits.push(Literal::createEquality(polarity, lhs, rhs, sort));
+          continue;
+        }
+        unsigned arity = env.signature->predicateArity(pred);
+        args.reset();
+        for(unsigned a=0;a<arity;a++) {
+          args.push(readTerm(rd, funMap));
+        }
+        lits.push(Literal::create(pred, arity, polarity, false, args.begin()));
+      }
+      Inference* inf = new Inference1(Inference::CLAUSIFY, unit);
+      Unit::setLastNumber(number-1);
+      _clauses[i].push(Clause::fromStack(lits, unit->inputType(), inf));
+    }
+  }
+  return true;
+}
+
+}
@@ -0,0 +1,114 @@
+/*
+ * File ParallelClausifier.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file ParallelClausifier.hpp
+ * Defines class ParallelClausifier.
+ */
+
+#ifndef __ParallelClausifier__
+#define __ParallelClausifier__
+
+#include "Forwards.hpp"
+
+#include "Lib/DArray.hpp"
+#include "Lib/DHMap.hpp"
+#include "Lib/Stack.hpp"
+#include "Lib/VString.hpp"
+
+namespace Shell {
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * Clausifies the formula units of a problem over a number of worker processes
+ *
+ * The signature, term sharing and the allocator are global and not
+ * thread safe, so the workers are processes forked from the caller. The
+ * formula units are split into contiguous ranges of similar total weight,
+ * one per worker. Each worker clausifies its range (by NewCNF or CNF)
+ * and writes the clauses and the symbols it has introduced into a
+ * temporary file.
+ *
+ * The parent then reads the files in the order of the ranges. Symbols
+ * introduced by a worker are added to the signature again, with fresh
+ * names from the parent's counter, so they are numbered deterministically
+ * and do not clash between workers. Clauses are rebuilt in the order of
+ * the input and get the same CLAUSIFY inference as in sequential
+ * clausification.
+ *
+ * If anything the parent cannot reproduce happens in a worker (such as
+ * a new sort or a new interpreted symbol), @c run() fails and the caller
+ * is to clausify sequentially.
+ */
+class ParallelClausifier
+{
+public:
+  CLASS_NAME(ParallelClausifier);
+  USE_ALLOCATOR(ParallelClausifier);
+
+  ParallelClausifier(bool newCnf, int namingThreshold);
+  ~ParallelClausifier();
+
+  bool run(UnitList* units, unsigned workerCount);
+  void clausify(Unit* unit, Stack<Clause*>& output);
+
+private:
+  class Writer;
+  class Reader;
+
+  void runWorker(unsigned index);
+  void writeSymbols(Writer& wr);
+  bool readResult(unsigned index);
+  void readSymbols(Reader& rd, DArray<unsigned>& funMap, DArray<unsigned>& predMap);
+  TermList readTerm(Reader& rd, const DArray<unsigned>& funMap);
+  bool createTempFiles(unsigned count);
+  void removeTempFiles();
+
+  /** Workers are not started for less than this total weight per worker */
+  static const unsigned MIN_WORKER_WEIGHT = 2000;
+
+  bool _newCnf;
+  int _namingThreshold;
+
+  /** The formula units to be clausified */
+  Stack<FormulaUnit*> _units;
+  /** Worker @c i clausifies units from _rangeStarts[i] to _rangeStarts[i+1] */
+  Stack<unsigned> _rangeStarts;
+  /** Clauses of each of the formula units, in the order of the output of the clausifier */
+  DArray<Stack<Clause*> > _clauses;
+  DHMap<Unit*,unsigned> _unitIndexes;
+
+  /** Sizes of the signature at the time the workers were forked */
+  unsigned _funCnt;
+  unsigned _predCnt;
+  unsigned _sortCnt;
+  /**
+   * Number of the last unit at the time the workers were forked, and
+   * while reading the results, the number of the last unit of the ranges
+   * read so far
+   */
+  unsigned _lastUnitNumber;
+
+  /** Result file of each worker */
+  Stack<vstring> _tempFiles;
+};
+
+}
+
+#endif // __ParallelClausifier__
@@ -23,9 +23,9 @@
  * @since 02/06/2007 Manchester, changed to new datastructures
  */
 
-#include "Debug/Tracer.hpp"
+#include <fstream>
 
-#include "Lib/ScopedLet.hpp"
+#include "Debug/Tracer.hpp"
 
 #include "Kernel/Unit.hpp"
 #include "Kernel/Clause.hpp"
@@ -47,8 +47,10 @@
 #include "Normalisation.hpp"
 #include "NNF.hpp"
 #include "Options.hpp"
+#include "ParallelClausifier.hpp"
 #include "PredicateDefinition.hpp"
 #include "Preprocess.hpp"
+#include "PreprocessingPipeline.hpp"
 #include "Property.hpp"
 #include "Rectify.hpp"
 #include "Skolem.hpp"
@@ -148,6 +150,286 @@ void Preprocess::unfoldEqualities(ConstraintRCList*& constraints)
 }
 #endif //GNUMP
 
+/**
+ * Preprocess the unit using options from opt. Preprocessing may
+ * involve inferences and replacement of this unit by a newly inferred one.
+ * Preprocessing formula units consists of the following steps:
+ * <ol>
+ *   <li>Rectify the formula and memorise the answer atom, if necessary.</li>
+ *   <li>Flatten the formula.</li>
+ * </ol>
+ *
+ * Preprocessing clause does not change it.
+ *
+ * Units passed to preprocess1 must not have any special terms, let..in formulas
+ * or terms, or if-then-else terms. It may contain if-then-else formulas.
+ */
+class Preprocess::Preprocess1Stage
+: public PreprocessingPipeline::UnitStage
+{
+public:
+  CLASS_NAME(Preprocess::Preprocess1Stage);
+  USE_ALLOCATOR(Preprocess::Preprocess1Stage);
+
+  Preprocess1Stage(const Options& options)
+  : UnitStage("preprocess1", Statistics::PREPROCESS_1),
+    _options(options), _formulasSimplified(false) {}
+
+  void apply(Unit* u, Stack<Unit*>& out) override
+  {
+    CALL("Preprocess::Preprocess1Stage::apply");
+
+    if (u->isClause()) {
+      out.push(u);
+      return;
+    }
+
+    // formula unit
+    FormulaUnit* fu = static_cast<FormulaUnit*>(u);
+    // Rectify the formula and memorise the answer atom, if necessary
+    fu = Rectify::rectify(fu);
+    FormulaUnit* rectFu = fu;
+    // Simplify the formula if it contains true or false
+    if (!_options.newCNF()) {
+      // NewCNF effectively implements this simplification already
+      fu = SimplifyFalseTrue::simplify(fu);
+    }
+    if (fu!=rectFu) {
+      _formulasSimplified = true;
+    }
+    fu = Flattening::flatten(fu);
+    out.push(fu);
+  }
+
+  void finish(Problem& prb) override
+  {
+    if (_formulasSimplified) {
+      prb.invalidateByRemoval();
+    }
+  }
+private:
+  const Options& _options;
+  bool _formulasSimplified;
+};
+
+/**
+ * Preprocess the units using options from opt. Preprocessing may
+ * involve inferences and replacement of this unit by a newly inferred one.
+ * Preprocessing formula units consists of the following steps:
+ * <ol>
+ *   <li>Transform the formula to ENNF.</li>
+ *   <li>Flatten it.</li>
+ * </ol>
+ * @since 14/07/2005 flight Tel-Aviv-Barcelona changed to stop before naming
+ */
+class Preprocess::Preprocess2Stage
+: public PreprocessingPipeline::UnitStage
+{
+public:
+  CLASS_NAME(Preprocess::Preprocess2Stage);
+  USE_ALLOCATOR(Preprocess::Preprocess2Stage);
+
+  Preprocess2Stage() : UnitStage("preprocess2", Statistics::PREPROCESS_2) {}
+
+  void apply(Unit* u, Stack<Unit*>& out) override
+  {
+    CALL("Preprocess::Preprocess2Stage::apply");
+
+    if (u->isClause()) {
+      out.push(u);
+      return;
+    }
+    FormulaUnit* fu = static_cast<FormulaUnit*>(u);
+
+    fu = NNF::ennf(fu);
+    fu = Flattening::flatten(fu);
+    out.push(fu);
+  }
+};
+
+/**
+ * Perform naming on units which are in ENNF
+ */
+class Preprocess::NamingStage
+: public PreprocessingPipeline::UnitStage
+{
+public:
+  CLASS_NAME(Preprocess::NamingStage);
+  USE_ALLOCATOR(Preprocess::NamingStage);
+
+  NamingStage(const Options& options)
+  : UnitStage("naming", Statistics::NAMING),
+    _naming(options.naming(),false) // For now just force eprPreservingNaming to be false, should update Naming
+  {
+    ASS(options.naming());
+  }
+
+  void apply(Unit* u, Stack<Unit*>& out) override
+  {
+    CALL("Preprocess::NamingStage::apply");
+
+    if (u->isClause()) {
+      out.push(u);
+      return;
+    }
+    UnitList* defs;
+    FormulaUnit* fu = static_cast<FormulaUnit*>(u);
+    FormulaUnit* v = _naming.apply(fu,defs);
+    if (v != fu) {
+      ASS(defs);
+      out.loadFromIterator(UnitList::Iterator(defs));
+      UnitList::destroy(defs);
+    }
+    out.push(v);
+  }
+
+  void finish(Problem& prb) override
+  {
+    prb.invalidateProperty();
+  }
+private:
+  Naming _naming;
+};
+
+/**
+ * Preprocess the unit using options from opt. Preprocessing may
+ * involve inferences and replacement of this unit by a newly inferred one.
+ * Preprocessing formula units consists of the following steps:
+ * <ol>
+ *   <li>Transform the formula to NNF.</li>
+ *   <li>Flatten it.</li>
+ *   <li>(Optional) miniscope the formula.</li>
+ * </ol>
+ * @since 14/07/2005 flight Tel-Aviv-Barcelona
+ */
+class Preprocess::Preprocess3Stage
+: public PreprocessingPipeline::UnitStage
+{
+public:
+  CLASS_NAME(Preprocess::Preprocess3Stage);
+  USE_ALLOCATOR(Preprocess::Preprocess3Stage);
+
+  Preprocess3Stage()
+  : UnitStage("preprocess3", Statistics::PREPROCESS_3), _modified(false) {}
+
+  void apply(Unit* u, Stack<Unit*>& out) override
+  {
+    CALL("Preprocess::Preprocess3Stage::apply");
+
+    if (u->isClause()) {
+      out.push(u);
+      return;
+    }
+
+    FormulaUnit* fu = static_cast<FormulaUnit*>(u);
+    // Transform the formula to NNF
+    fu = NNF::nnf(fu);
+    // flatten it
+    fu = Flattening::flatten(fu);
+// (Optional) miniscope the formula
+//     if (_options.miniscope()) {
+//       Miniscope::miniscope(fu);
+//     }
+//   return unit;
+    fu = Skolem::skolemise(fu);
+    if (fu!=u) {
+      _modified = true;
+    }
+    out.push(fu);
+  }
+
+  void finish(Problem& prb) override
+  {
+    if (_modified) {
+      prb.invalidateProperty();
+    }
+  }
+private:
+  bool _modified;
+};
+
+/**
+ * Clausify formula units by NewCNF or by CNF. If an empty clause is
+ * found, the problem is replaced by it.
+ */
+class Preprocess::ClausifyStage
+: public PreprocessingPipeline::UnitStage
+{
+public:
+  CLASS_NAME(Preprocess::ClausifyStage);
+  USE_ALLOCATOR(Preprocess::ClausifyStage);
+
+  ClausifyStage(const Options& options, bool newCnf)
+  : UnitStage(newCnf ? "new_cnf" : "clausify", newCnf ? Statistics::NEW_CNF : Statistics::CLAUSIFICATION),
+    _newCnf(newCnf), _workers(options.clausificationWorkers()), _modified(false),
+    _newCnfClausifier(options.naming()), _parallel(newCnf, options.naming()), _inParallel(false),
+    _clauses(32) {}
+
+  /** The parallel clausifier splits the whole problem between its workers */
+  bool streamable() const override { return _workers<2; }
+
+  void start(Problem& prb) override
+  {
+    _inParallel = _parallel.run(prb.units(), _workers);
+  }
+
+  void apply(Unit* u, Stack<Unit*>& out) override
+  {
+    CALL("Preprocess::ClausifyStage::apply");
+
+    if (env.options->showPreprocessing()) {
+      env.beginOutput();
+      env.out() << "[PP] clausify: " << u->toString() << std::endl;
+      env.endOutput();
+    }
+    if (u->isClause()) {
+      if (static_cast<Clause*>(u)->isEmpty()) {
+        _refutation = u;
+        return;
+      }
+      out.push(u);
+      return;
+    }
+    _modified = true;
+    FormulaUnit* fu = static_cast<FormulaUnit*>(u);
+    if (_inParallel) {
+      _parallel.clausify(fu,_clauses);
+    } else if (_newCnf) {
+      _newCnfClausifier.clausify(fu,_clauses);
+    } else {
+      _cnf.clausify(fu,_clauses);
+    }
+    // the clauses go into the problem in the reverse order
+    while (! _clauses.isEmpty()) {
+      Clause* cl = _clauses.pop();
+      if (cl->isEmpty()) {
+        _refutation = cl;
+        _clauses.reset();
+        return;
+      }
+      out.push(cl);
+    }
+  }
+
+  void finish(Problem& prb) override
+  {
+    if (_modified) {
+      prb.invalidateProperty();
+    }
+    prb.reportFormulasEliminated();
+  }
+private:
+  bool _newCnf;
+  unsigned _workers;
+  bool _modified;
+
+  CNF _cnf;
+  NewCNF _newCnfClausifier;
+  ParallelClausifier _parallel;
+  bool _inParallel;
+  Stack<Clause*> _clauses;
+};
+
 /**
  * Preprocess the problem.
  *
@@ -172,6 +454,8 @@ void Preprocess::preprocess(Problem& prb)
     }
   }
 
+  PreprocessingPipeline pipeline(prb, _options.preprocessingReport()!="off");
+
   //we ensure that in the beginning we have a valid property object, to
   //know that the queries to uncertain problem properties will be precise
   //enough
@@ -182,9 +466,11 @@ void Preprocess::preprocess(Problem& prb)
   }
 
   if(_options.guessTheGoal() != Options::GoalGuess::OFF){
+    pipeline.beginGlobalStage("goal_guessing");
     prb.invalidateProperty();
     prb.getProperty();
     GoalGuessing().apply(prb);
+    pipeline.endGlobalStage();
   }
 
   // If there are interpreted operations
@@ -195,7 +481,9 @@ void Preprocess::preprocess(Problem& prb)
       if (env.options->showPreprocessing())
         env.out() << "adding theory axioms" << std::endl;
 
+      pipeline.beginGlobalStage("theory_axioms");
       TheoryAxioms(prb).apply();
+      pipeline.endGlobalStage();
     }
   }
 
@@ -206,14 +494,18 @@ void Preprocess::preprocess(Problem& prb)
     if (!_options.newCNF()) {
       if (env.options->showPreprocessing())
         env.out() << "FOOL elimination" << std::endl;
+      pipeline.beginGlobalStage("fool_elimination");
       TheoryAxioms(prb).applyFOOL();
       FOOLElimination().apply(prb);
+      pipeline.endGlobalStage();
     }
   }
 
   if (prb.hasInterpretedOperations() || env.signature->hasTermAlgebras()){
     // Normalize them e.g. replace $greater with not $lesseq
+    pipeline.beginGlobalStage("interpreted_normalization");
     InterpretedNormalizer().apply(prb);
+    pipeline.endGlobalStage();
   }
 
 
@@ -222,7 +514,9 @@ void Preprocess::preprocess(Problem& prb)
   if(env.signature->hasDistinctGroups()){
     if(env.options->showPreprocessing())
       env.out() << "distinct group expansion" << std::endl;
+    pipeline.beginGlobalStage("distinct_group_expansion");
     DistinctGroupExpansion().apply(prb);
+    pipeline.endGlobalStage();
   }
 
   // reorder units
@@ -231,7 +525,9 @@ void Preprocess::preprocess(Problem& prb)
     if (env.options->showPreprocessing())
       env.out() << "normalization" << std::endl;
 
+    pipeline.beginGlobalStage("normalization");
     Normalisation().normalise(prb);
+    pipeline.endGlobalStage();
   }
 
   if (_options.sineSelection()!=Options::SineSelection::OFF) {
@@ -239,7 +535,9 @@ void Preprocess::preprocess(Problem& prb)
     if (env.options->showPreprocessing())
       env.out() << "sine selection" << std::endl;
 
+    pipeline.beginGlobalStage("sine_selection");
     SineSelector(_options).perform(prb);
+    pipeline.endGlobalStage();
   }
 
   if (_options.questionAnswering()==Options::QuestionAnsweringMode::ANSWER_LITERAL) {
@@ -247,19 +545,26 @@ void Preprocess::preprocess(Problem& prb)
     if (env.options->showPreprocessing())
       env.out() << "answer literal addition" << std::endl;
 
+    pipeline.beginGlobalStage("answer_literals");
     AnswerLiteralManager::getInstance()->addAnswerLiterals(prb);
+    pipeline.endGlobalStage();
   }
 
   // stop here if clausification is not required
   if (!_clausify) {
+    outputReport(pipeline);
     return;
   }
 
+  // The unit-local steps below are queued into the pipeline and run unit
+  // by unit, up to the next step that needs the whole problem. None of the
+  // steps queued together changes whether the problem may have formulas.
+
   if (prb.mayHaveFormulas()) {
     if (env.options->showPreprocessing())
       env.out() << "preprocess1 (rectify, simplify false true, flatten)" << std::endl;
 
-    preprocess1(prb);
+    pipeline.addStage(new Preprocess1Stage(_options));
   }
 
   // Remove unused predicates
@@ -269,54 +574,61 @@ void Preprocess::preprocess(Problem& prb)
   // - unused definitions
   // I think TrivialPredicateRemoval just removes pures
   if (_options.unusedPredicateDefinitionRemoval()) {
+    pipeline.beginGlobalStage("unused_predicate_definition_removal");
     env.statistics->phase=Statistics::UNUSED_PREDICATE_DEFINITION_REMOVAL;
     if (env.options->showPreprocessing())
       env.out() << "unused predicate definition removal" << std::endl;
 
     PredicateDefinition pdRemover;
     pdRemover.removeUnusedDefinitionsAndPurePredicates(prb);
+    pipeline.endGlobalStage();
   }
 
   if (prb.mayHaveFormulas()) {
     if (env.options->showPreprocessing())
       env.out() << "preprocess 2 (ennf,flatten)" << std::endl;
 
-    preprocess2(prb);
+    pipeline.addStage(new Preprocess2Stage());
   }
 
   if (prb.mayHaveFormulas() && _options.newCNF()) {
     if (env.options->showPreprocessing())
       env.out() << "newCnf" << std::endl;
 
-    newCnf(prb);
+    pipeline.addStage(new ClausifyStage(_options, true));
   } else {
     if (prb.mayHaveFormulas() && _options.naming()) {
       if (env.options->showPreprocessing())
         env.out() << "naming" << std::endl;
 
-      naming(prb);
+      pipeline.addStage(new NamingStage(_options));
+      // all names are introduced before skolemisation, so that the
+      // numbering of the symbols does not depend on the pipeline
+      pipeline.run();
     }
 
     if (prb.mayHaveFormulas()) {
       if (env.options->showPreprocessing())
         env.out() << "preprocess3 (nnf, flatten, skolemize)" << std::endl;
 
-      preprocess3(prb);
+      pipeline.addStage(new Preprocess3Stage());
     }
 
     if (prb.mayHaveFormulas()) {
       if (env.options->showPreprocessing())
         env.out() << "clausify" << std::endl;
 
-      clausify(prb);
+      pipeline.addStage(new ClausifyStage(_options, false));
     }
   }
+  pipeline.run();
 
   if (prb.mayHaveFunctionDefinitions()) {
     env.statistics->phase=Statistics::FUNCTION_DEFINITION_ELIMINATION;
     if (env.options->showPreprocessing())
       env.out() << "function definition elimination" << std::endl;
 
+    pipeline.beginGlobalStage("function_definition_elimination");
     if (_options.functionDefinitionElimination() == Options::FunctionDefinitionElimination::ALL) {
       FunctionDefinition fd;
       fd.removeAllDefinitions(prb);
@@ -324,6 +636,7 @@ void Preprocess::preprocess(Problem& prb)
     else if (_options.functionDefinitionElimination() == Options::FunctionDefinitionElimination::UNUSED) {
       FunctionDefinition::removeUnusedDefinitions(prb);
     }
+    pipeline.endGlobalStage();
   }
 
 
@@ -332,8 +645,10 @@ void Preprocess::preprocess(Problem& prb)
       env.out() << "inequality splitting" << std::endl;
 
     env.statistics->phase=Statistics::INEQUALITY_SPLITTING;
+    pipeline.beginGlobalStage("inequality_splitting");
     InequalitySplitting is(_options);
     is.perform(prb);
+    pipeline.endGlobalStage();
   }
 
 //   // remove tautologies, duplicate literals, and literals t != t
@@ -360,8 +675,10 @@ void Preprocess::preprocess(Problem& prb)
      if (env.options->showPreprocessing())
       env.out() << "equality resolution with deletion" << std::endl;
 
+     pipeline.beginGlobalStage("equality_resolution_with_deletion");
      EqResWithDeletion resolver;
      resolver.apply(prb);
+     pipeline.endGlobalStage();
    }
 
 /*
@@ -379,8 +696,10 @@ void Preprocess::preprocess(Problem& prb)
      if (env.options->showPreprocessing())
        env.out() << "general splitting" << std::endl;
 
+     pipeline.beginGlobalStage("general_splitting");
      GeneralSplitting gs;
      gs.apply(prb);
+     pipeline.endGlobalStage();
    }
 
    if (_options.equalityProxy()!=Options::EqualityProxy::OFF && prb.mayHaveEquality()) {
@@ -388,16 +707,20 @@ void Preprocess::preprocess(Problem& prb)
      if (env.options->showPreprocessing())
        env.out() << "equality proxy" << std::endl;
 
+     pipeline.beginGlobalStage("equality_proxy");
      EqualityProxy proxy(_options.equalityProxy());
      proxy.apply(prb);
+     pipeline.endGlobalStage();
    }
 
    if(_options.theoryFlattening()){
      if(env.options->showPreprocessing())
        env.out() << "theory flattening" << std::endl;
 
+     pipeline.beginGlobalStage("theory_flattening");
      TheoryFlattening tf;
      tf.apply(prb);
+     pipeline.endGlobalStage();
    }
 
    if (_options.blockedClauseElimination()) {
@@ -405,8 +728,10 @@ void Preprocess::preprocess(Problem& prb)
      if(env.options->showPreprocessing())
        env.out() << "blocked clause elimination" << std::endl;
 
+     pipeline.beginGlobalStage("blocked_clause_elimination");
      BlockedClauseElimination bce;
      bce.apply(prb);
+     pipeline.endGlobalStage();
    }
 
    if (env.options->showPreprocessing()) {
@@ -421,306 +746,41 @@ void Preprocess::preprocess(Problem& prb)
      UIHelper::outputAllPremises(cerr, prb.units());
    }
 
+   outputReport(pipeline);
+
    if (env.options->showPreprocessing()) {
      env.out() << "preprocessing finished" << std::endl;
      env.endOutput();
    }
 } // Preprocess::preprocess ()
 
-
 /**
- * Preprocess the unit using options from opt. Preprocessing may
- * involve inferences and replacement of this unit by a newly inferred one.
- * Preprocessing formula units consists of the following steps:
- * <ol>
- *   <li>Rectify the formula and memorise the answer atom, if necessary.</li>
- *   <li>Flatten the formula.</li>
- * </ol>
- *
- * Preprocessing clause does not change it.
- *
- * Units passed to preprocess1 must not have any special terms, let..in formulas
- * or terms, or if-then-else terms. It may contain if-then-else formulas.
- */
-void Preprocess::preprocess1 (Problem& prb)
-{
-  CALL("Preprocess::preprocess1");
-
-  ScopedLet<Statistics::ExecutionPhase> epLet(env.statistics->phase, Statistics::PREPROCESS_1);
-
-  bool formulasSimplified = false;
-
-  UnitList*& units = prb.units();
-
-  UnitList::DelIterator us(units);
-  while (us.hasNext()) {
-    Unit* u = us.next();
-    if (u->isClause()) {
-      continue;
-    }
-
-    // formula unit
-    FormulaUnit* fu = static_cast<FormulaUnit*>(u);
-    // Rectify the formula and memorise the answer atom, if necessary
-    fu = Rectify::rectify(fu);
-    FormulaUnit* rectFu = fu;
-    // Simplify the formula if it contains true or false
-    if (!_options.newCNF()) {
-      // NewCNF effectively implements this simplification already
-      fu = SimplifyFalseTrue::simplify(fu);
-    }
-    if (fu!=rectFu) {
-      formulasSimplified = true;
-    }
-    fu = Flattening::flatten(fu);
-
-    if (fu != u) {
-      us.replace(fu);
-    }
-  }
-
-  if (formulasSimplified) {
-    prb.invalidateByRemoval();
-  }
-}
-
-
-/**
- * Preprocess the units using options from opt. Preprocessing may
- * involve inferences and replacement of this unit by a newly inferred one.
- * Preprocessing formula units consists of the following steps:
- * <ol>
- *   <li>Transform the formula to ENNF.</li>
- *   <li>Flatten it.</li>
- * </ol>
- * @since 14/07/2005 flight Tel-Aviv-Barcelona changed to stop before naming
- */
-void Preprocess::preprocess2(Problem& prb)
-{
-  CALL("Preprocess::preprocess2");
-
-  env.statistics->phase=Statistics::PREPROCESS_2;
-
-  UnitList::DelIterator us(prb.units());
-  while (us.hasNext()) {
-    Unit* u = us.next();
-
-    if (u->isClause()) {
-	continue;
-    }
-    FormulaUnit* fu = static_cast<FormulaUnit*>(u);
-    FormulaUnit* fu0 = fu;
-
-    fu = NNF::ennf(fu);
-    fu = Flattening::flatten(fu);
-
-
-    if (fu != fu0) {
-      us.replace(fu);
-    }
-  }
-} // Peprocess::preprocess2
-
-/**
- * Perform naming on problem @c prb which is in ENNF
- */
-void Preprocess::naming(Problem& prb)
-{
-  CALL("Preprocess::naming");
-  ASS(_options.naming());
-
-  env.statistics->phase=Statistics::NAMING;
-  UnitList::DelIterator us(prb.units());
-  Naming naming(_options.naming(),false); // For now just force eprPreservingNaming to be false, should update Naming
-  while (us.hasNext()) {
-    Unit* u = us.next();
-    if (u->isClause()) {
-      continue;
-    }
-    UnitList* defs;
-    FormulaUnit* fu = static_cast<FormulaUnit*>(u);
-    FormulaUnit* v = naming.apply(fu,defs);
-    if (v != fu) {
-      ASS(defs);
-      us.insert(defs);
-      us.replace(v);
-    }
-  }
-  prb.invalidateProperty();
-}
-
-/**
- * Perform the NewCNF algorithm on problem @c prb which is in ENNF
- */
-void Preprocess::newCnf(Problem& prb)
-{
-  CALL("Preprocess::newCnf");
-
-  env.statistics->phase=Statistics::NEW_CNF;
-
-  // TODO: this is an ugly copy-paste of "Preprocess::clausify"
-
-  //we check if we haven't discovered an empty clause during preprocessing
-  Unit* emptyClause = 0;
-
-  bool modified = false;
-
-  UnitList::DelIterator us(prb.units());
-  NewCNF cnf(env.options->naming());
-  Stack<Clause*> clauses(32);
-  while (us.hasNext()) {
-    Unit* u = us.next();
-    if (env.options->showPreprocessing()) {
-      env.beginOutput();
-      env.out() << "[PP] clausify: " << u->toString() << std::endl;
-      env.endOutput();
-    }
-    if (u->isClause()) {
-      if (static_cast<Clause*>(u)->isEmpty()) {
-        emptyClause = u;
-        break;
-      }
-      continue;
-    }
-    modified = true;
-    FormulaUnit* fu = static_cast<FormulaUnit*>(u);
-    cnf.clausify(fu,clauses);
-    while (! clauses.isEmpty()) {
-      Clause* cl = clauses.pop();
-      if (cl->isEmpty()) {
-        emptyClause = cl;
-        goto fin;
-      }
-      us.insert(cl);
-    }
-    us.del();
-  }
-  fin:
-  if (emptyClause) {
-    UnitList::destroy(prb.units());
-    prb.units() = 0;
-    UnitList::push(emptyClause, prb.units());
-  }
-  if (modified) {
-    prb.invalidateProperty();
-  }
-  prb.reportFormulasEliminated();
-}
-
-/**
- * Preprocess the unit using options from opt. Preprocessing may
- * involve inferences and replacement of this unit by a newly inferred one.
- * Preprocessing formula units consists of the following steps:
- * <ol>
- *   <li>Transform the formula to NNF.</li>
- *   <li>Flatten it.</li>
- *   <li>(Optional) miniscope the formula.</li>
- * </ol>
- * @since 14/07/2005 flight Tel-Aviv-Barcelona
+ * Write the statistics of the preprocessing stages into the file
+ * given by the preprocessing_report option, if any
  */
-Unit* Preprocess::preprocess3 (Unit* u)
+void Preprocess::outputReport(const PreprocessingPipeline& pipeline)
 {
-  CALL("Preprocess::preprocess3(Unit*)");
+  CALL("Preprocess::outputReport");
 
-  if (u->isClause()) {
-    return u;
+  if (_options.preprocessingReport()=="off") {
+    return;
   }
-
-  FormulaUnit* fu = static_cast<FormulaUnit*>(u);
-  // Transform the formula to NNF
-  fu = NNF::nnf(fu);
-  // flatten it
-  fu = Flattening::flatten(fu);
-// (Optional) miniscope the formula
-//     if (_options.miniscope()) {
-//       Miniscope::miniscope(fu);
-//     }
-//   return unit;
-  fu = Skolem::skolemise(fu);
-  return fu;
+  BYPASSING_ALLOCATOR; // for ofstream
+  ofstream out(_options.preprocessingReport().c_str());
+  pipeline.outputReport(out);
 }
 
 /**
- * Preprocess the unit using options from opt. Preprocessing may
- * involve inferences and replacement of this unit by a newly inferred one.
- * Preprocessing formula units consists of the following steps:
- * <ol>
- *   <li>Transform the formula to NNF.</li>
- *   <li>Flatten it.</li>
- *   <li>(Optional) miniscope the formula.</li>
- * </ol>
- * @since 14/07/2005 flight Tel-Aviv-Barcelona
+ * Rectify, simplify and flatten the formulas of @c prb,
+ * see Preprocess1Stage
  */
-void Preprocess::preprocess3 (Problem& prb)
-{
-  CALL("Preprocess::preprocess3(Problem&)");
-
-  bool modified = false;
-
-  env.statistics->phase=Statistics::PREPROCESS_3;
-  UnitList::DelIterator us(prb.units());
-  while (us.hasNext()) {
-    Unit* u = us.next();
-    Unit* v = preprocess3(u);
-    if (u!=v) {
-      us.replace(v);
-      modified = true;
-    }
-  }
-
-  if (modified) {
-    prb.invalidateProperty();
-  }
-} // Preprocess::preprocess3
-
-void Preprocess::clausify(Problem& prb)
+void Preprocess::preprocess1 (Problem& prb)
 {
-  CALL("Preprocess::clausify");
-
-  env.statistics->phase=Statistics::CLAUSIFICATION;
-
-  //we check if we haven't discovered an empty clause during preprocessing
-  Unit* emptyClause = 0;
-
-  bool modified = false;
+  CALL("Preprocess::preprocess1");
 
-  UnitList::DelIterator us(prb.units());
-  CNF cnf;
-  Stack<Clause*> clauses(32);
-  while (us.hasNext()) {
-    Unit* u = us.next();
-    if (env.options->showPreprocessing()) {
-      env.beginOutput();
-      env.out() << "[PP] clausify: " << u->toString() << std::endl;
-      env.endOutput();
-    }
-    if (u->isClause()) {
-      if (static_cast<Clause*>(u)->isEmpty()) {
-        emptyClause = u;
-        break;
-      }
-      continue;
-    }
-    modified = true;
-    cnf.clausify(u,clauses);
-    while (! clauses.isEmpty()) {
-      Unit* u = clauses.pop();
-      if (static_cast<Clause*>(u)->isEmpty()) {
-        emptyClause = u;
-        goto fin;
-      }
-      us.insert(u);
-    }
-    us.del();
-  }
-  fin:
-  if (emptyClause) {
-    UnitList::destroy(prb.units());
-    prb.units() = 0;
-    UnitList::push(emptyClause, prb.units());
-  }
-  if (modified) {
-    prb.invalidateProperty();
-  }
-  prb.reportFormulasEliminated();
+  Statistics::ExecutionPhase phase = env.statistics->phase;
+  PreprocessingPipeline pipeline(prb, false);
+  pipeline.addStage(new Preprocess1Stage(_options));
+  pipeline.run();
+  env.statistics->phase = phase;
 }
@@ -34,6 +34,7 @@ using namespace Kernel;
 
 class Property;
 class Options;
+class PreprocessingPipeline;
 
 /**
  * Class implementing preprocessing-related procedures.
@@ -58,13 +59,13 @@ public:
   /** turn off clausification, can be used when only preprocessing without clausification is needed */
   void turnClausifierOff() {_clausify = false;}
 private:
-  void preprocess2(Problem& prb);
-  void naming(Problem& prb);
-  Unit* preprocess3(Unit* u);
-  void preprocess3(Problem& prb);
-  void clausify(Problem& prb);
+  class Preprocess1Stage;
+  class Preprocess2Stage;
+  class NamingStage;
+  class Preprocess3Stage;
+  class ClausifyStage;
 
-  void newCnf(Problem& prb);
+  void outputReport(const PreprocessingPipeline& pipeline);
 
   /** Options used in the normalisation */
   const Options& _options;
@@ -0,0 +1,234 @@
+/*
+ * File PreprocessingPipeline.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file PreprocessingPipeline.cpp
+ * Implements class PreprocessingPipeline.
+ */
+
+#include "Debug/Tracer.hpp"
+
+#include "Lib/Allocator.hpp"
+#include "Lib/Environment.hpp"
+#include "Lib/Timer.hpp"
+
+#include "Kernel/Problem.hpp"
+#include "Kernel/Unit.hpp"
+
+#include "PreprocessingPipeline.hpp"
+
+namespace Shell
+{
+
+using namespace std;
+
+PreprocessingPipeline::PreprocessingPipeline(Problem& prb, bool instrument)
+: _prb(prb), _instrument(instrument)
+{
+}
+
+PreprocessingPipeline::~PreprocessingPipeline()
+{
+  CALL("PreprocessingPipeline::~PreprocessingPipeline");
+
+  //stages are left pending when preprocessing is interrupted by an
+  //exception, such as the time limit being reached
+  while(_stages.isNonEmpty()) {
+    delete _stages.pop();
+  }
+}
+
+/**
+ * Return by how much the memory used by the Allocator has grown since
+ * it was @c startMemory, or zero if it has not grown
+ *
+ * The Allocator recycles the pages it obtained from the system instead
+ * of returning them, so its used memory is the peak memory of the run.
+ */
+size_t PreprocessingPipeline::memoryGrowth(size_t startMemory)
+{
+  size_t used = Allocator::getUsedMemory();
+  return used>startMemory ? used-startMemory : 0;
+}
+
+/**
+ * Add a unit stage to be run after the stages added so far.
+ * The pipeline takes over the ownership of @c stage.
+ */
+void PreprocessingPipeline::addStage(UnitStage* stage)
+{
+  CALL("PreprocessingPipeline::addStage");
+
+  if(!stage->streamable()) {
+    run();
+  }
+  _stages.push(stage);
+  _stageRecords.push(_records.size());
+  _records.push(StageRecord(stage->_name, false));
+}
+
+/**
+ * Pass @c u through the unit stages from @c stage on and push the
+ * resulting units into @c out. Return false if an empty clause was derived.
+ */
+bool PreprocessingPipeline::pass(unsigned stage, Unit* u, Stack<Unit*>& out)
+{
+  CALL("PreprocessingPipeline::pass");
+
+  if(stage==_stages.size()) {
+    out.push(u);
+    return true;
+  }
+
+  UnitStage* st = _stages[stage];
+  env.statistics->phase = st->_phase;
+
+  Stack<Unit*>& res = _buffers[stage];
+  res.reset();
+
+  if(_instrument) {
+    StageRecord& rec = _records[_stageRecords[stage]];
+    int startTime = env.timer->elapsedMilliseconds();
+    size_t startMemory = Allocator::getUsedMemory();
+    st->apply(u, res);
+    rec.time += env.timer->elapsedMilliseconds()-startTime;
+    rec.memory += memoryGrowth(startMemory);
+    rec.unitsIn++;
+    rec.unitsOut += res.size();
+  }
+  else {
+    st->apply(u, res);
+  }
+
+  if(st->refutation()) {
+    return false;
+  }
+  for(unsigned i=0;i<res.size();i++) {
+    if(!pass(stage+1, res[i], out)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Run the pending unit stages over the problem, unit by unit
+ */
+void PreprocessingPipeline::run()
+{
+  CALL("PreprocessingPipeline::run");
+
+  if(_stages.isEmpty()) {
+    return;
+  }
+
+  for(unsigned i=0;i<_stages.size();i++) {
+    _stages[i]->start(_prb);
+  }
+  _buffers.ensure(_stages.size());
+
+  Unit* refutation = 0;
+  static Stack<Unit*> out;
+  UnitList::DelIterator us(_prb.units());
+  while(us.hasNext()) {
+    Unit* u = us.next();
+    out.reset();
+    if(!pass(0, u, out)) {
+      for(unsigned i=0;!refutation;i++) {
+        refutation = _stages[i]->refutation();
+      }
+      break;
+    }
+    if(out.size()==1) {
+      if(out[0]!=u) {
+        us.replace(out[0]);
+      }
+      continue;
+    }
+    UnitList* res = 0;
+    for(unsigned i=out.size();i>0;) {
+      UnitList::push(out[--i], res);
+    }
+    us.insert(res);
+    us.del();
+  }
+  if(refutation) {
+    UnitList::destroy(_prb.units());
+    _prb.units() = 0;
+    UnitList::push(refutation, _prb.units());
+  }
+
+  for(unsigned i=0;i<_stages.size();i++) {
+    _stages[i]->finish(_prb);
+    _records[_stageRecords[i]].peakMemory = Allocator::getUsedMemory();
+    delete _stages[i];
+  }
+  _stages.reset();
+  _stageRecords.reset();
+}
+
+/**
+ * To be called before a preprocessing step that works on the whole
+ * problem. The pending unit stages are run first.
+ */
+void PreprocessingPipeline::beginGlobalStage(const char* name)
+{
+  CALL("PreprocessingPipeline::beginGlobalStage");
+
+  run();
+  if(!_instrument) {
+    return;
+  }
+  _records.push(StageRecord(name, true));
+  _records.top().unitsIn = UnitList::length(_prb.units());
+  _globalStartTime = env.timer->elapsedMilliseconds();
+  _globalStartMemory = Allocator::getUsedMemory();
+}
+
+void PreprocessingPipeline::endGlobalStage()
+{
+  CALL("PreprocessingPipeline::endGlobalStage");
+
+  if(!_instrument) {
+    return;
+  }
+  StageRecord& rec = _records.top();
+  ASS(rec.global);
+  rec.unitsOut = UnitList::length(_prb.units());
+  rec.time = env.timer->elapsedMilliseconds()-_globalStartTime;
+  rec.peakMemory = Allocator::getUsedMemory();
+  rec.memory = memoryGrowth(_globalStartMemory);
+}
+
+/**
+ * Output the recorded statistics of the stages as tab separated values,
+ * one line per stage in the order in which the stages were started
+ */
+void PreprocessingPipeline::outputReport(ostream& out) const
+{
+  CALL("PreprocessingPipeline::outputReport");
+
+  out << "stage\tkind\tunits_in\tunits_out\ttime_ms\tmemory_kb\tpeak_memory_kb" << endl;
+  for(unsigned i=0;i<_records.size();i++) {
+    const StageRecord& rec = _records[i];
+    out << rec.name << '\t' << (rec.global ? "global" : "unit") << '\t'
+        << rec.unitsIn << '\t' << rec.unitsOut << '\t' << rec.time << '\t'
+        << rec.memory/1024 << '\t' << rec.peakMemory/1024 << endl;
+  }
+}
+
+}
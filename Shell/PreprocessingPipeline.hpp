@@ -0,0 +1,153 @@
+/*
+ * File PreprocessingPipeline.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file PreprocessingPipeline.hpp
+ * Defines class PreprocessingPipeline.
+ */
+
+#ifndef __PreprocessingPipeline__
+#define __PreprocessingPipeline__
+
+#include <ostream>
+
+#include "Forwards.hpp"
+
+#include "Lib/DArray.hpp"
+#include "Lib/Stack.hpp"
+#include "Lib/VString.hpp"
+
+#include "Statistics.hpp"
+
+namespace Shell {
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * Runs preprocessing stages over the units of a problem
+ *
+ * Unit stages transform each unit independently of the others. Consecutive
+ * unit stages are fused: each unit of the problem goes through all of them
+ * before the next unit is taken, so the problem is traversed once for the
+ * whole group. Global stages (such as SInE selection) need the whole problem
+ * and are a barrier, the pending unit stages are run before them.
+ *
+ * If instrumentation is enabled, the number of units that went in and out,
+ * the time and the growth of the peak memory are recorded for every stage.
+ */
+class PreprocessingPipeline
+{
+public:
+  CLASS_NAME(PreprocessingPipeline);
+  USE_ALLOCATOR(PreprocessingPipeline);
+
+  class UnitStage
+  {
+  public:
+    CLASS_NAME(PreprocessingPipeline::UnitStage);
+    USE_ALLOCATOR(PreprocessingPipeline::UnitStage);
+
+    UnitStage(const char* name, Statistics::ExecutionPhase phase)
+    : _refutation(0), _name(name), _phase(phase) {}
+    virtual ~UnitStage() {}
+
+    /**
+     * Push into @c out the units that replace @c u in the problem, in
+     * the order in which they are to appear there. If the unit is not
+     * changed, @c u itself is pushed.
+     */
+    virtual void apply(Unit* u, Stack<Unit*>& out) = 0;
+
+    /**
+     * Return false if the stage needs to see the whole problem before
+     * the first unit is passed to it. The pending stages are then run first.
+     */
+    virtual bool streamable() const { return true; }
+    /** Called before the first unit is passed to the stage */
+    virtual void start(Problem& prb) {}
+    /** Called after the last unit has been passed to the stage */
+    virtual void finish(Problem& prb) {}
+
+    /**
+     * An empty clause derived by the stage. If non-zero, the problem is
+     * replaced by the empty clause and the remaining units are not processed.
+     */
+    Unit* refutation() const { return _refutation; }
+  protected:
+    Unit* _refutation;
+  private:
+    friend class PreprocessingPipeline;
+
+    const char* _name;
+    Statistics::ExecutionPhase _phase;
+  };
+
+  PreprocessingPipeline(Problem& prb, bool instrument);
+  ~PreprocessingPipeline();
+
+  void addStage(UnitStage* stage);
+  void run();
+
+  void beginGlobalStage(const char* name);
+  void endGlobalStage();
+
+  void outputReport(std::ostream& out) const;
+
+private:
+  struct StageRecord
+  {
+    StageRecord(const char* name, bool global)
+    : name(name), global(global), unitsIn(0), unitsOut(0), time(0), memory(0), peakMemory(0) {}
+
+    vstring name;
+    bool global;
+    unsigned unitsIn;
+    unsigned unitsOut;
+    /** time in milliseconds */
+    int time;
+    /** growth of the peak memory during the stage in bytes */
+    size_t memory;
+    /** peak memory in bytes when the stage finished */
+    size_t peakMemory;
+  };
+
+  static size_t memoryGrowth(size_t startMemory);
+  bool pass(unsigned stage, Unit* u, Stack<Unit*>& out);
+
+  Problem& _prb;
+  bool _instrument;
+
+  /** Unit stages that have not been run yet */
+  Stack<UnitStage*> _stages;
+  /** Indexes into _records of the unit stages in _stages */
+  Stack<unsigned> _stageRecords;
+  Stack<StageRecord> _records;
+  /**
+   * Output of each unit stage for the unit being processed. Each stage
+   * needs its own, as its output is iterated while the later stages run.
+   */
+  DArray<Stack<Unit*> > _buffers;
+
+  /** Start of the running global stage */
+  int _globalStartTime;
+  size_t _globalStartMemory;
+};
+
+}
+
+#endif // __PreprocessingPipeline__
@@ -29,7 +29,9 @@
 #include "Lib/Environment.hpp"
 #include "Lib/List.hpp"
 #include "Lib/Metaiterators.hpp"
+#include "Lib/ScopedPtr.hpp"
 #include "Lib/Set.hpp"
+#include "Lib/Sort.hpp"
 #include "Lib/TimeCounter.hpp"
 #include "Lib/VirtualIterator.hpp"
 
@@ -266,6 +268,99 @@ void SineBase::initGeneralityFunction(UnitList* units)
   }
 }
 
+//////////////////////////////////////
+// SineIndex
+//////////////////////////////////////
+
+SineIndex* SineIndex::s_shared = 0;
+
+/**
+ * Build the index of units in @c units
+ *
+ * Units are numbered in the order in which they appear in the list.
+ */
+SineIndex::SineIndex(UnitList* units)
+{
+  CALL("SineIndex::SineIndex");
+
+  SineSymbolExtractor symExtr;
+  SymId symIdBound=symExtr.getSymIdBound();
+  _gen.init(symIdBound,0);
+
+  _unitSymStarts.push(0);
+  UnitList::Iterator uit(units);
+  while (uit.hasNext()) {
+    Unit* u=uit.next();
+    ALWAYS(_unitNumbers.insert(u,_units.size()));
+    _units.push(u);
+
+    SineSymbolExtractor::SymIdIterator sit=symExtr.extractSymIds(u);
+    while (sit.hasNext()) {
+      SymId sym=sit.next();
+      _gen[sym]++;
+      _unitSyms.push(sym);
+    }
+    _unitSymStarts.push(_unitSyms.size());
+  }
+
+  unsigned unitCnt=_units.size();
+  _leastGen.init(unitCnt,0);
+  _occurrenceStarts.init(symIdBound+1,0);
+  for (unsigned un=0;un<unitCnt;un++) {
+    unsigned leastGenVal=UINT_MAX;
+    for (const SymId* sit=symbolsBegin(un);sit!=symbolsEnd(un);sit++) {
+      leastGenVal=min(leastGenVal,_gen[*sit]);
+      _occurrenceStarts[*sit+1]++;
+    }
+    _leastGen[un]=hasSymbols(un) ? leastGenVal : 0;
+  }
+  for (SymId sym=0;sym<symIdBound;sym++) {
+    _occurrenceStarts[sym+1]+=_occurrenceStarts[sym];
+  }
+
+  _occurrences.init(_unitSyms.size(),0);
+  DArray<unsigned> rowPositions;
+  rowPositions.initFromArray(symIdBound,_occurrenceStarts);
+  for (unsigned un=0;un<unitCnt;un++) {
+    for (const SymId* sit=symbolsBegin(un);sit!=symbolsEnd(un);sit++) {
+      _occurrences[rowPositions[*sit]++]=un;
+    }
+  }
+}
+
+/**
+ * Return true if the index was built from exactly the units in @c units
+ * (in any order)
+ */
+bool SineIndex::covers(UnitList* units) const
+{
+  CALL("SineIndex::covers");
+
+  unsigned cnt=0;
+  UnitList::Iterator uit(units);
+  while (uit.hasNext()) {
+    if (!_unitNumbers.find(uit.next())) {
+      return false;
+    }
+    cnt++;
+  }
+  return cnt==unitCount();
+}
+
+/**
+ * Set the index to be used by SineSelector whenever it covers the
+ * selected units
+ */
+void SineIndex::setShared(SineIndex* index)
+{
+  CALL("SineIndex::setShared");
+
+  if (s_shared) {
+    delete s_shared;
+  }
+  s_shared=index;
+}
+
 SineSelector::SineSelector(const Options& opt)
 : _onIncluded(opt.sineSelection()==Options::SineSelection::INCLUDED),
   _genThreshold(opt.sineGeneralityThreshold()),
@@ -301,82 +396,25 @@ void SineSelector::init()
 }
 
 /**
- * Connect unit @b u with symbols it defines
+ * Return true if the unit with number @c un is in the D-relation with
+ * the symbol @c sym, i.e. if the unit is to be selected once @c sym is
  */
-void SineSelector::updateDefRelation(Unit* u)
+bool SineSelector::defines(const SineIndex& index, unsigned un, SymId sym)
 {
-  CALL("SineSelector::updateDefRelation");
-
-  SymIdIterator sit=_symExtr.extractSymIds(u);
-
-  if (!sit.hasNext()) {
-    if(env.clausePriorities){
-      env.clausePriorities->insert(u,1);
-    }
-    _unitsWithoutSymbols.push(u);
-    return;
+  unsigned val=index.generality(sym);
+  //symbols that fit under _genThreshold are in the relation with all units they occur in
+  if (val<=_genThreshold) {
+    return true;
   }
-
-  static Stack<SymId> equalGenerality;
-  equalGenerality.reset();
-
-  SymId leastGenSym=sit.next();
-  unsigned leastGenVal=_gen[leastGenSym];
-
-  //it a symbol fits under _genThreshold, add it immediately [into the relation]
-  if (leastGenVal<=_genThreshold) {
-    UnitList::push(u,_def[leastGenSym]);
-  }
-
-  while (sit.hasNext()) {
-    SymId sym=sit.next();
-    unsigned val=_gen[sym];
-    ASS_G(val,0);
-
-    //it a symbol fits under _genThreshold, add it immediately [into the relation]
-    if (val<=_genThreshold) {
-      UnitList::push(u,_def[sym]);
-    }
-
-    if (val<leastGenVal) {
-      leastGenSym=sym;
-      leastGenVal=val;
-      equalGenerality.reset();
-    } else if (val==leastGenVal) {
-      equalGenerality.push(sym);
-    }
-  }
-
-
+  unsigned leastGenVal=index.leastGenerality(un);
   if (_strict) {
-    //only if the least general symbol is over _genThreshold; otherwise it is already added
-    if (leastGenVal>_genThreshold) {
-      UnitList::push(u,_def[leastGenSym]);
-      while (equalGenerality.isNonEmpty()) {
-        UnitList::push(u,_def[equalGenerality.pop()]);
-      }
-    }
+    return val==leastGenVal;
   }
-  else {
-    unsigned generalityLimit=static_cast<int>(leastGenVal*_tolerance);
-    if (_tolerance==-1.0f) {
-      generalityLimit = UINT_MAX;
-    }
-
-    //if the generalityLimit is under _genThreshold, all suitable symbols are already added
-    if (generalityLimit>_genThreshold) {
-      sit=_symExtr.extractSymIds(u);
-      while (sit.hasNext()) {
-	SymId sym=sit.next();
-	unsigned val=_gen[sym];
-	//only if the symbol is over _genThreshold; otherwise it is already added
-	if (val>_genThreshold && val<=generalityLimit) {
-	  UnitList::push(u,_def[sym]);
-	}
-      }
-    }
+  if (_tolerance==-1.0f) {
+    return true;
   }
-
+  unsigned generalityLimit=static_cast<int>(leastGenVal*_tolerance);
+  return val<=generalityLimit;
 }
 
 void SineSelector::perform(Problem& prb)
@@ -395,28 +433,51 @@ bool SineSelector::perform(UnitList*& units)
 
   TimeCounter tc(TC_SINE_SELECTION);
 
-  initGeneralityFunction(units);
-
-  SymId symIdBound=_symExtr.getSymIdBound();
-
-  Set<Unit*> selected;
+  ScopedPtr<SineIndex> localIndex;
+  SineIndex* index=SineIndex::shared();
+  if (!index || !index->covers(units)) {
+    localIndex=new SineIndex(units);
+    index=localIndex.ptr();
+  }
+  unsigned unitCnt=index->unitCount();
+  SymId symIdBound=index->symIdBound();
+
+  //positions of units in the list, the D-relation is traversed from the last
+  //unit to the first one regardless of the order in which the index was built
+  DArray<unsigned> positions(unitCnt);
+  bool indexOrder=true;
+  DArray<bool> inRelation(unitCnt);
+  inRelation.init(unitCnt,false);
+  DArray<bool> selected(unitCnt);
+  selected.init(unitCnt,false);
   Stack<Unit*> selectedStack; //on this stack there are Units in the order they were selected
   Deque<Unit*> newlySelected;
 
-  //build the D-relation and select the non-axiom formulas
-  _def.init(symIdBound,0);
+  //select the non-axiom formulas
   unsigned numberUnitsLeftOut = 0;
   UnitList::Iterator uit2(units);
   while (uit2.hasNext()) {
-    numberUnitsLeftOut++;
     Unit* u=uit2.next();
+    unsigned un=index->unitNumber(u);
+    positions[un]=numberUnitsLeftOut;
+    indexOrder&=(un==numberUnitsLeftOut);
+    numberUnitsLeftOut++;
+
     bool performSelection= _onIncluded ? u->included() : ((u->inputType()==Unit::AXIOM)
                             || (env.options->guessTheGoal() != Options::GoalGuess::OFF && u->inputType()==Unit::ASSUMPTION));
     if (performSelection) {
-      updateDefRelation(u);
+      if (index->hasSymbols(un)) {
+        inRelation[un]=true;
+      }
+      else {
+        if(env.clausePriorities){
+          env.clausePriorities->insert(u,1);
+        }
+        _unitsWithoutSymbols.push(u);
+      }
     }
     else {
-      selected.insert(u);
+      selected[un]=true;
       selectedStack.push(u);
       newlySelected.push_back(u);
 
@@ -427,6 +488,11 @@ bool SineSelector::perform(UnitList*& units)
     }
   }
 
+  //symbols whose defining units have all been selected
+  DArray<bool> symDone(symIdBound);
+  symDone.init(symIdBound,false);
+  Stack<unsigned long> sortedOccurrences;
+
   unsigned depth=0;
   newlySelected.push_back(0);
 
@@ -451,16 +517,34 @@ bool SineSelector::perform(UnitList*& units)
       continue;
     }
 
-    SymIdIterator sit=_symExtr.extractSymIds(u);
-    while (sit.hasNext()) {
-      SymId sym=sit.next();
-      UnitList::Iterator defUnits(_def[sym]);
-      while (defUnits.hasNext()) {
-	Unit* du=defUnits.next();
-	if (selected.contains(du)) {
-	  continue;
-	}
-	selected.insert(du);
+    unsigned un=index->unitNumber(u);
+    for (const SymId* sit=index->symbolsBegin(un);sit!=index->symbolsEnd(un);sit++) {
+      SymId sym=*sit;
+      if (symDone[sym]) {
+        continue;
+      }
+      //all defining units for the symbol sym will be selected,
+      //so we need not look at them again
+      symDone[sym]=true;
+
+      const unsigned* occBegin=index->occurrencesBegin(sym);
+      const unsigned* occEnd=index->occurrencesEnd(sym);
+      if (!indexOrder) {
+        //sort by position in the list, with the unit number in the lower half
+        sortedOccurrences.reset();
+        for (const unsigned* oit=occBegin;oit!=occEnd;oit++) {
+          sortedOccurrences.push((static_cast<unsigned long>(positions[*oit])<<32) | *oit);
+        }
+        sort<DefaultComparator>(sortedOccurrences.begin(),sortedOccurrences.end());
+      }
+      unsigned occCnt=occEnd-occBegin;
+      for (unsigned i=occCnt;i>0;i--) {
+        unsigned dun=indexOrder ? occBegin[i-1] : static_cast<unsigned>(sortedOccurrences[i-1]);
+        if (selected[dun] || !inRelation[dun] || !defines(*index, dun, sym)) {
+          continue;
+        }
+        Unit* du=index->unit(dun);
+	selected[dun]=true;
 	selectedStack.push(du);
 	newlySelected.push_back(du);
 
@@ -469,12 +553,7 @@ bool SineSelector::perform(UnitList*& units)
           env.clausePriorities->insert(du,env.maxClausePriority);
           //cout << "set priority for " << du->toString() << " as " << env.maxClausePriority << endl;
         }
-
       }
-      //all defining units for the symbol sym were selected,
-      //so we can remove them from the relation
-      UnitList::destroy(_def[sym]);
-      _def[sym]=0;
     }
   }
 
@@ -27,6 +27,7 @@
 #include "Forwards.hpp"
 
 #include "Lib/DArray.hpp"
+#include "Lib/DHMap.hpp"
 #include "Lib/Stack.hpp"
 
 namespace Shell {
@@ -67,6 +68,71 @@ protected:
   SineSymbolExtractor _symExtr;
 };
 
+/**
+ * Symbol occurrence index of a set of units for the SInE selection
+ *
+ * The index holds everything that does not depend on the tolerance,
+ * depth and generality threshold: the symbols of each unit, the
+ * generality of each symbol, the generality of the least general symbol
+ * of each unit, and for each symbol the units it occurs in. The last two
+ * are kept in compressed sparse row form, i.e. in one array of unit
+ * numbers with an array of start offsets indexed by symbol.
+ *
+ * Since the D-relation for a given tolerance can be read off the index,
+ * one index can serve selections with different parameters. The portfolio
+ * mode builds a shared index before forking, so that slices using SInE do
+ * not have to traverse all the formulas again.
+ */
+class SineIndex
+{
+public:
+  CLASS_NAME(SineIndex);
+  USE_ALLOCATOR(SineIndex);
+
+  typedef SineSymbolExtractor::SymId SymId;
+
+  SineIndex(UnitList* units);
+
+  bool covers(UnitList* units) const;
+
+  unsigned unitCount() const { return _units.size(); }
+  unsigned unitNumber(Unit* u) const { return _unitNumbers.get(u); }
+  Unit* unit(unsigned un) const { return _units[un]; }
+
+  /** Symbols of the unit with number @c un, each symbol once */
+  const SymId* symbolsBegin(unsigned un) const { return _unitSyms.begin()+_unitSymStarts[un]; }
+  const SymId* symbolsEnd(unsigned un) const { return _unitSyms.begin()+_unitSymStarts[un+1]; }
+  bool hasSymbols(unsigned un) const { return _unitSymStarts[un]!=_unitSymStarts[un+1]; }
+
+  /** Number of units in which @c sym occurs */
+  unsigned generality(SymId sym) const { return _gen[sym]; }
+  /** Generality of the least general symbol of the unit with number @c un */
+  unsigned leastGenerality(unsigned un) const { return _leastGen[un]; }
+
+  /** Numbers of units in which @c sym occurs, in increasing order */
+  const unsigned* occurrencesBegin(SymId sym) const { return _occurrences.array()+_occurrenceStarts[sym]; }
+  const unsigned* occurrencesEnd(SymId sym) const { return _occurrences.array()+_occurrenceStarts[sym+1]; }
+
+  unsigned symIdBound() const { return _gen.size(); }
+
+  static SineIndex* shared() { return s_shared; }
+  static void setShared(SineIndex* index);
+private:
+  DHMap<Unit*,unsigned> _unitNumbers;
+  Stack<Unit*> _units;
+
+  Stack<unsigned> _unitSymStarts;
+  Stack<SymId> _unitSyms;
+
+  DArray<unsigned> _gen;
+  DArray<unsigned> _leastGen;
+
+  DArray<unsigned> _occurrenceStarts;
+  DArray<unsigned> _occurrences;
+
+  static SineIndex* s_shared;
+};
+
 /**
  * Class that performs the SInE axiom selection on a single problem
  */
@@ -82,7 +148,7 @@ public:
 private:
   void init();
 
-  void updateDefRelation(Unit* u);
+  bool defines(const SineIndex& index, unsigned un, SymId sym);
 
   bool _onIncluded;
   bool _strict;
@@ -90,9 +156,6 @@ private:
   float _tolerance;
   unsigned _depthLimit;
 
-  /** Stored the D-relation */
-  DArray<UnitList*> _def;
-
   /**
    * Stored formulas that don't contain any symbols
    *
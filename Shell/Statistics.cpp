@@ -166,10 +166,7 @@ void Statistics::print(ostream& out)
 
   SaturationAlgorithm::tryUpdateFinalClauseCount();
 
-  bool separable=false;
-#define HEADING(text,num) if (num) { addCommentSignForSZS(out); out << ">>> " << (text) << endl;}
-#define COND_OUT(text, num) if (num) { addCommentSignForSZS(out); out << (text) << ": " << (num) << endl; separable = true; }
-#define SEPARATOR if (separable) { addCommentSignForSZS(out); out << endl; separable = false; }
+#define COND_OUT(text, num) if (num) { addCommentSignForSZS(out); out << (text) << ": " << (num) << endl; }
 
   addCommentSignForSZS(out);
   out << "------------------------------\n";
@@ -231,6 +228,42 @@ void Statistics::print(ostream& out)
   out << endl;
 
   if (env.options->statistics()==Options::Statistics::FULL) {
+    printCounters(out, false);
+  }
+
+  COND_OUT("Memory used [KB]", Allocator::getUsedMemory()/1024);
+
+  addCommentSignForSZS(out);
+  out << "Time elapsed: ";
+  Timer::printMSString(out,env.timer->elapsedMilliseconds());
+  out << endl;
+  addCommentSignForSZS(out);
+  out << "------------------------------\n";
+
+  RSTAT_PRINT(out);
+  addCommentSignForSZS(out);
+  out << "------------------------------\n";
+
+#undef COND_OUT
+
+  if (env.options && env.options->timeStatistics()) {
+    TimeCounter::printReport(out);
+  }
+}
+
+/**
+ * Print the non-zero counters, as in the full statistics, or as the
+ * members of a JSON object if @c json is true
+ */
+void Statistics::printCounters(ostream& out, bool json)
+{
+  bool separable=false;
+  bool first=true;
+#define HEADING(text,num) if (num && !json) { addCommentSignForSZS(out); out << ">>> " << (text) << endl;}
+#define COND_OUT(text, num) if (num) { \
+    if (json) { out << (first ? "\"" : ",\"") << (text) << "\":" << (num); first = false; } \
+    else { addCommentSignForSZS(out); out << (text) << ": " << (num) << endl; separable = true; } }
+#define SEPARATOR if (separable && !json) { addCommentSignForSZS(out); out << endl; separable = false; }
 
   HEADING("Input",inputClauses+inputFormulas);
   COND_OUT("Input clauses", inputClauses);
@@ -376,27 +409,9 @@ void Statistics::print(ostream& out)
   COND_OUT("Pure propositional variables eliminated by SAT solver", satPureVarsEliminated);
   SEPARATOR;
 
-  }
-
-  COND_OUT("Memory used [KB]", Allocator::getUsedMemory()/1024);
-
-  addCommentSignForSZS(out);
-  out << "Time elapsed: ";
-  Timer::printMSString(out,env.timer->elapsedMilliseconds());
-  out << endl;
-  addCommentSignForSZS(out);
-  out << "------------------------------\n";
-
-  RSTAT_PRINT(out);
-  addCommentSignForSZS(out);
-  out << "------------------------------\n";
-
 #undef SEPARATOR
 #undef COND_OUT
-
-  if (env.options && env.options->timeStatistics()) {
-    TimeCounter::printReport(out);
-  }
+#undef HEADING
 }
 
 const char* Statistics::phaseToString(ExecutionPhase p)
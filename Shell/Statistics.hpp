@@ -63,6 +63,7 @@ public:
   Statistics();
 
   void print(ostream& out);
+  void printCounters(ostream& out, bool json);
 
   // Input
   /** number of input clauses */
@@ -411,7 +412,6 @@ public:
 
   ExecutionPhase phase;
 
-private:
   static const char* phaseToString(ExecutionPhase p);
 }; // class Statistics
 
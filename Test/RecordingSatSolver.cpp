@@ -1,4 +1,3 @@
-
 /*
  * File RecordingSatSolver.cpp.
  *
@@ -12,231 +11,426 @@
  *
  * In summary, you are allowed to use Vampire for non-commercial
  * purposes but not allowed to distribute, modify, copy, create derivatives,
- * or use in competitions. 
+ * or use in competitions.
  * For other uses of Vampire please contact developers for a different
- * licence, which we will make an effort to provide. 
+ * licence, which we will make an effort to provide.
  */
 /**
  * @file RecordingSatSolver.cpp
  * Implements class RecordingSatSolver.
  */
 
-#include <sstream>
+#include <climits>
+#include <cstring>
 
+#include "Lib/Environment.hpp"
 #include "Lib/Int.hpp"
-#include "Lib/List.hpp"
-#include "Lib/StringUtils.hpp"
+#include "Lib/System.hpp"
+#include "Lib/Timer.hpp"
+#include "Lib/Varint.hpp"
 
 #include "SAT/SATClause.hpp"
 
+#include "Shell/Options.hpp"
+
 #include "RecordingSatSolver.hpp"
 
 namespace Test
 {
 
+using namespace std;
+
+const char SAT_TRACE_MAGIC[8] = { 'V', 'S', 'A', 'T', 'T', 'R', 'C', '1' };
+
 ///////////////////////
 // RecordingSatSolver
 //
 
-#define REC(x) 
+RecordingSatSolver::RecordingSatSolver(SATSolverWithAssumptions* inner, vstring fileName)
+: _inner(inner)
+{
+  CALL("RecordingSatSolver::RecordingSatSolver");
+
+  {
+    BYPASSING_ALLOCATOR; // the buffers of ofstream are not allocated via Allocator
+    _out = new ofstream(fileName.c_str(), ios::out | ios::binary | ios::trunc);
+  }
+  if(!*_out) {
+    USER_ERROR("Cannot open SAT trace file "+fileName);
+  }
+  _out->write(SAT_TRACE_MAGIC, sizeof(SAT_TRACE_MAGIC));
+}
+
+RecordingSatSolver::~RecordingSatSolver()
+{
+  CALL("RecordingSatSolver::~RecordingSatSolver");
+
+  BYPASSING_ALLOCATOR;
+  delete _out;
+}
 
 /**
- * Return header to be used for log outputs of this solver
+ * If the sat_trace option is set, return @c inner wrapped into a solver
+ * recording into a new trace file named after @c component. Otherwise
+ * return @c inner.
  */
-vstring RecordingSatSolver::getHdr() const
+SATSolverWithAssumptions* RecordingSatSolver::record(SATSolverWithAssumptions* inner, const Shell::Options& opt, const char* component)
 {
-  CALL("RecordingSatSolver::getHdr");
+  CALL("RecordingSatSolver::record");
 
-  return "sat_"+Int::toHexString(reinterpret_cast<size_t>(this))+" ";
+  if(opt.satTrace()=="off") {
+    return inner;
+  }
+  // strategies of a portfolio run in forked processes with the same counter
+  static unsigned traceCnt = 0;
+  vstring fileName = opt.satTrace()+"."+component+"."+Int::toString(System::getPID())+"."
+      +Int::toString(traceCnt++)+".trace";
+  return new RecordingSatSolver(inner, fileName);
 }
 
-void RecordingSatSolver::addClauses(SATClauseIterator cit0, bool onlyPropagate,bool useInPartialModel)
+void RecordingSatSolver::writeUnsigned(unsigned val)
 {
-  CALL("RecordingSatSolver::addClauses");
-
-  SATClauseList* clauses = 0;
-  SATClauseList::pushFromIterator(cit0, clauses);
-  clauses = clauses->reverse();
+  Varint::write(val, *_out);
+}
 
-  vostringstream clausesStm;
-  SATClauseList::Iterator cit(clauses);
-  while(cit.hasNext()) {
-    SATClause* cl = cit.next();
-    clausesStm << cl->toDIMACSString();
-    if(cit.hasNext()) {
-      clausesStm << "|";
-    }
+void RecordingSatSolver::writeClause(SATClause* cl)
+{
+  unsigned len = cl->length();
+  writeUnsigned(len);
+  for(unsigned i=0;i<len;i++) {
+    writeUnsigned((*cl)[i].content());
   }
+}
 
-  ASSERTION_VIOLATION_REP("Does not record useInPartialModel");
+void RecordingSatSolver::writeLimit(unsigned conflictCountLimit)
+{
+  writeUnsigned(conflictCountLimit==UINT_MAX ? 0 : conflictCountLimit+1);
+}
 
-  REC("act=ac:op="<<onlyPropagate<<":clauses="<<clausesStm.str());
+void RecordingSatSolver::addClause(SATClause* cl)
+{
+  CALL("RecordingSatSolver::addClause");
 
-  _inner->addClauses(pvi(SATClauseList::DestructiveIterator(clauses)), onlyPropagate);
+  _out->put(STO_ADD_CLAUSE);
+  writeClause(cl);
+  _inner->addClause(cl);
 }
 
-void RecordingSatSolver::randomizeAssignment()
+void RecordingSatSolver::addClauseIgnoredInPartialModel(SATClause* cl)
 {
-  CALL("RecordingSatSolver::randomizeAssignment");
+  CALL("RecordingSatSolver::addClauseIgnoredInPartialModel");
 
-  REC("act=ra");
-
-  _inner->randomizeAssignment();
+  _out->put(STO_ADD_CLAUSE_IGNORED_IN_PARTIAL_MODEL);
+  writeClause(cl);
+  _inner->addClauseIgnoredInPartialModel(cl);
 }
 
-void RecordingSatSolver::ensureVarCnt(unsigned newVarCnt)
+void RecordingSatSolver::simplify()
 {
-  CALL("RecordingSatSolver::ensureVarCnt");
+  CALL("RecordingSatSolver::simplify");
 
-  REC("act=evc:nwc="<<newVarCnt);
+  _out->put(STO_SIMPLIFY);
+  _inner->simplify();
+}
 
-  _inner->ensureVarCnt(newVarCnt);
+SATSolver::Status RecordingSatSolver::solve(unsigned conflictCountLimit)
+{
+  CALL("RecordingSatSolver::solve");
+
+  Status res = _inner->solve(conflictCountLimit);
+  _out->put(STO_SOLVE);
+  writeLimit(conflictCountLimit);
+  writeUnsigned(res);
+  // the prover may be terminated at any time, so the trace is kept complete
+  _out->flush();
+  return res;
 }
 
-void RecordingSatSolver::addAssumption(SATLiteral lit, unsigned conflictCountLimit)
+void RecordingSatSolver::addAssumption(SATLiteral lit)
 {
   CALL("RecordingSatSolver::addAssumption");
 
-  REC("act=aa:litVar="<<lit.var()<<":litPol="<<lit.polarity()<<":ccl="<<conflictCountLimit);
-
-  _inner->addAssumption(lit, conflictCountLimit);
+  _out->put(STO_ADD_ASSUMPTION);
+  writeUnsigned(lit.content());
+  _inner->addAssumption(lit);
 }
 
 void RecordingSatSolver::retractAllAssumptions()
 {
   CALL("RecordingSatSolver::retractAllAssumptions");
 
-  REC("act=raa");
-
+  _out->put(STO_RETRACT_ALL_ASSUMPTIONS);
   _inner->retractAllAssumptions();
 }
 
+SATSolver::Status RecordingSatSolver::solveUnderAssumptions(const SATLiteralStack& assumps, unsigned conflictCountLimit, bool onlyProperSubusets)
+{
+  CALL("RecordingSatSolver::solveUnderAssumptions");
 
-///////////////////////
-// SolverReplayer
-//
+  Status res = _inner->solveUnderAssumptions(assumps, conflictCountLimit, onlyProperSubusets);
+  _out->put(STO_SOLVE_UNDER_ASSUMPTIONS);
+  writeUnsigned(assumps.size());
+  for(unsigned i=0;i<assumps.size();i++) {
+    writeUnsigned(assumps[i].content());
+  }
+  writeLimit(conflictCountLimit);
+  writeUnsigned(onlyProperSubusets);
+  writeUnsigned(res);
+  _out->flush();
+
+  _failedAssumptionBuffer.reset();
+  if(res==UNSATISFIABLE) {
+    _failedAssumptionBuffer = _inner->failedAssumptions();
+  }
+  return res;
+}
 
-SolverReplayer::ActionSpec::ActionSpec()
+void RecordingSatSolver::ensureVarCount(unsigned newVarCnt)
 {
-  CALL("SolverReplayer::ActionSpec::ActionSpec");
+  CALL("RecordingSatSolver::ensureVarCount");
 
-  rdr.registerEnumOption(&action, getReplayActionReader(), "act");
-  rdr.registerUnsignedOption(&acOnlyPropagate, "op");
-  rdr.registerStringOption(&acClausesStr, "clauses");
-  rdr.registerUnsignedOption(&evcVarCnt, "nwc");
-  rdr.registerUnsignedOption(&aaLitVar, "litVar");
-  rdr.registerUnsignedOption(&aaLitPolarity, "litPol");
-  rdr.registerUnsignedOption(&aaConflictCountLimit, "ccl");
+  _out->put(STO_ENSURE_VAR_COUNT);
+  writeUnsigned(newVarCnt);
+  _inner->ensureVarCount(newVarCnt);
 }
 
-SATClause* SolverReplayer::ActionSpec::readClause(vstring str)
+unsigned RecordingSatSolver::newVar()
 {
-  CALL("SolverReplayer::ActionSpec::readClause");
+  CALL("RecordingSatSolver::newVar");
 
-  static StringStack varStrings;
-  varStrings.reset();
-  StringUtils::splitStr(str.c_str(), ' ', varStrings);
-  ASS_EQ(varStrings.top(), "0");
-  varStrings.pop();
+  _out->put(STO_NEW_VAR);
+  return _inner->newVar();
+}
 
-  static SATLiteralStack clauseLits;
-  clauseLits.reset();
+void RecordingSatSolver::suggestPolarity(unsigned var, unsigned pol)
+{
+  CALL("RecordingSatSolver::suggestPolarity");
 
-  StringStack::BottomFirstIterator vsit(varStrings);
-  while(vsit.hasNext()) {
-    vstring varSpec = vsit.next();
-    int val;
-    ALWAYS(Int::stringToInt(varSpec, val));
-    clauseLits.push(SATLiteral(abs(val), val>0));
-  }
+  _out->put(STO_SUGGEST_POLARITY);
+  writeUnsigned(var);
+  writeUnsigned(pol);
+  _inner->suggestPolarity(var, pol);
+}
 
-  SATClause* res = SATClause::fromStack(clauseLits);
-  return res;
+void RecordingSatSolver::randomizeForNextAssignment(unsigned maxVar)
+{
+  CALL("RecordingSatSolver::randomizeForNextAssignment");
+
+  _out->put(STO_RANDOMIZE);
+  writeUnsigned(maxVar);
+  _inner->randomizeForNextAssignment(maxVar);
 }
 
-void SolverReplayer::ActionSpec::readCommand(vstring str)
+
+///////////////////////
+// SolverReplayer
+//
+
+bool SolverReplayer::fail(vstring error)
 {
-  CALL("SolverReplayer::ActionSpec::readCommand");
+  _error = error;
+  return false;
+}
 
-  if(!rdr.readOptions(str)) {
-    ASSERTION_VIOLATION;
-  }
+bool SolverReplayer::readUnsigned(istream& in, unsigned& val)
+{
+  return Varint::read(in, val);
+}
 
-  if(action==RA_ADD_CLAUSES) {
-    static StringStack clauseStrings;
-    clauseStrings.reset();
-    StringUtils::splitStr(acClausesStr.c_str(), '|', clauseStrings);
-    StringStack::BottomFirstIterator csit(clauseStrings);
+bool SolverReplayer::readLiteral(istream& in, SATLiteral& lit)
+{
+  unsigned content;
+  if(!readUnsigned(in, content) || content<2) {
+    return false;
+  }
+  lit = SATLiteral(content);
+  return true;
+}
 
-    acClauses.reset();
-    while(csit.hasNext()) {
-      vstring clauseString = csit.next();
-      acClauses.push(readClause(clauseString));
-    }
+bool SolverReplayer::readLimit(istream& in, unsigned& limit)
+{
+  if(!readUnsigned(in, limit)) {
+    return false;
   }
-  else if(action==RA_ADD_ASSUMPTION) {
-    aaLit = SATLiteral(aaLitVar, aaLitPolarity==1);
+  limit = limit ? limit-1 : UINT_MAX;
+  return true;
+}
+
+bool SolverReplayer::readStatus(istream& in, SATSolver::Status& status)
+{
+  unsigned val;
+  if(!readUnsigned(in, val) || val>SATSolver::UNKNOWN) {
+    return false;
   }
+  status = static_cast<SATSolver::Status>(val);
+  return true;
 }
 
-const EnumReader<SolverReplayer::ReplayAction>& SolverReplayer::getReplayActionReader()
+/**
+ * Read a clause, or return zero if the trace is malformed
+ */
+SATClause* SolverReplayer::readClause(istream& in)
 {
-  CALL("SolverReplayer::getReplayActionReader");
+  CALL("SolverReplayer::readClause");
 
-  static bool initialized = false;
-  static EnumReader<ReplayAction> rdr;
-  if(!initialized) {
-    initialized = true;
-    rdr.addVal("ac", RA_ADD_CLAUSES);
-    rdr.addVal("aa", RA_ADD_ASSUMPTION);
-    rdr.addVal("ra", RA_RANDOMIZE_ASSIGNMENT);
-    rdr.addVal("evc", RA_ENSURE_VAR_CNT);
-    rdr.addVal("raa", RA_RETRACT_ALL_ASSUMPTIONS);
+  static SATLiteralStack lits;
+  lits.reset();
+  unsigned len;
+  if(!readUnsigned(in, len)) {
+    return 0;
   }
-  return rdr;
+  for(unsigned i=0;i<len;i++) {
+    SATLiteral lit;
+    if(!readLiteral(in, lit)) {
+      return 0;
+    }
+    lits.push(lit);
+  }
+  return SATClause::fromStack(lits);
 }
 
-void SolverReplayer::performStep(vstring cmd)
+void SolverReplayer::recordResult(SATSolver::Status recorded, SATSolver::Status res)
 {
-  CALL("SolverReplayer::performStep");
-
-  static ActionSpec aspec;
-  aspec.readCommand(cmd);
-  switch(aspec.action) {
-  case RA_ADD_ASSUMPTION:
-    _solver.addAssumption(aspec.aaLit, aspec.aaConflictCountLimit);
-    break;
-  case RA_ADD_CLAUSES:
-    _solver.addClauses(aspec.getClauses(), aspec.acOnlyPropagate!=0);
+  _stats.solves++;
+  switch(res) {
+  case SATSolver::SATISFIABLE:
+    _stats.satisfiable++;
     break;
-  case RA_ENSURE_VAR_CNT:
-    _solver.ensureVarCnt(aspec.evcVarCnt);
+  case SATSolver::UNSATISFIABLE:
+    _stats.unsatisfiable++;
     break;
-  case RA_RANDOMIZE_ASSIGNMENT:
-    _solver.randomizeAssignment();
+  case SATSolver::UNKNOWN:
+    _stats.unknown++;
     break;
-  case RA_RETRACT_ALL_ASSUMPTIONS:
-    _solver.retractAllAssumptions();
-    break;
-  default:
-    ASSERTION_VIOLATION;
+  }
+  // with a conflict limit, solvers may differ in whether they find the answer
+  if(recorded!=SATSolver::UNKNOWN && res!=SATSolver::UNKNOWN && recorded!=res) {
+    _stats.mismatches++;
   }
 }
 
-void SolverReplayer::runFromStream(istream& stm, vstring prefix)
+/**
+ * Replay the trace in @c in against the solver. Return false if the trace
+ * is malformed or needs assumptions the solver does not support.
+ *
+ * The clauses read are not deleted, as the solver does not own them.
+ */
+bool SolverReplayer::runFromStream(istream& in)
 {
   CALL("SolverReplayer::runFromStream");
 
-  size_t prefLen = prefix.length();
-  do {
-    vstring line;
-    getline(stm, line);
-    if(line.substr(0,prefLen)!=prefix) {
-      continue;
+  char magic[sizeof(SAT_TRACE_MAGIC)];
+  in.read(magic, sizeof(magic));
+  if(!in || memcmp(magic, SAT_TRACE_MAGIC, sizeof(magic))) {
+    return fail("not a SAT trace");
+  }
+
+  int startTime = env.timer->elapsedMilliseconds();
+  static SATLiteralStack assumps;
+  for(;;) {
+    int op = in.get();
+    if(op==EOF) {
+      break;
     }
-    vstring cmd = line.substr(prefLen);
-    performStep(cmd);
-  } while(!stm.eof());
+    _stats.calls++;
+
+    unsigned arg1, arg2;
+    SATLiteral lit;
+    SATClause* cl;
+    SATSolver::Status recorded;
+    SATSolver::Status res;
+    int solveStart;
+    switch(op) {
+    case STO_ENSURE_VAR_COUNT:
+      if(!readUnsigned(in, arg1)) {
+        return fail("truncated trace");
+      }
+      _solver.ensureVarCount(arg1);
+      break;
+    case STO_NEW_VAR:
+      _solver.newVar();
+      break;
+    case STO_ADD_CLAUSE:
+    case STO_ADD_CLAUSE_IGNORED_IN_PARTIAL_MODEL:
+      cl = readClause(in);
+      if(!cl) {
+        return fail("truncated trace");
+      }
+      _stats.clauses++;
+      if(op==STO_ADD_CLAUSE) {
+        _solver.addClause(cl);
+      }
+      else {
+        _solver.addClauseIgnoredInPartialModel(cl);
+      }
+      break;
+    case STO_SIMPLIFY:
+      _solver.simplify();
+      break;
+    case STO_SOLVE:
+      if(!readLimit(in, arg1) || !readStatus(in, recorded)) {
+        return fail("truncated trace");
+      }
+      solveStart = env.timer->elapsedMilliseconds();
+      res = _solver.solve(arg1);
+      _stats.solveTime += env.timer->elapsedMilliseconds()-solveStart;
+      recordResult(recorded, res);
+      break;
+    case STO_ADD_ASSUMPTION:
+      if(!readLiteral(in, lit)) {
+        return fail("truncated trace");
+      }
+      if(!_assumptionSolver) {
+        return fail("the solver does not support assumptions");
+      }
+      _assumptionSolver->addAssumption(lit);
+      break;
+    case STO_RETRACT_ALL_ASSUMPTIONS:
+      if(!_assumptionSolver) {
+        return fail("the solver does not support assumptions");
+      }
+      _assumptionSolver->retractAllAssumptions();
+      break;
+    case STO_SOLVE_UNDER_ASSUMPTIONS:
+      if(!readUnsigned(in, arg1)) {
+        return fail("truncated trace");
+      }
+      assumps.reset();
+      for(unsigned i=0;i<arg1;i++) {
+        if(!readLiteral(in, lit)) {
+          return fail("truncated trace");
+        }
+        assumps.push(lit);
+      }
+      if(!readLimit(in, arg1) || !readUnsigned(in, arg2) || !readStatus(in, recorded)) {
+        return fail("truncated trace");
+      }
+      if(!_assumptionSolver) {
+        return fail("the solver does not support assumptions");
+      }
+      solveStart = env.timer->elapsedMilliseconds();
+      res = _assumptionSolver->solveUnderAssumptions(assumps, arg1, arg2!=0);
+      _stats.solveTime += env.timer->elapsedMilliseconds()-solveStart;
+      recordResult(recorded, res);
+      break;
+    case STO_SUGGEST_POLARITY:
+      if(!readUnsigned(in, arg1) || !readUnsigned(in, arg2)) {
+        return fail("truncated trace");
+      }
+      _solver.suggestPolarity(arg1, arg2);
+      break;
+    case STO_RANDOMIZE:
+      if(!readUnsigned(in, arg1)) {
+        return fail("truncated trace");
+      }
+      _solver.randomizeForNextAssignment(arg1);
+      break;
+    default:
+      return fail("unknown operation "+Int::toString(op));
+    }
+  }
+  _stats.time = env.timer->elapsedMilliseconds()-startTime;
+  return true;
 }
 
 }
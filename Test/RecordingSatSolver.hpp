@@ -1,4 +1,3 @@
-
 /*
  * File RecordingSatSolver.hpp.
  *
@@ -12,9 +11,9 @@
  *
  * In summary, you are allowed to use Vampire for non-commercial
  * purposes but not allowed to distribute, modify, copy, create derivatives,
- * or use in competitions. 
+ * or use in competitions.
  * For other uses of Vampire please contact developers for a different
- * licence, which we will make an effort to provide. 
+ * licence, which we will make an effort to provide.
  */
 /**
  * @file RecordingSatSolver.hpp
@@ -24,10 +23,13 @@
 #ifndef __RecordingSatSolver__
 #define __RecordingSatSolver__
 
+#include <fstream>
+#include <istream>
+
 #include "Forwards.hpp"
 
 #include "Lib/ScopedPtr.hpp"
-#include "Lib/OptionsReader.hpp"
+#include "Lib/VString.hpp"
 
 #include "SAT/SATSolver.hpp"
 
@@ -35,82 +37,141 @@
 
 namespace Test {
 
+using namespace Lib;
 using namespace SAT;
 
-class RecordingSatSolver : public SATSolver {
+/**
+ * Operations recorded in a SAT solver trace
+ *
+ * A trace starts with SAT_TRACE_MAGIC and continues with one record
+ * per call: the operation byte followed by its arguments. Each argument
+ * is an unsigned integer written in seven bit groups, lowest first, with
+ * the top bit of a byte set if more bytes follow. A clause is its length
+ * followed by the contents of its literals. A conflict count limit is
+ * written as zero for UINT_MAX and as the limit plus one otherwise.
+ */
+enum SatTraceOp {
+  /** new variable count */
+  STO_ENSURE_VAR_COUNT = 1,
+  STO_NEW_VAR = 2,
+  /** clause */
+  STO_ADD_CLAUSE = 3,
+  /** clause */
+  STO_ADD_CLAUSE_IGNORED_IN_PARTIAL_MODEL = 4,
+  STO_SIMPLIFY = 5,
+  /** limit, resulting status */
+  STO_SOLVE = 6,
+  /** literal */
+  STO_ADD_ASSUMPTION = 7,
+  STO_RETRACT_ALL_ASSUMPTIONS = 8,
+  /** assumption count, assumptions, limit, only proper subsets, resulting status */
+  STO_SOLVE_UNDER_ASSUMPTIONS = 9,
+  /** variable, polarity */
+  STO_SUGGEST_POLARITY = 10,
+  /** maximal variable */
+  STO_RANDOMIZE = 11
+};
+
+extern const char SAT_TRACE_MAGIC[8];
+
+/**
+ * Forwards the calls to an inner solver and records them into a trace
+ * file, to be replayed by SolverReplayer
+ */
+class RecordingSatSolver : public SATSolverWithAssumptions {
 public:
-  RecordingSatSolver(SATSolver* inner) : _inner(inner) {}
-
-  virtual void addClauses(SATClauseIterator cit, bool onlyPropagate,bool useInPartialModel);
-  virtual void randomizeAssignment();
-  virtual void ensureVarCnt(unsigned newVarCnt);
-  virtual void addAssumption(SATLiteral lit, unsigned conflictCountLimit);
-  virtual void retractAllAssumptions();
-
-  virtual Status getStatus() { return _inner->getStatus(); }
-  virtual VarAssignment getAssignment(unsigned var) { return _inner->getAssignment(var); }
-  virtual bool isZeroImplied(unsigned var) { return _inner->isZeroImplied(var); }
-  virtual void collectZeroImplied(SATLiteralStack& acc) { return _inner->collectZeroImplied(acc); }
-  virtual SATClause* getZeroImpliedCertificate(unsigned var) { return _inner->getZeroImpliedCertificate(var); }
-  virtual bool hasAssumptions() const { return _inner->hasAssumptions(); }
-  virtual SATClause* getRefutation() { return _inner->getRefutation(); }
-
-  virtual void recordSource(unsigned var, Literal* lit){
-    _inner->recordSource(var,lit);
-  }
+  CLASS_NAME(RecordingSatSolver);
+  USE_ALLOCATOR(RecordingSatSolver);
 
-private:
+  RecordingSatSolver(SATSolverWithAssumptions* inner, vstring fileName);
+  virtual ~RecordingSatSolver();
 
-  vstring getHdr() const;
+  static SATSolverWithAssumptions* record(SATSolverWithAssumptions* inner, const Shell::Options& opt, const char* component);
 
-  SATSolverSCP _inner;
-};
+  virtual void addClause(SATClause* cl) override;
+  virtual void addClauseIgnoredInPartialModel(SATClause* cl) override;
+  virtual void simplify() override;
+  virtual Status solve(unsigned conflictCountLimit) override;
 
+  virtual void addAssumption(SATLiteral lit) override;
+  virtual void retractAllAssumptions() override;
+  virtual Status solveUnderAssumptions(const SATLiteralStack& assumps, unsigned conflictCountLimit, bool onlyProperSubusets) override;
 
-class SolverReplayer {
-public:
-  SolverReplayer(SATSolver& solver) : _solver(solver) {}
-
-  enum ReplayAction {
-    RA_ADD_CLAUSES,
-    RA_ADD_ASSUMPTION,
-    RA_RANDOMIZE_ASSIGNMENT,
-    RA_ENSURE_VAR_CNT,
-    RA_RETRACT_ALL_ASSUMPTIONS
-  };
+  virtual void ensureVarCount(unsigned newVarCnt) override;
+  virtual unsigned newVar() override;
+  virtual void suggestPolarity(unsigned var, unsigned pol) override;
+  virtual void randomizeForNextAssignment(unsigned maxVar) override;
 
-  static const EnumReader<ReplayAction>& getReplayActionReader();
-  struct ActionSpec {
-    ActionSpec();
+  virtual bool hasAssumptions() const override { return _inner->hasAssumptions(); }
+  virtual VarAssignment getAssignment(unsigned var) override { return _inner->getAssignment(var); }
+  virtual bool isZeroImplied(unsigned var) override { return _inner->isZeroImplied(var); }
+  virtual void collectZeroImplied(SATLiteralStack& acc) override { _inner->collectZeroImplied(acc); }
+  virtual SATClause* getZeroImpliedCertificate(unsigned var) override { return _inner->getZeroImpliedCertificate(var); }
+  virtual SATClause* getRefutation() override { return _inner->getRefutation(); }
+  virtual SATClauseList* getRefutationPremiseList() override { return _inner->getRefutationPremiseList(); }
 
-    ReplayAction action;
-    unsigned acOnlyPropagate;
-    vstring acClausesStr;
-    SATClauseStack acClauses;
-    unsigned evcVarCnt;
-    unsigned aaLitVar;
-    unsigned aaLitPolarity;
-    SATLiteral aaLit;
-    unsigned aaConflictCountLimit;
+  virtual void recordSource(unsigned var, Literal* lit) override {
+    _inner->recordSource(var,lit);
+  }
 
-    OptionsReader rdr;
+private:
+  void writeUnsigned(unsigned val);
+  void writeClause(SATClause* cl);
+  void writeLimit(unsigned conflictCountLimit);
 
+  ScopedPtr<SATSolverWithAssumptions> _inner;
+  std::ofstream* _out;
+};
 
-    void readCommand(vstring str);
 
-    SATClauseIterator getClauses() {
-      ASS_EQ(action, RA_ADD_CLAUSES);
-      return pvi(SATClauseStack::BottomFirstIterator(acClauses));
-    }
-  private:
-    SATClause* readClause(vstring str);
+/**
+ * Replays a trace written by RecordingSatSolver against a solver
+ */
+class SolverReplayer {
+public:
+  /**
+   * @c assumptionSolver is @c solver if it supports assumptions and zero
+   * otherwise, in which case traces with assumptions cannot be replayed.
+   */
+  SolverReplayer(SATSolver& solver, SATSolverWithAssumptions* assumptionSolver)
+  : _solver(solver), _assumptionSolver(assumptionSolver) {}
+
+  struct Stats {
+    Stats() : calls(0), clauses(0), solves(0), satisfiable(0), unsatisfiable(0),
+      unknown(0), mismatches(0), time(0), solveTime(0) {}
+
+    unsigned calls;
+    unsigned clauses;
+    unsigned solves;
+    unsigned satisfiable;
+    unsigned unsatisfiable;
+    unsigned unknown;
+    /** solving calls with a result contradicting the recorded one */
+    unsigned mismatches;
+    /** time in milliseconds */
+    int time;
+    int solveTime;
   };
 
-  void performStep(vstring cmd);
-  void runFromStream(istream& stm, vstring prefix);
+  bool runFromStream(std::istream& in);
+
+  const Stats& stats() const { return _stats; }
+  /** If runFromStream() failed, the reason of the failure */
+  const vstring& error() const { return _error; }
 
 private:
+  bool readUnsigned(std::istream& in, unsigned& val);
+  bool readLiteral(std::istream& in, SATLiteral& lit);
+  bool readLimit(std::istream& in, unsigned& limit);
+  bool readStatus(std::istream& in, SATSolver::Status& status);
+  SATClause* readClause(std::istream& in);
+  bool fail(vstring error);
+  void recordResult(SATSolver::Status recorded, SATSolver::Status res);
+
   SATSolver& _solver;
+  SATSolverWithAssumptions* _assumptionSolver;
+  Stats _stats;
+  vstring _error;
 };
 
 }
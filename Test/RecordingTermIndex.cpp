@@ -0,0 +1,640 @@
+/*
+ * File RecordingTermIndex.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file RecordingTermIndex.cpp
+ * Implements classes RecordingTermIndexingStructure, TermIndexTrace and TermIndexReplayer.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstring>
+
+#include "Lib/Allocator.hpp"
+#include "Lib/Environment.hpp"
+#include "Lib/Int.hpp"
+#include "Lib/System.hpp"
+#include "Lib/Varint.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Inference.hpp"
+#include "Kernel/Signature.hpp"
+#include "Kernel/SortHelper.hpp"
+#include "Kernel/Sorts.hpp"
+
+#include "Indexing/CodeTreeInterfaces.hpp"
+#include "Indexing/TermSubstitutionTree.hpp"
+
+#include "Shell/Options.hpp"
+
+#include "RecordingTermIndex.hpp"
+
+namespace Test
+{
+
+using namespace std;
+
+const char TERM_INDEX_TRACE_MAGIC[8] = { 'V', 'T', 'I', 'D', 'T', 'R', 'C', '1' };
+
+/////////////////////////////////////
+// RecordingTermIndexingStructure
+//
+
+RecordingTermIndexingStructure::RecordingTermIndexingStructure(TermIndexingStructure* inner, vstring fileName)
+: _inner(inner)
+{
+  CALL("RecordingTermIndexingStructure::RecordingTermIndexingStructure");
+
+  {
+    BYPASSING_ALLOCATOR; // the buffers of ofstream are not allocated via Allocator
+    _out = new ofstream(fileName.c_str(), ios::out | ios::binary | ios::trunc);
+  }
+  if(!*_out) {
+    USER_ERROR("Cannot open index trace file "+fileName);
+  }
+  _out->write(TERM_INDEX_TRACE_MAGIC, sizeof(TERM_INDEX_TRACE_MAGIC));
+}
+
+RecordingTermIndexingStructure::~RecordingTermIndexingStructure()
+{
+  CALL("RecordingTermIndexingStructure::~RecordingTermIndexingStructure");
+
+  BYPASSING_ALLOCATOR;
+  delete _out;
+}
+
+/**
+ * If the index_trace option is set, return @c inner wrapped into a structure
+ * recording into a new trace file named after @c index. Otherwise return @c inner.
+ */
+TermIndexingStructure* RecordingTermIndexingStructure::record(TermIndexingStructure* inner, const Shell::Options& opt, const char* index)
+{
+  CALL("RecordingTermIndexingStructure::record");
+
+  if(opt.indexTrace()=="off") {
+    return inner;
+  }
+  static unsigned traceCnt = 0;
+  vstring fileName = opt.indexTrace()+"."+index+"."+Int::toString(System::getPID())+"."
+      +Int::toString(traceCnt++)+".trace";
+  return new RecordingTermIndexingStructure(inner, fileName);
+}
+
+void RecordingTermIndexingStructure::writeUnsigned(unsigned val)
+{
+  Varint::write(val, *_out);
+}
+
+void RecordingTermIndexingStructure::writeName(const vstring& name)
+{
+  writeUnsigned(name.size());
+  _out->write(name.c_str(), name.size());
+}
+
+void RecordingTermIndexingStructure::declareSort(unsigned sort)
+{
+  CALL("RecordingTermIndexingStructure::declareSort");
+
+  if(!_sorts.insert(sort)) {
+    return;
+  }
+  _out->put(TIO_SORT);
+  writeUnsigned(sort);
+  writeName(env.sorts->sortName(sort));
+}
+
+/**
+ * Append the term @c t to the arguments of the record being written,
+ * declaring its symbols first. Return false if it contains a special term.
+ */
+bool RecordingTermIndexingStructure::addTerm(TermList t)
+{
+  CALL("RecordingTermIndexingStructure::addTerm");
+
+  static Stack<TermList> todo;
+  todo.reset();
+  todo.push(t);
+  while(todo.isNonEmpty()) {
+    TermList s = todo.pop();
+    if(s.isOrdinaryVar()) {
+      _args.push(s.var()<<2);
+      continue;
+    }
+    if(s.isSpecialVar()) {
+      _args.push((s.var()<<2)|1);
+      continue;
+    }
+    Term* trm = s.term();
+    if(trm->isSpecial()) {
+      return false;
+    }
+    unsigned fn = trm->functor();
+    if(!_functions.find(fn)) {
+      _functions.insert(fn);
+      OperatorType* type = env.signature->getFunction(fn)->fnType();
+      for(unsigned i=0;i<trm->arity();i++) {
+        declareSort(type->arg(i));
+      }
+      declareSort(type->result());
+      _out->put(TIO_FUNCTION);
+      writeUnsigned(fn);
+      writeName(env.signature->functionName(fn));
+      writeUnsigned(trm->arity());
+      for(unsigned i=0;i<trm->arity();i++) {
+        writeUnsigned(type->arg(i));
+      }
+      writeUnsigned(type->result());
+    }
+    _args.push((fn<<2)|2);
+    for(unsigned i=trm->arity();i>0;i--) {
+      todo.push(*trm->nthArgument(i-1));
+    }
+  }
+  return true;
+}
+
+bool RecordingTermIndexingStructure::addLiteral(Literal* lit)
+{
+  CALL("RecordingTermIndexingStructure::addLiteral");
+
+  unsigned pred = lit->functor();
+  if(pred && !_predicates.find(pred)) {
+    _predicates.insert(pred);
+    _out->put(TIO_PREDICATE);
+    writeUnsigned(pred);
+    writeName(env.signature->predicateName(pred));
+    writeUnsigned(lit->arity());
+  }
+  _args.push((pred<<1)|(lit->polarity() ? 1 : 0));
+  if(lit->isEquality()) {
+    unsigned sort = SortHelper::getEqualityArgumentSort(lit);
+    declareSort(sort);
+    _args.push(sort);
+  }
+  for(unsigned i=0;i<lit->arity();i++) {
+    if(!addTerm(*lit->nthArgument(i))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void RecordingTermIndexingStructure::writeRecord(TermIndexTraceOp op)
+{
+  _out->put(op);
+  for(unsigned i=0;i<_args.size();i++) {
+    writeUnsigned(_args[i]);
+  }
+}
+
+void RecordingTermIndexingStructure::recordQuery(TermIndexTraceOp op, TermList t, bool retrieveSubstitutions)
+{
+  CALL("RecordingTermIndexingStructure::recordQuery");
+
+  _args.reset();
+  if(addTerm(t)) {
+    _args.push(retrieveSubstitutions);
+    writeRecord(op);
+  }
+}
+
+void RecordingTermIndexingStructure::insert(TermList t, Literal* lit, Clause* cls)
+{
+  CALL("RecordingTermIndexingStructure::insert");
+
+  _args.reset();
+  if(addTerm(t) && addLiteral(lit)) {
+    _args.push(cls->number());
+    writeRecord(TIO_INSERT);
+  }
+  _inner->insert(t, lit, cls);
+}
+
+void RecordingTermIndexingStructure::remove(TermList t, Literal* lit, Clause* cls)
+{
+  CALL("RecordingTermIndexingStructure::remove");
+
+  _args.reset();
+  if(addTerm(t) && addLiteral(lit)) {
+    _args.push(cls->number());
+    writeRecord(TIO_REMOVE);
+  }
+  _inner->remove(t, lit, cls);
+}
+
+TermQueryResultIterator RecordingTermIndexingStructure::getUnifications(TermList t, bool retrieveSubstitutions)
+{
+  recordQuery(TIO_UNIFICATIONS, t, retrieveSubstitutions);
+  return _inner->getUnifications(t, retrieveSubstitutions);
+}
+
+TermQueryResultIterator RecordingTermIndexingStructure::getUnificationsWithConstraints(TermList t, bool retrieveSubstitutions)
+{
+  recordQuery(TIO_UNIFICATIONS_WITH_CONSTRAINTS, t, retrieveSubstitutions);
+  return _inner->getUnificationsWithConstraints(t, retrieveSubstitutions);
+}
+
+TermQueryResultIterator RecordingTermIndexingStructure::getGeneralizations(TermList t, bool retrieveSubstitutions)
+{
+  recordQuery(TIO_GENERALIZATIONS, t, retrieveSubstitutions);
+  return _inner->getGeneralizations(t, retrieveSubstitutions);
+}
+
+TermQueryResultIterator RecordingTermIndexingStructure::getInstances(TermList t, bool retrieveSubstitutions)
+{
+  recordQuery(TIO_INSTANCES, t, retrieveSubstitutions);
+  return _inner->getInstances(t, retrieveSubstitutions);
+}
+
+bool RecordingTermIndexingStructure::generalizationExists(TermList t)
+{
+  CALL("RecordingTermIndexingStructure::generalizationExists");
+
+  _args.reset();
+  if(addTerm(t)) {
+    writeRecord(TIO_GENERALIZATION_EXISTS);
+  }
+  return _inner->generalizationExists(t);
+}
+
+/////////////////////
+// TermIndexTrace
+//
+
+bool TermIndexTrace::fail(vstring error)
+{
+  _error = error;
+  return false;
+}
+
+bool TermIndexTrace::readUnsigned(istream& in, unsigned& val)
+{
+  return Varint::read(in, val);
+}
+
+bool TermIndexTrace::readName(istream& in, vstring& name)
+{
+  unsigned len;
+  if(!readUnsigned(in, len)) {
+    return false;
+  }
+  name.resize(len);
+  in.read(&name[0], len);
+  return static_cast<bool>(in);
+}
+
+bool TermIndexTrace::readTerm(istream& in, TermList& t)
+{
+  CALL("TermIndexTrace::readTerm");
+
+  unsigned val;
+  if(!readUnsigned(in, val)) {
+    return false;
+  }
+  switch(val&3) {
+  case 0:
+    t.makeVar(val>>2);
+    return true;
+  case 1:
+    t.makeSpecialVar(val>>2);
+    return true;
+  case 2:
+    break;
+  default:
+    return false;
+  }
+  unsigned fn;
+  if(!_functions.find(val>>2, fn)) {
+    return false;
+  }
+  unsigned arity = env.signature->functionArity(fn);
+  static Stack<TermList> args;
+  unsigned argsStart = args.size();
+  for(unsigned i=0;i<arity;i++) {
+    TermList arg;
+    if(!readTerm(in, arg)) {
+      args.truncate(argsStart);
+      return false;
+    }
+    args.push(arg);
+  }
+  t = TermList(Term::create(fn, arity, args.begin()+argsStart));
+  args.truncate(argsStart);
+  return true;
+}
+
+bool TermIndexTrace::readLiteral(istream& in, Literal*& lit)
+{
+  CALL("TermIndexTrace::readLiteral");
+
+  unsigned header;
+  if(!readUnsigned(in, header)) {
+    return false;
+  }
+  bool polarity = header&1;
+  if(!(header>>1)) {
+    unsigned sort;
+    TermList lhs, rhs;
+    if(!readUnsigned(in, sort) || !_sorts.find(sort, sort) || !readTerm(in, lhs) || !readTerm(in, rhs)) {
+      return false;
+    }
+    lit = Literal::createEquality(polarity, lhs, rhs, sort);
+    return true;
+  }
+  unsigned pred;
+  if(!_predicates.find(header>>1, pred)) {
+    return false;
+  }
+  unsigned arity = env.signature->predicateArity(pred);
+  static Stack<TermList> args;
+  args.reset();
+  for(unsigned i=0;i<arity;i++) {
+    TermList arg;
+    if(!readTerm(in, arg)) {
+      return false;
+    }
+    args.push(arg);
+  }
+  lit = Literal::create(pred, arity, polarity, false, args.begin());
+  return true;
+}
+
+/**
+ * Read the trace from @c in. Return false if it is not a term index trace
+ * or is malformed.
+ */
+bool TermIndexTrace::load(istream& in)
+{
+  CALL("TermIndexTrace::load");
+
+  char magic[sizeof(TERM_INDEX_TRACE_MAGIC)];
+  in.read(magic, sizeof(magic));
+  if(!in || memcmp(magic, TERM_INDEX_TRACE_MAGIC, sizeof(magic))) {
+    return fail("not a term index trace");
+  }
+
+  for(;;) {
+    int op = in.get();
+    if(op==EOF) {
+      return true;
+    }
+
+    unsigned num, arity, val;
+    vstring name;
+    Operation rec;
+    rec.op = static_cast<TermIndexTraceOp>(op);
+    rec.retrieveSubstitutions = false;
+    rec.literal = 0;
+    rec.clause = 0;
+    bool complete;
+    switch(op) {
+    case TIO_SORT:
+      complete = readUnsigned(in, num) && readName(in, name);
+      if(complete) {
+        _sorts.insert(num, env.sorts->addSort(name, false));
+      }
+      break;
+    case TIO_FUNCTION: {
+      static Stack<unsigned> sorts;
+      sorts.reset();
+      complete = readUnsigned(in, num) && readName(in, name) && readUnsigned(in, arity);
+      for(unsigned i=0;complete && i<=arity;i++) {
+        complete = readUnsigned(in, val) && _sorts.find(val, val);
+        sorts.push(val);
+      }
+      if(complete) {
+        bool added;
+        unsigned fn = env.signature->addFunction(name, arity, added);
+        if(added) {
+          env.signature->getFunction(fn)->setType(OperatorType::getFunctionType(arity, sorts.begin(), sorts.top()));
+        }
+        _functions.insert(num, fn);
+      }
+      break;
+    }
+    case TIO_PREDICATE:
+      complete = readUnsigned(in, num) && readName(in, name) && readUnsigned(in, arity);
+      if(complete) {
+        _predicates.insert(num, env.signature->addPredicate(name, arity));
+      }
+      break;
+    case TIO_INSERT:
+    case TIO_REMOVE:
+      complete = readTerm(in, rec.term) && readLiteral(in, rec.literal) && readUnsigned(in, num);
+      if(complete) {
+        Clause** pcl;
+        if(_clauses.getValuePtr(num, pcl)) {
+          Stack<Literal*> lits;
+          lits.push(rec.literal);
+          *pcl = Clause::fromStack(lits, Unit::AXIOM, new Inference(Inference::INPUT));
+        }
+        rec.clause = *pcl;
+        _ops.push(rec);
+      }
+      break;
+    case TIO_UNIFICATIONS:
+    case TIO_UNIFICATIONS_WITH_CONSTRAINTS:
+    case TIO_GENERALIZATIONS:
+    case TIO_INSTANCES:
+      complete = readTerm(in, rec.term) && readUnsigned(in, val);
+      if(complete) {
+        rec.retrieveSubstitutions = val;
+        _ops.push(rec);
+      }
+      break;
+    case TIO_GENERALIZATION_EXISTS:
+      complete = readTerm(in, rec.term);
+      if(complete) {
+        _ops.push(rec);
+      }
+      break;
+    default:
+      return fail("unknown operation "+Int::toString(op));
+    }
+    if(!complete) {
+      if(in.eof()) {
+        _truncated = true;
+        return true;
+      }
+      return fail("malformed record");
+    }
+  }
+}
+
+/////////////////////////
+// TermIndexReplayer
+//
+
+TermIndexReplayer::TermIndexReplayer(TermIndexingStructure& index, const vstring& indexName)
+: _index(index), _indexName(indexName), _stats(TIO_LAST+1), _skipped(0), _memory(0), _peakMemory(0)
+{
+}
+
+/**
+ * Create the term indexing structure called @c indexName, or return
+ * zero if there is none
+ */
+TermIndexingStructure* TermIndexReplayer::createIndex(const vstring& indexName)
+{
+  CALL("TermIndexReplayer::createIndex");
+
+  if(indexName=="substitution_tree") {
+    return new TermSubstitutionTree();
+  }
+  if(indexName=="substitution_tree_uwa") {
+    return new TermSubstitutionTree(true);
+  }
+  if(indexName=="code_tree") {
+    return new CodeTreeTIS();
+  }
+  return 0;
+}
+
+bool TermIndexReplayer::supports(const vstring& indexName, TermIndexTraceOp op)
+{
+  switch(op) {
+  case TIO_UNIFICATIONS:
+  case TIO_INSTANCES:
+    return indexName!="code_tree";
+  case TIO_UNIFICATIONS_WITH_CONSTRAINTS:
+    return indexName=="substitution_tree_uwa";
+  default:
+    return true;
+  }
+}
+
+const char* TermIndexReplayer::opName(TermIndexTraceOp op)
+{
+  switch(op) {
+  case TIO_INSERT:
+    return "insert";
+  case TIO_REMOVE:
+    return "remove";
+  case TIO_UNIFICATIONS:
+    return "unifications";
+  case TIO_UNIFICATIONS_WITH_CONSTRAINTS:
+    return "unifications_uwa";
+  case TIO_GENERALIZATIONS:
+    return "generalizations";
+  case TIO_INSTANCES:
+    return "instances";
+  case TIO_GENERALIZATION_EXISTS:
+    return "generalization_exists";
+  default:
+    ASSERTION_VIOLATION;
+    return "";
+  }
+}
+
+/** Total latency in nanoseconds */
+unsigned long TermIndexReplayer::OpStats::time() const
+{
+  unsigned long res = 0;
+  for(unsigned i=0;i<latencies.size();i++) {
+    res += latencies[i];
+  }
+  return res;
+}
+
+/** Latency in nanoseconds not exceeded by @c pct percent of the operations */
+unsigned TermIndexReplayer::OpStats::percentile(unsigned pct)
+{
+  if(latencies.isEmpty()) {
+    return 0;
+  }
+  unsigned idx = (latencies.size()-1)*pct/100;
+  std::nth_element(latencies.begin(), latencies.begin()+idx, latencies.end());
+  return latencies[idx];
+}
+
+/**
+ * Perform the operations of @c trace on the indexing structure. Queries are
+ * run to completion, queries the structure does not support are skipped.
+ */
+void TermIndexReplayer::run(const TermIndexTrace& trace)
+{
+  CALL("TermIndexReplayer::run");
+
+  typedef std::chrono::steady_clock Clock;
+
+  size_t startMemory = Allocator::getUsedMemory();
+  const Stack<TermIndexTrace::Operation>& ops = trace.operations();
+  for(unsigned i=0;i<ops.size();i++) {
+    const TermIndexTrace::Operation& rec = ops[i];
+    if(!supports(_indexName, rec.op)) {
+      _skipped++;
+      _results.push(UINT_MAX);
+      continue;
+    }
+
+    unsigned results = 0;
+    TermQueryResultIterator qit = TermQueryResultIterator::getEmpty();
+    Clock::time_point start = Clock::now();
+    switch(rec.op) {
+    case TIO_INSERT:
+      _index.insert(rec.term, rec.literal, rec.clause);
+      break;
+    case TIO_REMOVE:
+      _index.remove(rec.term, rec.literal, rec.clause);
+      break;
+    case TIO_UNIFICATIONS:
+      qit = _index.getUnifications(rec.term, rec.retrieveSubstitutions);
+      break;
+    case TIO_UNIFICATIONS_WITH_CONSTRAINTS:
+      qit = _index.getUnificationsWithConstraints(rec.term, rec.retrieveSubstitutions);
+      break;
+    case TIO_GENERALIZATIONS:
+      qit = _index.getGeneralizations(rec.term, rec.retrieveSubstitutions);
+      break;
+    case TIO_INSTANCES:
+      qit = _index.getInstances(rec.term, rec.retrieveSubstitutions);
+      break;
+    case TIO_GENERALIZATION_EXISTS:
+      results = _index.generalizationExists(rec.term) ? 1 : 0;
+      break;
+    default:
+      ASSERTION_VIOLATION;
+    }
+    while(qit.hasNext()) {
+      qit.next();
+      results++;
+    }
+    qit = TermQueryResultIterator::getEmpty();
+    Clock::duration latency = Clock::now()-start;
+
+    OpStats& st = _stats[rec.op];
+    st.count++;
+    st.latencies.push(static_cast<unsigned>(std::min<long long>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count(), UINT_MAX)));
+    if(rec.op==TIO_INSERT || rec.op==TIO_REMOVE) {
+      _results.push(UINT_MAX);
+      size_t used = Allocator::getUsedMemory();
+      if(used>startMemory) {
+        _peakMemory = max(_peakMemory, used-startMemory);
+      }
+    }
+    else {
+      st.results += results;
+      _results.push(results);
+    }
+  }
+  size_t used = Allocator::getUsedMemory();
+  _memory = used>startMemory ? used-startMemory : 0;
+}
+
+}
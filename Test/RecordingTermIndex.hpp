@@ -0,0 +1,238 @@
+/*
+ * File RecordingTermIndex.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file RecordingTermIndex.hpp
+ * Defines classes RecordingTermIndexingStructure, TermIndexTrace and TermIndexReplayer.
+ */
+
+#ifndef __RecordingTermIndex__
+#define __RecordingTermIndex__
+
+#include <fstream>
+#include <istream>
+
+#include "Forwards.hpp"
+
+#include "Lib/DArray.hpp"
+#include "Lib/DHMap.hpp"
+#include "Lib/DHSet.hpp"
+#include "Lib/ScopedPtr.hpp"
+#include "Lib/Stack.hpp"
+#include "Lib/VString.hpp"
+
+#include "Kernel/Term.hpp"
+
+#include "Indexing/TermIndexingStructure.hpp"
+
+namespace Test {
+
+using namespace Lib;
+using namespace Kernel;
+using namespace Indexing;
+
+/**
+ * Operations recorded in a term index trace
+ *
+ * A trace starts with TERM_INDEX_TRACE_MAGIC and continues with one record
+ * per operation: the operation byte followed by its arguments, unsigned
+ * integers written in seven bit groups as in a SAT trace. Sorts and symbols
+ * are declared before the first record using them, a name is its length
+ * followed by its characters.
+ *
+ * A term is written in prefix order. A variable is four times its number,
+ * plus one if it is a special variable, a non-variable term is four times
+ * its functor plus two, followed by its arguments. A literal is twice its
+ * predicate plus its polarity, followed by the sort of the arguments if
+ * it is an equality, and by its arguments.
+ */
+enum TermIndexTraceOp {
+  /** sort, name */
+  TIO_SORT = 1,
+  /** functor, name, arity, argument sorts, result sort */
+  TIO_FUNCTION = 2,
+  /** predicate, name, arity */
+  TIO_PREDICATE = 3,
+  /** term, literal, clause number */
+  TIO_INSERT = 4,
+  TIO_REMOVE = 5,
+  /** term, whether substitutions are retrieved */
+  TIO_UNIFICATIONS = 6,
+  TIO_UNIFICATIONS_WITH_CONSTRAINTS = 7,
+  TIO_GENERALIZATIONS = 8,
+  TIO_INSTANCES = 9,
+  /** term */
+  TIO_GENERALIZATION_EXISTS = 10,
+
+  TIO_LAST = TIO_GENERALIZATION_EXISTS
+};
+
+extern const char TERM_INDEX_TRACE_MAGIC[8];
+
+/**
+ * Forwards the operations to an inner term indexing structure and records
+ * them into a trace file, to be replayed by TermIndexReplayer
+ *
+ * Terms containing special terms cannot be written, the operations on
+ * them are forwarded without being recorded.
+ */
+class RecordingTermIndexingStructure : public TermIndexingStructure {
+public:
+  CLASS_NAME(RecordingTermIndexingStructure);
+  USE_ALLOCATOR(RecordingTermIndexingStructure);
+
+  RecordingTermIndexingStructure(TermIndexingStructure* inner, vstring fileName);
+  virtual ~RecordingTermIndexingStructure();
+
+  static TermIndexingStructure* record(TermIndexingStructure* inner, const Shell::Options& opt, const char* index);
+
+  virtual void insert(TermList t, Literal* lit, Clause* cls) override;
+  virtual void remove(TermList t, Literal* lit, Clause* cls) override;
+
+  virtual TermQueryResultIterator getUnifications(TermList t, bool retrieveSubstitutions) override;
+  virtual TermQueryResultIterator getUnificationsWithConstraints(TermList t, bool retrieveSubstitutions) override;
+  virtual TermQueryResultIterator getGeneralizations(TermList t, bool retrieveSubstitutions) override;
+  virtual TermQueryResultIterator getInstances(TermList t, bool retrieveSubstitutions) override;
+  virtual bool generalizationExists(TermList t) override;
+
+#if VDEBUG
+  virtual void markTagged() override { _inner->markTagged(); }
+#endif
+
+private:
+  void writeUnsigned(unsigned val);
+  void writeName(const vstring& name);
+  void declareSort(unsigned sort);
+  bool addTerm(TermList t);
+  bool addLiteral(Literal* lit);
+  void writeRecord(TermIndexTraceOp op);
+  void recordQuery(TermIndexTraceOp op, TermList t, bool retrieveSubstitutions);
+
+  ScopedPtr<TermIndexingStructure> _inner;
+  std::ofstream* _out;
+  DHSet<unsigned> _sorts;
+  DHSet<unsigned> _functions;
+  DHSet<unsigned> _predicates;
+  /** arguments of the record being written */
+  Stack<unsigned> _args;
+};
+
+
+/**
+ * A term index trace read into memory, so that it can be replayed
+ * against several indexing structures
+ *
+ * The recorded symbols and sorts are added to the signature. For every
+ * recorded clause a unit clause is created from the first literal
+ * recorded with it.
+ */
+class TermIndexTrace {
+public:
+  CLASS_NAME(TermIndexTrace);
+  USE_ALLOCATOR(TermIndexTrace);
+
+  struct Operation {
+    TermIndexTraceOp op;
+    bool retrieveSubstitutions;
+    TermList term;
+    Literal* literal;
+    Clause* clause;
+  };
+
+  TermIndexTrace() : _truncated(false) {}
+
+  bool load(std::istream& in);
+
+  const Stack<Operation>& operations() const { return _ops; }
+  /**
+   * True if the trace ends in the middle of a record, as it does when the
+   * prover was terminated. The records before are replayed.
+   */
+  bool truncated() const { return _truncated; }
+  /** If load() failed, the reason of the failure */
+  const vstring& error() const { return _error; }
+
+private:
+  bool readUnsigned(std::istream& in, unsigned& val);
+  bool readName(std::istream& in, vstring& name);
+  bool readTerm(std::istream& in, TermList& t);
+  bool readLiteral(std::istream& in, Literal*& lit);
+  bool fail(vstring error);
+
+  Stack<Operation> _ops;
+  /** recorded sorts and symbols mapped to the ones in the signature */
+  DHMap<unsigned,unsigned> _sorts;
+  DHMap<unsigned,unsigned> _functions;
+  DHMap<unsigned,unsigned> _predicates;
+  DHMap<unsigned,Clause*> _clauses;
+  bool _truncated;
+  vstring _error;
+};
+
+
+/**
+ * Replays a term index trace against an indexing structure, measuring
+ * the latency of each operation and the memory used by the structure
+ */
+class TermIndexReplayer {
+public:
+  TermIndexReplayer(TermIndexingStructure& index, const vstring& indexName);
+
+  static TermIndexingStructure* createIndex(const vstring& indexName);
+  static bool supports(const vstring& indexName, TermIndexTraceOp op);
+  static const char* opName(TermIndexTraceOp op);
+
+  struct OpStats {
+    OpStats() : count(0), results(0) {}
+
+    unsigned count;
+    unsigned long results;
+    /** latencies in nanoseconds */
+    Stack<unsigned> latencies;
+
+    unsigned long time() const;
+    unsigned percentile(unsigned pct);
+  };
+
+  void run(const TermIndexTrace& trace);
+
+  /** Statistics of the operation @c op, valid for TIO_INSERT to TIO_LAST */
+  OpStats& stats(TermIndexTraceOp op) { return _stats[op]; }
+  /** Number of queries not supported by the indexing structure */
+  unsigned skipped() const { return _skipped; }
+  /** Growth of the used memory when the trace ended and at its peak */
+  size_t memory() const { return _memory; }
+  size_t peakMemory() const { return _peakMemory; }
+  /**
+   * For each operation of the trace, the number of results of a query,
+   * or UINT_MAX for updates and skipped queries
+   */
+  const Stack<unsigned>& results() const { return _results; }
+
+private:
+  TermIndexingStructure& _index;
+  vstring _indexName;
+  DArray<OpStats> _stats;
+  unsigned _skipped;
+  size_t _memory;
+  size_t _peakMemory;
+  Stack<unsigned> _results;
+};
+
+}
+
+#endif // __RecordingTermIndex__
@@ -0,0 +1,158 @@
+/*
+ * File tBigInteger.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+
+#include <climits>
+
+#include "Lib/BigInteger.hpp"
+#include "Lib/Random.hpp"
+
+#include "Kernel/Theory.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID bigInteger
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+
+static BigInteger big(const char* str)
+{
+  BigInteger res;
+  ALWAYS(BigInteger::fromString(str, res));
+  return res;
+}
+
+static vstring toString(__int128 val)
+{
+  bool negative = val<0;
+  unsigned __int128 abs = negative ? -static_cast<unsigned __int128>(val) : val;
+  vstring res;
+  do {
+    res = static_cast<char>('0'+abs%10) + res;
+    abs /= 10;
+  } while (abs);
+  return negative ? "-"+res : res;
+}
+
+TEST_FUN(bigIntegerSmallBoundary)
+{
+  BigInteger max(INT_MAX);
+  BigInteger min(INT_MIN);
+
+  ASS(max.fitsInt());
+  ASS(!(max+1).fitsInt());
+  ASS_EQ((max+1).toString(), "2147483648");
+  ASS_EQ((max+1)-1, max);
+  ASS((max+1-1).fitsInt());
+
+  ASS(!(-min).fitsInt());
+  ASS_EQ((-min).toString(), "2147483648");
+  ASS_EQ(-(-min), min);
+  ASS_EQ(min/BigInteger(-1), -min);
+  ASS_EQ(min%BigInteger(-1), BigInteger(0));
+  ASS_EQ((min*min).toString(), "4611686018427387904");
+}
+
+TEST_FUN(bigIntegerStrings)
+{
+  const char* nums[] = { "0", "-1", "123456789", "1234567890", "-1000000000000000000000",
+      "340282366920938463463374607431768211456", "-99999999999999999999999999999999999" };
+  for (unsigned i=0; i<sizeof(nums)/sizeof(nums[0]); i++) {
+    ASS_EQ(big(nums[i]).toString(), nums[i]);
+  }
+  ASS_EQ(big("+0042").toString(), "42");
+  ASS_EQ(big("-000000000000000000000000").toString(), "0");
+  BigInteger res;
+  ASS(!BigInteger::fromString("", res));
+  ASS(!BigInteger::fromString("-", res));
+  ASS(!BigInteger::fromString("12a", res));
+}
+
+TEST_FUN(bigIntegerArithmetic)
+{
+  // compare with 128-bit arithmetic on values of up to 62 bits
+  for (unsigned i=0; i<2000; i++) {
+    long long a = (static_cast<long long>(Random::getInteger(1<<30))<<Random::getInteger(32)) - (1ll<<Random::getInteger(60));
+    long long b = (static_cast<long long>(Random::getInteger(1<<30))<<Random::getInteger(32)) - (1ll<<Random::getInteger(60));
+    BigInteger ba = big(toString(a).c_str());
+    BigInteger bb = big(toString(b).c_str());
+
+    ASS_EQ((ba+bb).toString(), toString(static_cast<__int128>(a)+b));
+    ASS_EQ((ba-bb).toString(), toString(static_cast<__int128>(a)-b));
+    ASS_EQ((ba*bb).toString(), toString(static_cast<__int128>(a)*b));
+    ASS_EQ(BigInteger::compare(ba, bb), (a>b)-(a<b));
+    if (b) {
+      ASS_EQ((ba/bb).toString(), toString(a/b));
+      ASS_EQ((ba%bb).toString(), toString(a%b));
+      // division of numbers that do not fit into 64 bits
+      ASS_EQ((ba*bb*ba)/bb, ba*ba);
+      BigInteger x = ba*bb*ba+ba;
+      BigInteger y = bb*bb+ba;
+      if (!y.isZero()) {
+        BigInteger q = x/y;
+        BigInteger r = x%y;
+        ASS_EQ(q*y+r, x);
+        ASS_L(r.abs(), y.abs());
+        ASS(r.isZero() || r.sign()==x.sign());
+      }
+    }
+  }
+}
+
+TEST_FUN(bigIntegerGcd)
+{
+  BigInteger p = big("1000000007");
+  BigInteger q = big("998244353");
+  BigInteger r = big("12345678910111213");
+  ASS_EQ(BigInteger::gcd(p*q*r, p*r*r), p*r);
+  ASS_EQ(BigInteger::gcd(-p*q, q), q);
+  ASS_EQ(BigInteger::gcd(0, -p*q), p*q);
+  ASS_EQ(BigInteger::gcd(0, 0), BigInteger(0));
+  ASS_EQ((p*q*r).bitLength(), 114u);
+  ASS_EQ(BigInteger(0).bitLength(), 0u);
+  ASS_EQ(BigInteger(INT_MIN).bitLength(), 32u);
+}
+
+TEST_FUN(bigIntegerConstants)
+{
+  IntegerConstantType a("123456789012345678901234567890");
+  IntegerConstantType b(-7);
+
+  ASS_EQ((a*a/a).toString(), a.toString());
+  ASS_EQ(IntegerConstantType(-7).quotientE(2), -4);
+  ASS_EQ(IntegerConstantType(-7).quotientE(-2), 4);
+  ASS_EQ(IntegerConstantType(-7).quotientF(2), -4);
+  ASS_EQ(IntegerConstantType(7).quotientF(-2), -4);
+  ASS_EQ(IntegerConstantType(-7).quotientT(2), -3);
+  IntegerConstantType rem = -a - (-a).quotientE(b)*b;
+  ASS(rem>=0);
+  ASS(rem<7);
+
+  RationalConstantType r(a, a*IntegerConstantType(6));
+  ASS_EQ(r.toString(), "1/6");
+
+  RealConstantType e("1.5e40");
+  ASS_EQ(e.toString(), "15000000000000000000000000000000000000000/1");
+  RealConstantType f("-2.5E-3");
+  ASS_EQ(f.toString(), "-1/400");
+
+  ASS_EQ(IntegerConstantType::comparePrecedence(a, -a), LESS);
+  ASS_EQ(IntegerConstantType::comparePrecedence(a, b), GREATER);
+}
@@ -0,0 +1,106 @@
+/*
+ * File tCongruenceClosure.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+
+#include "Lib/Environment.hpp"
+#include "Lib/Metaiterators.hpp"
+#include "Lib/Random.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Signature.hpp"
+#include "Kernel/Term.hpp"
+
+#include "DP/SimpleCongruenceClosure.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID congruenceClosure
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+using namespace DP;
+
+static TermList randomTerm(unsigned f, unsigned* consts, unsigned constCnt)
+{
+  TermList res(Term::createConstant(consts[Random::getInteger(constCnt)]));
+  unsigned depth = Random::getInteger(3);
+  for(unsigned i=0;i<depth;i++) {
+    res = TermList(Term::create1(f, res));
+  }
+  return res;
+}
+
+static DecisionProcedure::Status freshStatus(const LiteralStack& lits)
+{
+  SimpleCongruenceClosure cc(0);
+  cc.addLiterals(pvi(LiteralStack::ConstIterator(lits)), false);
+  return cc.getStatus(false);
+}
+
+/**
+ * Assert and retract random ground literals and compare the results
+ * with a congruence closure built from scratch
+ */
+TEST_FUN(congruenceClosurePushPop)
+{
+  unsigned f = env.signature->addFunction("cc_f",1);
+  unsigned p = env.signature->addPredicate("cc_p",1);
+  unsigned consts[5];
+  for(unsigned i=0;i<5;i++) {
+    consts[i] = env.signature->addFunction("cc_c"+Int::toString(i),0);
+  }
+  unsigned srt = env.signature->getFunction(f)->fnType()->result();
+
+  Random::setSeed(1);
+  SimpleCongruenceClosure cc(0);
+  LiteralStack asserted;
+  for(unsigned step=0;step<2000;step++) {
+    if(asserted.isNonEmpty() && Random::getInteger(3)==0) {
+      unsigned cnt = Random::getInteger(asserted.size())+1;
+      cc.pop(cnt);
+      asserted.truncate(asserted.size()-cnt);
+    }
+    else {
+      Literal* lit;
+      TermList t = randomTerm(f, consts, 5);
+      if(Random::getInteger(4)==0) {
+        lit = Literal::create1(p, Random::getBit(), t);
+      }
+      else {
+        //mostly positive equalities, so that there is something to propagate
+        bool pol = Random::getInteger(5)!=0;
+        lit = Literal::createEquality(pol, t, randomTerm(f, consts, 5), srt);
+      }
+      cc.push();
+      cc.addLiteral(lit);
+      asserted.push(lit);
+    }
+    ASS_EQ(cc.level(), asserted.size());
+
+    DecisionProcedure::Status status = cc.getStatus(false);
+    ASS_EQ(status, freshStatus(asserted));
+    if(status==DecisionProcedure::UNSATISFIABLE) {
+      LiteralStack core;
+      cc.getUnsatCore(core, 0);
+      ASS_EQ(freshStatus(core), DecisionProcedure::UNSATISFIABLE);
+    }
+  }
+  cc.reset();
+  ASS_EQ(cc.getStatus(false), DecisionProcedure::SATISFIABLE);
+}
@@ -0,0 +1,98 @@
+/*
+ * File tInductionCache.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+#include "Lib/DArray.hpp"
+#include "Lib/Environment.hpp"
+#include "Lib/Int.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Signature.hpp"
+#include "Kernel/Sorts.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Inferences/Induction.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID inductionCache
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+using namespace Inferences;
+
+/** Return the constant named @c name */
+static Term* constant(vstring name)
+{
+  bool added;
+  unsigned fn = env.signature->addFunction(name, 0, added);
+  if(added) {
+    env.signature->getFunction(fn)->setType(OperatorType::getConstantsType(Sorts::SRT_DEFAULT));
+  }
+  return Term::createConstant(fn);
+}
+
+/** Return the literal q(@c t1,@c t2) */
+static Literal* q(Term* t1, Term* t2)
+{
+  bool added;
+  unsigned pred = env.signature->addPredicate("q", 2, added);
+  if(added) {
+    env.signature->getPredicate(pred)->setType(OperatorType::getPredicateTypeUniformRange(2, Sorts::SRT_DEFAULT));
+  }
+  TermList args[] = {TermList(t1), TermList(t2)};
+  return Literal::create(pred, 2, true, false, args);
+}
+
+TEST_FUN(inductionCacheSkipsDoneGoals)
+{
+  Induction induction;
+  Term* a = constant("a");
+  Term* b = constant("b");
+  Term* c = constant("c");
+
+  ASS(induction.notDone(q(a,b), b));
+  ASS(!induction.notDone(q(a,b), b));
+  //the same goal with a different induction term
+  ASS(!induction.notDone(q(a,c), c));
+  //a different goal
+  ASS(induction.notDone(q(a,b), a));
+  ASS(!induction.notDone(q(c,b), c));
+}
+
+TEST_FUN(inductionCacheKeepsGoalsOfEvictedCandidates)
+{
+  Induction induction;
+  Term* d = constant("d");
+
+  //more candidates than the cache of seen candidates holds
+  unsigned cnt = 20000;
+  DArray<Literal*> lits(cnt);
+  for(unsigned i=0;i<cnt;i++) {
+    lits[i] = q(constant("k"+Int::toString(i)), d);
+    ASS(induction.notDone(lits[i], d));
+  }
+  //the first candidates were evicted, the last ones are remembered,
+  //all of them were done
+  for(unsigned i=0;i<cnt;i++) {
+    ASS(!induction.notDone(lits[i], d));
+  }
+  for(unsigned i=cnt;i>0;i--) {
+    ASS(!induction.notDone(lits[i-1], d));
+  }
+}
@@ -0,0 +1,125 @@
+/*
+ * File tLRSCostModel.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+
+#include "Lib/Environment.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Inference.hpp"
+#include "Kernel/Signature.hpp"
+#include "Kernel/Sorts.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Saturation/LRSCostModel.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID lrsCostModel
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+using namespace Saturation;
+
+/** Return a unit clause p(X0,...,Xn) of weight @c weight */
+static Clause* clauseOfWeight(unsigned weight)
+{
+  unsigned arity = weight-1;
+  bool added;
+  unsigned pred = env.signature->addPredicate("p", arity, added);
+  if(added) {
+    env.signature->getPredicate(pred)->setType(OperatorType::getPredicateTypeUniformRange(arity, Sorts::SRT_DEFAULT));
+  }
+  Stack<TermList> args;
+  for(unsigned i=0;i<arity;i++) {
+    args.push(TermList(i, false));
+  }
+  Stack<Literal*> lits;
+  lits.push(Literal::create(pred, arity, true, false, args.begin()));
+  Clause* cl = Clause::fromStack(lits, Unit::AXIOM, new Inference(Inference::INPUT));
+  ASS_EQ(cl->weight(), weight);
+  return cl;
+}
+
+/** Add @c cnt clauses of weight @c weight to the passive clauses of @c model */
+static void addPassive(LRSCostModel& model, unsigned cnt, unsigned weight)
+{
+  for(unsigned i=0;i<cnt;i++) {
+    model.onPassiveAdded(clauseOfWeight(weight));
+  }
+}
+
+/** Select @c cnt clauses of weight @c weight, which are first added to the passive ones */
+static void select(LRSCostModel& model, unsigned cnt, unsigned weight)
+{
+  for(unsigned i=0;i<cnt;i++) {
+    Clause* cl = clauseOfWeight(weight);
+    model.onPassiveAdded(cl);
+    model.onPassiveSelected(cl);
+  }
+}
+
+TEST_FUN(lrsCostModelCarriesTimeOfEmptyWindows)
+{
+  LRSCostModel model;
+  addPassive(model, 100, 5);
+  ASS_EQ(model.estimatedReachableCount(100, 0, 1), -1);
+
+  select(model, 10, 5);
+  model.endWindow(50);
+  //one window is not enough
+  ASS_EQ(model.estimatedReachableCount(100, 0, 1), -1);
+
+  //the time of a window without selections goes to the next one
+  model.endWindow(30);
+  select(model, 10, 5);
+  model.endWindow(20);
+
+  //all clauses have the same weight, so the cost is the average of
+  //5 milliseconds per clause
+  ASS_EQ(model.estimatedReachableCount(100, 0, 1), 20);
+  ASS_EQ(model.estimatedReachableCount(100, 1, 0), 20);
+}
+
+TEST_FUN(lrsCostModelWalksPassiveWeights)
+{
+  LRSCostModel model;
+
+  //a clause of weight w takes 1+w milliseconds
+  select(model, 10, 1);
+  model.endWindow(20);
+  select(model, 10, 9);
+  model.endWindow(100);
+
+  //passive clauses cost 2 and 5 milliseconds
+  addPassive(model, 10, 1);
+  addPassive(model, 10, 4);
+
+  //by weight, the 10 light clauses take 20 milliseconds and 5 heavy
+  //ones the remaining 25
+  ASS_EQ(model.estimatedReachableCount(45, 0, 1), 15);
+  //by age, clauses of the average passive weight 2.5 are selected
+  ASS_EQ(model.estimatedReachableCount(45, 1, 0), 12);
+  //half of the selections by age, each adding 3.5 milliseconds to a
+  //selection by weight
+  ASS_EQ(model.estimatedReachableCount(45, 1, 1), 16);
+  //when the passive clauses run out, the rest of the time is spent
+  //on clauses of the average weight
+  ASS_EQ(model.estimatedReachableCount(1000, 0, 1), 285);
+}
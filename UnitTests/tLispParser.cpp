@@ -0,0 +1,77 @@
+/*
+ * File tLispParser.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+
+#include <sstream>
+
+#include "Shell/LispLexer.hpp"
+#include "Shell/LispParser.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID lispParser
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Shell;
+
+TEST_FUN(lispParserReadsOneCommandAtATime)
+{
+  istringstream in("(set-logic UF) ; comment\n"
+                   "(assert (and (p a) |q r|))\n"
+                   "atom ()");
+  LispLexer lex(in);
+  LispParser parser(lex);
+
+  LExpr* e = parser.parseNext();
+  ASS(e->isList());
+  ASS_EQ(e->toString(), "(set-logic UF)");
+  LispParser::destroy(e);
+
+  e = parser.parseNext();
+  ASS_EQ(e->toString(), "(assert (and (p a) |q r|))");
+  LispParser::destroy(e);
+
+  e = parser.parseNext();
+  ASS(e->isAtom());
+  ASS_EQ(e->str, "atom");
+  LispParser::destroy(e);
+
+  e = parser.parseNext();
+  ASS(e->isList());
+  ASS(!e->list);
+  LispParser::destroy(e);
+
+  ASS(!parser.parseNext());
+}
+
+TEST_FUN(lispParserUnbalancedInput)
+{
+  istringstream in("(a (b)");
+  LispLexer lex(in);
+  LispParser parser(lex);
+
+  bool thrown = false;
+  try {
+    parser.parseNext();
+  }
+  catch (LispParser::Exception&) {
+    thrown = true;
+  }
+  ASS(thrown);
+}
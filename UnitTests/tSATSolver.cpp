@@ -20,6 +20,7 @@
 #include "Lib/List.hpp"
 #include "Lib/Stack.hpp"
 #include "Lib/Environment.hpp"
+#include "Lib/Random.hpp"
 
 #include "SAT/SATClause.hpp"
 #include "SAT/SATLiteral.hpp"
@@ -27,6 +28,8 @@
 #include "SAT/SATSolver.hpp"
 #include "SAT/TWLSolver.hpp"
 #include "SAT/MinisatInterfacing.hpp"
+#include "SAT/CDCLSolver.hpp"
+#include "SAT/PropagationOracle.hpp"
 #include "SAT/Z3Interfacing.hpp"
 
 #include "Test/UnitTesting.hpp"
@@ -244,6 +247,10 @@ TEST_FUN(testSATSolverInterface)
   TWLSolver sTWL(*env.options,true);
   testInterface(sTWL);  
 
+  cout << endl << "CDCL" << endl;
+  CDCLSolver sCDCL(*env.options,true);
+  testInterface(sCDCL);
+
   /* Not fully conforming - does not support zeroImplied and resource-limited solving
   cout << endl << "Z3" << endl;
   {
@@ -308,6 +315,10 @@ TEST_FUN(testSolvingUnderAssumptions)
   TWLSolver sTWL(*env.options,true);
   testAssumptions(sTWL);
 
+  cout << endl << "CDCL" << endl;
+  CDCLSolver sCDCL(*env.options,true);
+  testAssumptions(sCDCL);
+
   /*cout << endl << "Z3" << endl;
   {
     SAT2FO sat2fo;
@@ -315,3 +326,163 @@ TEST_FUN(testSolvingUnderAssumptions)
     testAssumptions(sZ3);
   }*/
 }
+
+TEST_FUN(testCDCLPropagationOnly)
+{
+  CDCLSolver s(*env.options,true);
+  SATSolverWithAssumptions& sa = s;
+  ensurePrepared(s);
+
+  s.addClause(getClause("ab"));
+  s.addClause(getClause("Bc"));
+
+  SATLiteralStack assumps;
+  assumps.push(getLit('A'));
+  assumps.push(getLit('C'));
+
+  // the assumptions must be propagated even though no conflict is allowed
+  ASS_EQ(sa.solveUnderAssumptions(assumps,true),SATSolver::UNSATISFIABLE);
+  ASS_EQ(s.failedAssumptions().size(),2);
+
+  assumps.pop();
+  ASS_EQ(sa.solveUnderAssumptions(assumps,true),SATSolver::UNKNOWN);
+  ASS_EQ(sa.solveUnderAssumptions(assumps),SATSolver::SATISFIABLE);
+}
+
+SATClause* getRandomClause(unsigned varCnt, unsigned len)
+{
+  CALL("getRandomClause");
+
+  SATLiteralStack lits;
+  while(lits.size()<len) {
+    SATLiteral l(Random::getInteger(varCnt)+1, Random::getBit());
+    if(!lits.find(l) && !lits.find(l.opposite())) {
+      lits.push(l);
+    }
+  }
+  return SATClause::fromStack(lits);
+}
+
+/**
+ * Check that @c prems together with @c assumps are unsatisfiable
+ */
+bool isUnsat(unsigned varCnt, SATClauseList* prems, const SATLiteralStack& assumps)
+{
+  CALL("isUnsat");
+
+  MinisatInterfacing solver(*env.options);
+  SATSolverWithAssumptions& s = solver;
+  s.ensureVarCount(varCnt);
+  SATClauseList::Iterator it(prems);
+  while(it.hasNext()) {
+    s.addClause(it.next());
+  }
+  return s.solveUnderAssumptions(assumps)==SATSolver::UNSATISFIABLE;
+}
+
+/**
+ * Compare CDCLSolver with Minisat on random 3-SAT problems around the
+ * phase transition and check the refutation premises and failed assumptions
+ */
+TEST_FUN(testCDCLSolverRandom)
+{
+  const unsigned varCnt = 40;
+  for(unsigned round=0;round<100;round++) {
+    MinisatInterfacing miniSolver(*env.options,true);
+    CDCLSolver cdclSolver(*env.options,true);
+    SATSolverWithAssumptions& mini = miniSolver;
+    SATSolverWithAssumptions& cdcl = cdclSolver;
+    mini.ensureVarCount(varCnt);
+    cdcl.ensureVarCount(varCnt);
+
+    SATClauseStack clauses;
+    unsigned clauseCnt = 150+Random::getInteger(50);
+    for(unsigned i=0;i<clauseCnt;i++) {
+      SATClause* cl = getRandomClause(varCnt, i%10 ? 3 : 2);
+      clauses.push(cl);
+      mini.addClause(cl);
+      cdcl.addClause(cl);
+    }
+
+    SATLiteralStack assumps;
+    for(unsigned i=0;i<4;i++) {
+      assumps.push(SATLiteral(i+1, Random::getBit()));
+    }
+    SATSolver::Status res = cdcl.solveUnderAssumptions(assumps);
+    ASS_EQ(res,mini.solveUnderAssumptions(assumps));
+    if(res==SATSolver::UNSATISFIABLE) {
+      SATLiteralStack failed(cdcl.failedAssumptions());
+      ASS(isUnsat(varCnt, cdcl.getRefutationPremiseList(), failed));
+    }
+
+    res = cdcl.solve();
+    ASS_EQ(res,mini.solve());
+    if(res==SATSolver::UNSATISFIABLE) {
+      ASS(isUnsat(varCnt, cdcl.getRefutationPremiseList(), SATLiteralStack()));
+      continue;
+    }
+    for(unsigned i=0;i<clauses.size();i++) {
+      SATClause* cl = clauses[i];
+      bool satisfied = false;
+      for(unsigned j=0;j<cl->length();j++) {
+        satisfied |= cdcl.trueInAssignment((*cl)[j]);
+      }
+      ASS(satisfied);
+    }
+  }
+}
+
+/**
+ * Check that the failed assumptions and the premises of PropagationOracle
+ * are only those the conflict was derived from, and that its refutations
+ * agree with Minisat on random problems
+ */
+TEST_FUN(testPropagationOracle)
+{
+  PropagationOracle s;
+  SATSolverWithAssumptions& sa = s;
+  ensurePrepared(s);
+
+  s.addClause(getClause("ab"));
+  s.addClause(getClause("Bc"));
+  s.addClause(getClause("de"));
+
+  SATLiteralStack assumps;
+  assumps.push(getLit('A'));
+  assumps.push(getLit('D'));
+  assumps.push(getLit('C'));
+  ASS_EQ(sa.solveUnderAssumptions(assumps),SATSolver::UNSATISFIABLE);
+  ASS_EQ(s.failedAssumptions().size(),2);
+  ASS(!s.failedAssumptions().find(getLit('D')));
+  ASS_EQ(SATClauseList::length(s.getRefutationPremiseList()),2);
+
+  assumps.pop();
+  ASS_EQ(sa.solveUnderAssumptions(assumps),SATSolver::UNKNOWN);
+
+  const unsigned varCnt = 40;
+  for(unsigned round=0;round<100;round++) {
+    MinisatInterfacing miniSolver(*env.options,true);
+    PropagationOracle oracle;
+    SATSolverWithAssumptions& mini = miniSolver;
+    SATSolverWithAssumptions& prop = oracle;
+    mini.ensureVarCount(varCnt);
+    prop.ensureVarCount(varCnt);
+
+    unsigned clauseCnt = 100+Random::getInteger(50);
+    for(unsigned i=0;i<clauseCnt;i++) {
+      SATClause* cl = getRandomClause(varCnt, i%3 ? 3 : 2);
+      mini.addClause(cl);
+      prop.addClause(cl);
+    }
+
+    SATLiteralStack assumps;
+    for(unsigned i=0;i<6;i++) {
+      assumps.push(SATLiteral(i+1, Random::getBit()));
+    }
+    if(prop.solveUnderAssumptions(assumps)==SATSolver::UNSATISFIABLE) {
+      ASS_EQ(mini.solveUnderAssumptions(assumps),SATSolver::UNSATISFIABLE);
+      SATLiteralStack failed(prop.explicitlyMinimizedFailedAssumptions());
+      ASS(isUnsat(varCnt, prop.getRefutationPremiseList(), failed));
+    }
+  }
+}
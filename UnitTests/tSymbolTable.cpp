@@ -0,0 +1,83 @@
+/*
+ * File tSymbolTable.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+
+#include "Lib/DArray.hpp"
+#include "Lib/Int.hpp"
+#include "Lib/SymbolTable.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID symbolTable
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+
+/** Insert the name @c name, which the table refers to and which must outlive it */
+static void insert(SymbolTable& table, const vstring& name, unsigned arity, unsigned num)
+{
+  table.insert(name.data(), name.size(), arity, num);
+}
+
+TEST_FUN(symbolTableNamesAndArities)
+{
+  vstring f("f");
+  vstring empty;
+  vstring longName("a_very_long_name_over_more_words");
+
+  SymbolTable table;
+  ASS(!table.find("f", 1));
+
+  insert(table, f, 1, 0);
+  insert(table, f, 2, 1);
+  insert(table, empty, 0, 2);
+  insert(table, longName, 3, 3);
+
+  ASS_EQ(table.get("f", 1), 0u);
+  ASS_EQ(table.get("f", 2), 1u);
+  ASS_EQ(table.get("", 0), 2u);
+  ASS_EQ(table.get("a_very_long_name_over_more_words", 3), 3u);
+  ASS(!table.find("f", 0));
+  ASS(!table.find("a_very_long_name_over_more_word", 3));
+  ASS(!table.find("a_very_long_name_over_more_words_", 3));
+
+  // an entry may refer to a part of a longer string, such as a quoted name
+  vstring quoted("'g h'");
+  table.insert(quoted.data()+1, quoted.size()-2, 1, 5);
+  unsigned num;
+  ASS(table.find("g h", 1, num));
+  ASS_EQ(num, 5u);
+}
+
+TEST_FUN(symbolTableGrowth)
+{
+  const unsigned count = 10000;
+  DArray<vstring> names(count);
+  SymbolTable table;
+  for (unsigned i = 0; i < count; i++) {
+    names[i] = "sK" + Int::toString(i);
+    insert(table, names[i], i % 3, i);
+  }
+  ASS_EQ(table.size(), count);
+  for (unsigned i = 0; i < count; i++) {
+    unsigned num;
+    ASS(table.find("sK" + Int::toString(i), i % 3, num));
+    ASS_EQ(num, i);
+    ASS(!table.find("sK" + Int::toString(i), i % 3 + 1));
+  }
+}
@@ -41,21 +41,29 @@ int SATReplayer::perform(int argc, char** argv)
 {
   CALL("SATReplayer::perform");
 
-  if(argc!=4) {
+  if(argc!=3) {
     cerr << "invalid command line"<<endl<<
 	    "Usage:"<<endl<<
-	    argv[0]<<" "<<argv[1]<<" <prefix> <file name>"<<endl;
+	    argv[0]<<" "<<argv[1]<<" <file name>"<<endl;
     exit(1);
   }
 
-  vstring prefix = vstring(argv[2])+" ";
-  ifstream inp(argv[3]);
+  ifstream inp(argv[2], ios::in | ios::binary);
 
   TWLSolver solver(*env.options, true);
-  Test::SolverReplayer replayer(solver);
-  replayer.runFromStream(inp, prefix);
+  Test::SolverReplayer replayer(solver, &solver);
+  if(!replayer.runFromStream(inp)) {
+    cerr << replayer.error() << endl;
+    return 1;
+  }
+
+  const Test::SolverReplayer::Stats& stats = replayer.stats();
+  cout << "calls: " << stats.calls << endl
+       << "solves: " << stats.solves << endl
+       << "mismatches: " << stats.mismatches << endl
+       << "time: " << stats.time << " ms" << endl;
 
-  return 0;
+  return stats.mismatches ? 1 : 0;
 }
 
 }
@@ -0,0 +1,52 @@
+#!/bin/bash
+
+#
+#Script checks that a saturation resumed from a checkpoint still finds
+#the refutation, both when the logging run was stopped early and when it
+#found the refutation itself, and that a checkpoint is not resumed for a
+#different problem
+#
+
+SELF_DIR=`dirname $0`
+VEXEC="$SELF_DIR/../../vampire_dbg"
+
+PRB=`mktemp -t ckp_prb_XXXXX`
+OTHER_PRB=`mktemp -t ckp_other_XXXXX`
+CKP=`mktemp -t ckp_XXXXX`
+OUTF=`mktemp -t ckp_out_XXXXX`
+
+cat >$PRB <<EOF
+cnf(a1,axiom,mult(e,X)=X).
+cnf(a2,axiom,mult(inv(X),X)=e).
+cnf(a3,axiom,mult(mult(X,Y),Z)=mult(X,mult(Y,Z))).
+cnf(a4,axiom,mult(X,X)=e).
+cnf(c,negated_conjecture,mult(a,b)!=mult(b,a)).
+EOF
+
+echo "cnf(a,axiom,p(a))." >$OTHER_PRB
+
+FAILED=""
+
+for SA in lrs discount otter; do
+        for LIMIT in 10 0; do
+                $VEXEC -sa $SA -av off -al $LIMIT --checkpoint $CKP $PRB >$OUTF 2>&1
+                $VEXEC -sa $SA -av off -t 10 --checkpoint_resume $CKP $PRB >$OUTF 2>&1
+                if ! grep -q "Refutation found. Thanks to Tanya!" $OUTF; then
+                        cat $OUTF
+                        FAILED="$FAILED $SA/al$LIMIT"
+                fi
+        done
+done
+
+$VEXEC --checkpoint_resume $CKP $OTHER_PRB >$OUTF 2>&1
+if ! grep -q "Cannot resume from checkpoint" $OUTF; then
+        cat $OUTF
+        FAILED="$FAILED other_problem"
+fi
+
+rm $PRB $OTHER_PRB $CKP $OUTF
+
+if [ "$FAILED" != "" ]; then
+        echo "Resuming from a checkpoint failed for:$FAILED"
+        exit 1
+fi
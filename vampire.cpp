@@ -72,6 +72,7 @@
 #include "Shell/CommandLine.hpp"
 #include "Shell/EqualityProxy.hpp"
 #include "Shell/Grounding.hpp"
+#include "Shell/MetricsReporter.hpp"
 #include "Shell/Normalisation.hpp"
 #include "Shell/Options.hpp"
 #include "Shell/Property.hpp"
@@ -91,6 +92,7 @@
 #include "SAT/MinisatInterfacing.hpp"
 #include "SAT/MinisatInterfacingNewSimp.hpp"
 #include "SAT/TWLSolver.hpp"
+#include "SAT/CDCLSolver.hpp"
 #include "SAT/Preprocess.hpp"
 
 #include "FMB/ModelCheck.hpp"
@@ -553,6 +555,9 @@ void satSolverMode()
     case Options::SatSolver::MINISAT:
       solver = new MinisatInterfacingNewSimp(*env.options);
       break;      
+    case Options::SatSolver::CDCL:
+      solver = new CDCLSolver(*env.options);
+      break;
     default:
       ASSERTION_VIOLATION(env.options->satSolver());
   }
@@ -850,6 +855,7 @@ int main(int argc, char* argv[])
 
     Allocator::setMemoryLimit(env.options->memoryLimit() * 1048576ul);
     Lib::Random::setSeed(env.options->randomSeed());
+    MetricsReporter::init();
 
     switch (env.options->mode())
     {
@@ -21,9 +21,12 @@
  */
 
 #include <iostream>
+#include <fstream>
 
 #include "Debug/Tracer.hpp"
 
+#include "Api/BatchClausifier.hpp"
+
 #include "Lib/Exception.hpp"
 #include "Lib/Environment.hpp"
 #include "Lib/Int.hpp"
@@ -56,7 +59,7 @@
 #include "Shell/Property.hpp"
 #include "Shell/Preprocess.hpp"
 #include "Shell/Statistics.hpp"
-#include "Shell/TPTP.hpp"
+#include "Shell/TPTPPrinter.hpp"
 #include "Shell/UIHelper.hpp"
 
 #include "Saturation/SaturationAlgorithm.hpp"
@@ -123,7 +126,7 @@ void clausifyMode()
     if(!cl) {
       continue;
     }
-    env.out() << TPTP::toString(cl) << "\n";
+    env.out() << TPTPPrinter::toString(cl) << "\n";
   }
   env.endOutput();
 
@@ -132,6 +135,40 @@ void clausifyMode()
 } // clausifyMode
 
 
+/**
+ * Clausify all problems listed in the file given by the clausify_batch
+ * option, using as many worker processes as specified by the cores option.
+ */
+void batchClausifyMode()
+{
+  CALL("batchClausifyMode()");
+
+  Api::BatchClausifier batch(env.options->multicore());
+  {
+    BYPASSING_ALLOCATOR;
+
+    vstring listFile = env.options->clausifyBatch();
+    if(listFile=="-") {
+      batch.addProblems(cin);
+    }
+    else {
+      ifstream list(listFile.c_str());
+      if(list.fail()) {
+        USER_ERROR("Cannot open problem list file: "+listFile);
+      }
+      batch.addProblems(list);
+    }
+  }
+
+  //the workers are forked while the batch is running, so we cannot
+  //hold the environment output for its whole duration
+  unsigned failed = batch.run(cout);
+
+  if(!failed) {
+    vampireReturnValue = VAMP_RESULT_STATUS_SUCCESS;
+  }
+} // batchClausifyMode
+
 void explainException (Exception& exception)
 {
   env.beginOutput();
@@ -155,23 +192,25 @@ int main(int argc, char* argv [])
   Lib::Random::setSeed(123456);
 
   try {
-    env.options->setMode(Options::MODE_CLAUSIFY);
+    env.options->setMode(Options::Mode::CLAUSIFY);
 
     // read the command line and interpret it
     Shell::CommandLine cl(argc,argv);
     cl.interpret(*env.options);
 
-    PROCESS_TRACE_SPEC_STRING(env.options->traceSpecString());
-    env.options->enableTracesAccordingToOptions();
-
-    if(env.options->mode()!=Options::MODE_CLAUSIFY) {
+    if(env.options->mode()!=Options::Mode::CLAUSIFY) {
       USER_ERROR("Only the \"clausify\" mode is supported");
     }
 
     Allocator::setMemoryLimit(env.options->memoryLimit()*1048576ul);
     Lib::Random::setSeed(env.options->randomSeed());
 
-    clausifyMode();
+    if(env.options->clausifyBatch()!="") {
+      batchClausifyMode();
+    }
+    else {
+      clausifyMode();
+    }
 
   }
 #if VDEBUG
@@ -18,6 +18,8 @@
  */
 #include <stddef.h>
 #include <stdio.h>
+#include <string.h>
+#include <fstream>
 
 #include "Forwards.hpp"
 
@@ -30,6 +32,7 @@
 #include "Lib/Timer.hpp"
 #include "Lib/Exception.hpp"
 #include "Lib/Environment.hpp"
+#include "Lib/StringUtils.hpp"
 
 #include "Lib/VirtualIterator.hpp"
 #include "Lib/Metaiterators.hpp"
@@ -48,10 +51,13 @@
 #include "Shell/Preprocess.hpp"
 #include "Shell/Statistics.hpp"
 
+#include "Test/RecordingTermIndex.hpp"
+
 using namespace Lib;
 using namespace Kernel;
 using namespace Shell;
 using namespace Indexing;
+using namespace Test;
 
 #define INPUTSIZE      524288    // 500Kb read from disk each time
 #define MAXTERMSIZE    2000      // maximum number of chars of each term
@@ -113,16 +119,126 @@ void readSymbolTable(FILE* in)
 }
 
 
+/* ======= Replaying recorded term index traces: ================ */
+
+void printOpStats(const char* trace, const char* index, const char* op, TermIndexReplayer::OpStats& st)
+{
+  double timeMs = st.time()/1e6;
+  printf("%s\t%s\t%s\t%u\t%lu\t%.3f\t%.0f\t%.3f\t%.3f\t%.3f\t%.3f",
+      trace, index, op, st.count, st.results, timeMs, timeMs ? st.count*1000/timeMs : 0.0,
+      st.percentile(50)/1e3, st.percentile(90)/1e3, st.percentile(99)/1e3, st.percentile(100)/1e3);
+}
+
+/**
+ * Replay the traces recorded by the index_trace option against each of the
+ * indexing structures and print the measurements as tab separated values,
+ * a line for each kind of operation and a summary line. Return 1 if a trace
+ * cannot be read or two structures differ in the results of a query.
+ */
+int replayMode(int argc, char* argv[])
+{
+  CALL("replayMode");
+
+  Stack<vstring> indices;
+  Stack<vstring> traces;
+  for(int i=2;i<argc;i++) {
+    if(!strcmp(argv[i],"-index") && i+1<argc) {
+      StringUtils::splitStr(argv[++i], ',', indices);
+    }
+    else {
+      traces.push(argv[i]);
+    }
+  }
+  if(traces.isEmpty()) {
+    printf("Usage: vcompit -replay [-index <index>,...] <trace file>...\n");
+    return 1;
+  }
+  if(indices.isEmpty()) {
+    indices.push("substitution_tree");
+    indices.push("code_tree");
+  }
+
+  int res = 0;
+  printf("trace\tindex\top\tcount\tresults\ttime_ms\tops_per_s\tp50_us\tp90_us\tp99_us\tmax_us"
+      "\tmemory_kb\tpeak_memory_kb\tskipped\tmismatches\n");
+  for(unsigned ti=0;ti<traces.size();ti++) {
+    const char* traceName = traces[ti].c_str();
+    TermIndexTrace trace;
+    ifstream in(traceName, ios::in | ios::binary);
+    if(!in || !trace.load(in)) {
+      fprintf(stderr, "%s: %s\n", traceName, in ? trace.error().c_str() : "cannot open");
+      res = 1;
+      continue;
+    }
+    if(trace.truncated()) {
+      fprintf(stderr, "%s: truncated, replaying the complete records\n", traceName);
+    }
+
+    // results of the first structure that answered each query
+    Stack<unsigned> expected;
+    for(unsigned ii=0;ii<indices.size();ii++) {
+      const char* indexName = indices[ii].c_str();
+      ScopedPtr<TermIndexingStructure> index(TermIndexReplayer::createIndex(indices[ii]));
+      if(!index) {
+        fprintf(stderr, "unknown index %s (expected substitution_tree, substitution_tree_uwa or code_tree)\n", indexName);
+        return 1;
+      }
+      TermIndexReplayer replayer(*index, indices[ii]);
+      replayer.run(trace);
+
+      const Stack<unsigned>& results = replayer.results();
+      unsigned mismatches = 0;
+      for(unsigned i=0;i<results.size();i++) {
+        if(i==expected.size()) {
+          expected.push(results[i]);
+        }
+        else if(expected[i]==UINT_MAX) {
+          expected[i] = results[i];
+        }
+        else if(results[i]!=UINT_MAX && results[i]!=expected[i]) {
+          mismatches++;
+        }
+      }
+      if(mismatches) {
+        res = 1;
+      }
+
+      TermIndexReplayer::OpStats all;
+      for(unsigned op=TIO_INSERT;op<=TIO_LAST;op++) {
+        TermIndexReplayer::OpStats& st = replayer.stats(static_cast<TermIndexTraceOp>(op));
+        if(!st.count) {
+          continue;
+        }
+        printOpStats(traceName, indexName, TermIndexReplayer::opName(static_cast<TermIndexTraceOp>(op)), st);
+        printf("\t-\t-\t-\t-\n");
+        all.count += st.count;
+        all.results += st.results;
+        all.latencies.loadFromIterator(Stack<unsigned>::Iterator(st.latencies));
+      }
+      printOpStats(traceName, indexName, "all", all);
+      printf("\t%lu\t%lu\t%u\t%u\n", (unsigned long)replayer.memory()/1024,
+          (unsigned long)replayer.peakMemory()/1024, replayer.skipped(), mismatches);
+    }
+  }
+  return res;
+}
+
+
 int main( int argc, char *argv[] )
 {
   CALL("main");
 
   Timer::ensureTimerInitialized();
 
+  if (argc >= 2 && !strcmp(argv[1], "-replay")) {
+    return replayMode(argc, argv);
+  }
+
   FILE *in;
 
   if (argc != 2) {
-    printf("Usage: vcompit <benchmark file>\n");
+    printf("Usage: vcompit <benchmark file>\n"
+           "       vcompit -replay [-index <index>,...] <trace file>...\n");
     return(0);
   }
   if (!(in = fopen(argv[1], "r"))) {
@@ -137,7 +253,7 @@ int main( int argc, char *argv[] )
 
   readSymbolTable(in);
 
-  Timer compitTimer;
+  int indexingTime = 0;
 
   /* First of all, the queries from the benchmark are prepared as input for the application. */
   /* ====== MAIN LOOP ======== */
@@ -185,16 +301,16 @@ int main( int argc, char *argv[] )
       printf("%d operations loaded.\n",numops);
 #endif
 
-      compitTimer.start();
+      int startTime = env.timer->elapsedMilliseconds();
       for (j=0;j<numops;j++) {
 	/* The translated queries (terms and operations) are send to application. */
         ApplicationOp(oper[j], (terms[j]) );
       }
 
-      compitTimer.stop();
+      indexingTime += env.timer->elapsedMilliseconds()-startTime;
     }
   printf("Indexing time without compiling:\t%d ms\nIndexing time:\t%d ms\n",
-	  compitTimer.elapsedMilliseconds(), env.timer->elapsedMilliseconds());
+	  indexingTime, env.timer->elapsedMilliseconds());
 
   printf("ops:%d, +:%d, -:%d.\n",operations,insertions,deletions);
   return 0;
@@ -17,6 +17,7 @@
  * licence, which we will make an effort to provide. 
  */
 #include <iostream>
+#include <fstream>
 
 #include "Forwards.hpp"
 
@@ -26,15 +27,19 @@
 #include "Lib/Environment.hpp"
 #include "Lib/Random.hpp"
 #include "Lib/Stack.hpp"
+#include "Lib/StringUtils.hpp"
 #include "Lib/System.hpp"
 #include "Lib/Timer.hpp"
 #include "Lib/VirtualIterator.hpp"
 #include "Lib/Int.hpp"
 
+#include "SAT/BufferedSolver.hpp"
+#include "SAT/CDCLSolver.hpp"
+#include "SAT/PropagationOracle.hpp"
 #include "SAT/DIMACS.hpp"
 #include "SAT/MinimizingSolver.hpp"
+#include "SAT/MinisatInterfacing.hpp"
 #include "SAT/Preprocess.hpp"
-#include "SAT/SingleWatchSAT.hpp"
 #include "SAT/TWLSolver.hpp"
 
 #include "Indexing/TermSharing.hpp"
@@ -43,7 +48,7 @@
 #include "Shell/Options.hpp"
 #include "Shell/Statistics.hpp"
 
-#include "Test/CheckedSatSolver.hpp"
+#include "Test/RecordingSatSolver.hpp"
 
 using namespace Lib;
 using namespace SAT;
@@ -55,66 +60,78 @@ struct SatOptions
 {
   bool simulateIncremental;
   bool minimizingSolver;
-  bool checkingSolver;
-  vstring fileName;
+  /** if true, the files are traces recorded by RecordingSatSolver */
+  bool replay;
+  vstring solver;
+  StringStack fileNames;
 
   SatOptions()
   : simulateIncremental(false),
     minimizingSolver(false),
-    checkingSolver(false)
+    replay(false)
   {}
 };
 
+/**
+ * Create the solver called @c name. If it supports assumptions,
+ * @c assumptionSolver is set to it, otherwise to zero.
+ */
+SATSolver* createSolver(vstring name, SATSolverWithAssumptions*& assumptionSolver)
+{
+  CALL("createSolver");
 
+  assumptionSolver = 0;
+  if(name=="vampire") {
+    assumptionSolver = new TWLSolver(*env.options, true);
+  }
+  else if(name=="minisat") {
+    assumptionSolver = new MinisatInterfacing(*env.options, true);
+  }
+  else if(name=="cdcl") {
+    assumptionSolver = new CDCLSolver(*env.options, true);
+  }
+  else if(name=="propagation") {
+    assumptionSolver = new PropagationOracle();
+  }
+  else if(name=="buffered") {
+    return new BufferedSolver(new MinisatInterfacing(*env.options, true));
+  }
+  else if(name=="minimizing") {
+    return new MinimizingSolver(new MinisatInterfacing(*env.options, true));
+  }
+  else {
+    USER_ERROR("unknown solver "+name+" (expected vampire, minisat, cdcl, propagation, buffered or minimizing)");
+  }
+  return assumptionSolver;
+}
 
 SATClauseList* getInputClauses(const char* fname, unsigned& varCnt)
 {
   CALL("getInputClauses");
 
-  SATClauseIterator cit=Preprocess::removeDuplicateLiterals( DIMACS::parse(fname, varCnt) );
+  SATClauseIterator cit=Preprocess::removeDuplicateLiterals(
+      pvi(SATClauseList::DestructiveIterator(DIMACS::parse(fname, varCnt))) );
 
   SATClauseList* clauses = 0;
   SATClauseList::pushFromIterator(cit, clauses);
   return clauses;
 }
 
-void preprocessClauses(unsigned varCnt, SATClauseList*& clauses)
-{
-  CALL("preprocessClauses");
-
-  Preprocess::filterPureLiterals(varCnt, clauses);
-//  SATClauseIterator cl = pvi( SATClauseList::DestructiveIterator(clauses));
-//  SATClauseIterator units, nonUnits;
-//  Preprocess::propagateUnits(cl, units, nonUnits);
-//  clauses = 0;
-//  SATClauseList::pushFromIterator(nonUnits, clauses);
-}
-
-SATClauseList* getPreprocessedClauses(const char* fname, unsigned& varCnt)
-{
-  CALL("getPreprocessedClauses");
-
-  SATClauseList* clauses = getInputClauses(fname, varCnt);
-  preprocessClauses(varCnt, clauses);
-  return clauses;
-}
-
-
-SATSolver::Status runSolverIncrementally(SATSolver& solver, unsigned varCnt, SATClauseList* clauses)
+SATSolver::Status runSolverIncrementally(SATSolver& solver, SATSolverWithAssumptions* assumptionSolver,
+    unsigned varCnt, SATClauseList* clauses)
 {
   CALL("runSolverIncrementally");
 
-  bool testAssumptions = true;
-
   Stack<SATClause*> cls;
   cls.loadFromIterator(SATClauseList::Iterator(clauses));
 
-  solver.ensureVarCnt(varCnt);
+  solver.ensureVarCount(varCnt);
 
   SATSolver::Status solverStatus = SATSolver::SATISFIABLE;
 
   SATClauseStack units;
   SATClauseStack inner;
+  SATLiteralStack assumps;
 
   while(cls.isNonEmpty()) {
     units.reset();
@@ -130,45 +147,41 @@ SATSolver::Status runSolverIncrementally(SATSolver& solver, unsigned varCnt, SAT
       }
     }
 
-    SATClauseIterator ic1=pvi( Stack<SATClause*>::Iterator(inner) );
-    solver.addClauses(ic1);
+    solver.addClausesIter(pvi( Stack<SATClause*>::Iterator(inner) ));
 
-    solverStatus = solver.getStatus();
+    solverStatus = solver.solve();
     if(solverStatus!=SATSolver::SATISFIABLE) {
       return solverStatus;
     }
 
-    if(testAssumptions) {
-
-      //first we try adding wrong literals, so that we check retracting works as it should...
+    if(assumptionSolver && units.isNonEmpty()) {
+      //first we try assuming wrong literals, so that we check retracting works as it should...
+      assumps.reset();
       SATClauseStack::Iterator uit0(units);
       while(uit0.hasNext()) {
-	SATClause* cl = uit0.next();
-	solver.addAssumption((*cl)[0].opposite());
+	assumps.push((*uit0.next())[0].opposite());
       }
-      //solver.retractAllAssumptions();
+      assumptionSolver->solveUnderAssumptions(assumps);
 
+      assumps.reset();
       SATClauseStack::Iterator uit(units);
       while(uit.hasNext()) {
-	SATClause* cl = uit.next();
-	solver.addAssumption((*cl)[0]);
-
-	solverStatus = solver.getStatus();
-	if(solverStatus!=SATSolver::SATISFIABLE) { return solverStatus; }
+	assumps.push((*uit.next())[0]);
       }
-      //solver.retractAllAssumptions();
+      solverStatus = assumptionSolver->solveUnderAssumptions(assumps);
+      if(solverStatus!=SATSolver::SATISFIABLE) { return solverStatus; }
     }
 
     while(units.isNonEmpty()) {
-      SATClause* cl = units.pop();
-      solver.addClauses(pvi( getSingletonIterator(cl) ));
-
-      ASS_EQ(solver.getStatus(), SATSolver::SATISFIABLE);
+      solver.addClause(units.pop());
+    }
+    solverStatus = solver.solve();
+    if(solverStatus!=SATSolver::SATISFIABLE) {
+      return solverStatus;
     }
   }
 
-  ASS_EQ(solverStatus, SATSolver::SATISFIABLE);
-  return SATSolver::SATISFIABLE;
+  return solverStatus;
 }
 
 
@@ -176,12 +189,9 @@ SATSolver::Status runSolver(SATSolver& solver, unsigned varCnt, SATClauseList* c
 {
   CALL("runSolver");
 
-  /*solver.ensureVarCnt(varCnt);
-  solver.addClauses(pvi( SATClauseList::Iterator(clauses)));
-  return solver.getStatus();
-  */
-  solver.addClauses(pvi(SATClauseList::Iterator(clauses)));
-  return solver.getStatus();
+  solver.ensureVarCount(varCnt);
+  solver.addClausesIter(pvi(SATClauseList::Iterator(clauses)));
+  return solver.solve();
 }
 
 void satSolverMode(SatOptions& opts)
@@ -192,34 +202,27 @@ void satSolverMode(SatOptions& opts)
   unsigned varCnt;
   SATClauseList* clauses;
 
-  if(opts.fileName.empty()) {
+  if(opts.fileNames.isEmpty()) {
 	  clauses = getInputClauses(0,varCnt);
-	  //clauses = getPreprocessedClauses(0, varCnt);
   }
   else {
-	  clauses = getInputClauses(opts.fileName.c_str(), varCnt);
-    //clauses = getPreprocessedClauses(opts.fileName.c_str(), varCnt);
+	  clauses = getInputClauses(opts.fileNames[0].c_str(), varCnt);
   }
 
   env.statistics->phase = Statistics::SAT_SOLVING;
 
   cout<<"start varcnt :"<<varCnt<<"\n";
 
-  SATSolverSCP solver(new TWLSolver(*env.options, true));
-  //for the minimized case
-  //solver = new MinimizingSolver(solver.release());
-
-  /*if(opts.minimizingSolver) {
+  SATSolverWithAssumptions* assumptionSolver;
+  SATSolverSCP solver(createSolver(opts.solver, assumptionSolver));
+  if(opts.minimizingSolver) {
     solver = new MinimizingSolver(solver.release());
+    assumptionSolver = 0;
   }
-  if(opts.checkingSolver) {
-    solver = new CheckedSatSolver(solver.release());
-  }
-  */
 
   SATSolver::Status res;
   if(opts.simulateIncremental) {
-    res = runSolverIncrementally(*solver, varCnt, clauses);
+    res = runSolverIncrementally(*solver, assumptionSolver, varCnt, clauses);
   }
   else {
     res = runSolver(*solver, varCnt, clauses);
@@ -243,8 +246,61 @@ void satSolverMode(SatOptions& opts)
     cout<<res<<endl;
     ASSERTION_VIOLATION;
   }
+}
+
+/**
+ * Replay each of the traces against each of the solvers in the comma
+ * separated list opts.solver and print the measurements as tab
+ * separated values. Return false if some solver could not replay
+ * a trace or disagreed with the recorded results.
+ */
+bool replayMode(SatOptions& opts)
+{
+  CALL("replayMode");
+
+  env.statistics->phase = Statistics::SAT_SOLVING;
+
+  StringStack solvers;
+  StringUtils::splitStr(opts.solver.c_str(), ',', solvers);
+
+  bool ok = true;
+  cout<<"trace\tsolver\tcalls\tclauses\tsolves\tsat\tunsat\tunknown\tmismatches\ttime_ms\tsolve_time_ms\tmemory_kb"<<endl;
+  StringStack::BottomFirstIterator fit(opts.fileNames);
+  while(fit.hasNext()) {
+    vstring fileName = fit.next();
+    StringStack::BottomFirstIterator sit(solvers);
+    while(sit.hasNext()) {
+      vstring solverName = sit.next();
+      ifstream in(fileName.c_str(), ios::in | ios::binary);
+      if(!in) {
+        USER_ERROR("Cannot open trace file "+fileName);
+      }
 
-  //clauses->destroy();
+      // the memory of Minisat is not allocated by the Allocator and is not included
+      size_t startMemory = Allocator::getUsedMemory();
+      SATSolverWithAssumptions* assumptionSolver;
+      SATSolverSCP solver(createSolver(solverName, assumptionSolver));
+      SolverReplayer replayer(*solver, assumptionSolver);
+      bool replayed = replayer.runFromStream(in);
+      size_t memory = Allocator::getUsedMemory()-startMemory;
+      if(!replayed) {
+        cerr<<fileName<<": "<<solverName<<": "<<replayer.error()<<endl;
+        ok = false;
+        continue;
+      }
+
+      const SolverReplayer::Stats& stats = replayer.stats();
+      cout<<fileName<<'\t'<<solverName<<'\t'<<stats.calls<<'\t'<<stats.clauses<<'\t'<<stats.solves<<'\t'
+          <<stats.satisfiable<<'\t'<<stats.unsatisfiable<<'\t'<<stats.unknown<<'\t'<<stats.mismatches<<'\t'
+          <<stats.time<<'\t'<<stats.solveTime<<'\t'<<memory/1024<<endl;
+      if(stats.mismatches) {
+        ok = false;
+      }
+    }
+  }
+
+  env.statistics->phase = Statistics::FINALIZATION;
+  return ok;
 }
 
 bool processArgs(StringStack& args, SatOptions& opts)
@@ -262,18 +318,17 @@ bool processArgs(StringStack& args, SatOptions& opts)
       opts.minimizingSolver = true;
       it.del();
     }
-    else if(arg=="-checked") {
-      opts.checkingSolver = true;
+    else if(arg=="-replay") {
+      opts.replay = true;
       it.del();
     }
-    else if(arg=="-tr") {
+    else if(arg=="-solver") {
       it.del();
       if(!it.hasNext()) {
-	USER_ERROR("value for -tr option expected");
+	USER_ERROR("value for -solver option expected");
       }
-      vstring traceStr(it.next());
+      opts.solver = it.next();
       it.del();
-      PROCESS_TRACE_SPEC_STRING(traceStr);
     }
     else if(arg == "-t"){
     	it.del();
@@ -289,23 +344,32 @@ bool processArgs(StringStack& args, SatOptions& opts)
     	flag=false;
     }
   }
-  if(args.size()>1) {
+  if(opts.replay) {
+    if(args.isEmpty()) {
+      USER_ERROR("trace files expected");
+    }
+    if(opts.solver.empty()) {
+      opts.solver = "vampire,minisat,cdcl";
+    }
+  }
+  else if(opts.solver.empty()) {
+    opts.solver = "vampire";
+  }
+  if(!opts.replay && args.size()>1) {
     while(args.isNonEmpty()) {
       cout<<args.pop()<<endl;
     }
     USER_ERROR("too many arguments");
   }
-  if(args.isNonEmpty()) {
-    opts.fileName = args.pop();
-  }
+  opts.fileNames = args;
   return flag;
 }
 
 int main(int argc, char* argv [])
 {
   CALL("main");
-  //ScopedPtr<SATSolver> solver;
- 
+
+  int resultValue = 0;
   try {
     System::registerArgv0(argv[0]);
     Random::setSeed(1);
@@ -322,7 +386,13 @@ int main(int argc, char* argv [])
 
     Lib::Random::setSeed(env.options->randomSeed());
 
-    satSolverMode(opts);
+    if(opts.replay) {
+      // the replayed solvers keep no statistics of their own
+      return replayMode(opts) ? 0 : 1;
+    }
+    else {
+      satSolverMode(opts);
+    }
   }
   catch(MemoryLimitExceededException&)
   {
@@ -341,10 +411,12 @@ int main(int argc, char* argv [])
     cout<<"USER ERROR: ";
     e.cry(cout);
     cout<<"\n";
+    resultValue = 1;
   }
 
-  env.statistics->print(cout);
+  if(!resultValue || !env.statistics->terminationReason) {
+    env.statistics->print(cout);
+  }
 
-  return 0;
+  return resultValue;
 }
-